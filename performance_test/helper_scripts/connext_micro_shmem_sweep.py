@@ -0,0 +1,135 @@
+# Copyright 2021 Apex.AI, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Script to find the Connext DDS Micro SHMEM receive buffer size where samples get lost."""
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import time
+
+
+def perf_test_cmd(args, buffer_size):
+    """
+    Return the perf_test command line shared by the publisher and the subscriber.
+
+    :param args: The script arguments.
+    :param buffer_size: The SHMEM receive buffer size to use.
+    """
+    return ['ros2', 'run', 'performance_test', 'perf_test',
+            '-c', 'ConnextDDSMicro',
+            '--msg', args.msg,
+            '--rate', str(args.rate),
+            '--max-runtime', str(args.duration),
+            '--connext-micro-shmem-message-count', str(args.message_count),
+            '--connext-micro-shmem-buffer-size', str(buffer_size)] + \
+        shlex.split(args.perf_test_args)
+
+
+def run(args, buffer_size):
+    """
+    Run a subscriber and a publisher process with the given buffer size.
+
+    :param args: The script arguments.
+    :param buffer_size: The SHMEM receive buffer size to use.
+    :return: The number of received and lost samples of the subscriber.
+    """
+    logfile = os.path.join(args.directory, 'sub_{}.json'.format(buffer_size))
+    cmd = perf_test_cmd(args, buffer_size)
+    out = None if args.v else subprocess.DEVNULL
+
+    subscriber = subprocess.Popen(
+        cmd + ['-p', '0', '-s', '1', '-o', 'json', '--json-logfile', logfile],
+        stdout=out, stderr=out)
+    # give the subscriber time to finish initializing
+    time.sleep(1)
+    subprocess.run(cmd + ['-p', '1', '-s', '0', '-o', 'none'], stdout=out, stderr=out)
+    if subscriber.wait() != 0:
+        raise RuntimeError('The subscriber failed with buffer size {}'.format(buffer_size))
+
+    with open(logfile) as f:
+        results = json.load(f)['analysis_results']
+    received = sum(r['num_samples_received'] for r in results)
+    lost = sum(r['num_samples_lost'] for r in results)
+    return received, lost
+
+
+"""Script arguments"""
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+parser.add_argument(
+    '-m',
+    '--msg',
+    default='Array1m',
+    help='message to test')
+parser.add_argument(
+    '-r',
+    '--rate',
+    default=1000,
+    type=int,
+    help='publishing rate')
+parser.add_argument(
+    '-d',
+    '--duration',
+    default=10,
+    type=int,
+    help='runtime of each experiment in seconds')
+parser.add_argument(
+    '--buffer-sizes',
+    nargs='*',
+    default=[2 ** exponent for exponent in range(16, 29)],
+    type=int,
+    help='SHMEM receive buffer sizes to test, in bytes')
+parser.add_argument(
+    '--message-count',
+    default=1024 * 16,
+    type=int,
+    help='SHMEM received message count max to use for all experiments')
+parser.add_argument(
+    '--perf-test-args',
+    default='',
+    help='additional perf_test arguments, e.g. "--reliable --keep-last"')
+parser.add_argument(
+    '--directory',
+    default='./connext_micro_shmem_sweep',
+    help='directory for the JSON results of the subscriber')
+parser.add_argument(
+    '-v',
+    action='store_const',
+    const=True,
+    help='verbose mode')
+
+args = parser.parse_args()
+
+if not os.path.exists(args.directory):
+    os.makedirs(args.directory)
+
+lossless_from = None
+print('{:>12} {:>12} {:>12}'.format('buffer size', 'received', 'lost'))
+for buffer_size in sorted(args.buffer_sizes):
+    received, lost = run(args, buffer_size)
+    print('{:>12} {:>12} {:>12}'.format(buffer_size, received, lost))
+    sys.stdout.flush()
+    if lost == 0 and received > 0:
+        if lossless_from is None:
+            lossless_from = buffer_size
+    else:
+        lossless_from = None
+
+if lossless_from is None:
+    print('Samples were lost with the largest buffer size.')
+else:
+    print('No samples were lost from a buffer size of {} bytes on.'.format(lossless_from))
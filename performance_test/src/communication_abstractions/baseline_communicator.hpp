@@ -0,0 +1,97 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__BASELINE_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__BASELINE_COMMUNICATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "communicator.hpp"
+#include "sample_header.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief Helper base class for the baseline plugins, which transfer samples without a middleware.
+ * \tparam Msg The msg type to use.
+ *
+ * The baseline plugins do not serialize the message. Every sample is a SampleHeader followed by
+ * as many payload bytes as the message occupies: the size of the message for messages with a
+ * fixed size, the capacity of a bounded sequence, and the configured unbounded message size
+ * otherwise.
+ */
+template<class Msg>
+class BaselineCommunicator : public Communicator
+{
+public:
+  /// The data type to use.
+  using DataType = typename Msg::RosType;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit BaselineCommunicator(SpinLock & lock)
+  : Communicator(lock),
+    m_payload_size(sample_payload_size<DataType>(m_ec))
+  {
+  }
+
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * (sizeof(SampleHeader) + payload_size());
+  }
+
+protected:
+  /// The header in front of the payload of every sample.
+  using SampleHeader = performance_test::SampleHeader;
+
+  /// Whether the message type has a fixed size.
+  static constexpr bool s_fixed_size = msg_traits::is_fixed_size<DataType>::value;
+
+  /// Returns the number of payload bytes sent after the SampleHeader.
+  std::size_t payload_size() const
+  {
+    return m_payload_size;
+  }
+
+  /**
+   * \brief Fills the header of the next sample to publish and counts it as sent.
+   * \param header The header to fill.
+   * \param time The time to fill into the header.
+   */
+  void init_header(SampleHeader & header, const std::int64_t time)
+  {
+    Communicator::init_header(header, time, payload_size());
+  }
+
+  /// Verifies the received sample and updates the statistics. The lock must be held.
+  void handle_sample(const SampleHeader & header)
+  {
+    Communicator::handle_sample(header, payload_size());
+  }
+
+  /// Returns whether received samples are published back instead of being recorded.
+  bool is_relay() const
+  {
+    return m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY;
+  }
+
+private:
+  const std::size_t m_payload_size;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__BASELINE_COMMUNICATOR_HPP_
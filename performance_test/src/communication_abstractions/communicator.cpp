@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include <chrono>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 
 #include "communicator.hpp"
 
@@ -31,6 +35,7 @@ Communicator::Communicator(SpinLock & lock)
   m_prev_sample_id(),
   m_num_lost_samples(),
   m_received_sample_counter(),
+  m_received_shm_sample_counter(),
   m_sent_sample_counter(),
   m_lock(lock)
 {
@@ -43,6 +48,10 @@ std::uint64_t Communicator::num_received_samples() const
 {
   return m_received_sample_counter;
 }
+std::uint64_t Communicator::num_received_shm_samples() const
+{
+  return m_received_shm_sample_counter;
+}
 std::uint64_t Communicator::num_sent_samples() const
 {
   return m_sent_sample_counter;
@@ -63,6 +72,10 @@ void Communicator::increment_received(const std::uint64_t & increment)
 {
   m_received_sample_counter += increment;
 }
+void Communicator::increment_received_shm(const std::uint64_t & increment)
+{
+  m_received_shm_sample_counter += increment;
+}
 void Communicator::increment_sent(const std::uint64_t & increment)
 {
   m_sent_sample_counter += increment;
@@ -106,12 +119,33 @@ StatisticsTracker Communicator::latency_statistics() const
 {
   return m_latency;
 }
+void Communicator::add_serialization_to_statistics(const std::chrono::nanoseconds duration)
+{
+  m_serialization.add_sample(std::chrono::duration<double>(duration).count());
+}
+StatisticsTracker Communicator::serialization_statistics() const
+{
+  return m_serialization;
+}
+void Communicator::add_samples_per_wakeup_to_statistics(const std::uint64_t num_samples)
+{
+  if (num_samples > 0) {
+    m_samples_per_wakeup.add_sample(static_cast<double>(num_samples));
+  }
+}
+StatisticsTracker Communicator::samples_per_wakeup_statistics() const
+{
+  return m_samples_per_wakeup;
+}
 void Communicator::reset()
 {
   m_num_lost_samples = 0;
   m_received_sample_counter = 0;
+  m_received_shm_sample_counter = 0;
   m_sent_sample_counter = 0;
   m_latency = StatisticsTracker();
+  m_serialization = StatisticsTracker();
+  m_samples_per_wakeup = StatisticsTracker();
 }
 
 std::uint64_t Communicator::prev_sample_id() const
@@ -119,6 +153,59 @@ std::uint64_t Communicator::prev_sample_id() const
   return m_prev_sample_id;
 }
 
+bool Communicator::may_take_more(const std::uint64_t num_taken) const
+{
+  const auto max_samples = m_ec.max_samples_per_take();
+  return max_samples == 0 || num_taken < max_samples;
+}
+
+void Communicator::init_header(
+  SampleHeader & header, const std::int64_t time,
+  const std::uint64_t payload_size)
+{
+  lock();
+  header.time = time;
+  header.id = next_sample_id();
+  header.size = payload_size;
+  increment_sent();  // We increment before publishing so we don't have to lock twice.
+  unlock();
+}
+
+void Communicator::handle_sample(const SampleHeader & header, const std::uint64_t payload_size)
+{
+  if (header.size != payload_size) {
+    throw std::runtime_error(
+            "Data consistency violated. The payload size of the sample does not match the "
+            "size of the message.");
+  }
+  if (m_prev_timestamp >= header.time) {
+    throw std::runtime_error(
+            "Data consistency violated. Received sample with not strictly older timestamp. "
+            "Time diff: " + std::to_string(header.time - m_prev_timestamp) +
+            " Data Time: " + std::to_string(header.time));
+  }
+  m_prev_timestamp = header.time;
+  update_lost_samples_counter(header.id);
+  add_latency_to_statistics(header.time);
+  increment_received();
+}
+
+void Communicator::store_callback_exception()
+{
+  std::lock_guard<std::mutex> lock(m_callback_exception_mutex);
+  if (!m_callback_exception) {
+    m_callback_exception = std::current_exception();
+  }
+}
+
+void Communicator::rethrow_callback_exception()
+{
+  std::lock_guard<std::mutex> lock(m_callback_exception_mutex);
+  if (m_callback_exception) {
+    std::rethrow_exception(m_callback_exception);
+  }
+}
+
 void Communicator::lock()
 {
   m_lock.lock();
@@ -18,7 +18,12 @@
 #include <stdexcept>
 #include <limits>
 #include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
 
+#include "sample_header.hpp"
+#include "../utilities/msg_traits.hpp"
 #include "../utilities/spin_lock.hpp"
 #include "../utilities/statistics_tracker.hpp"
 #include "../experiment_configuration/experiment_configuration.hpp"
@@ -35,6 +40,8 @@ public:
 
   /// Number of received samples.
   std::uint64_t num_received_samples() const;
+  /// Number of received samples which were delivered through shared memory.
+  std::uint64_t num_received_shm_samples() const;
   /// Number of sent samples.
   std::uint64_t num_sent_samples() const;
   /// Number of lost samples.
@@ -46,6 +53,22 @@ public:
   void add_latency_to_statistics(const std::int64_t sample_timestamp);
   /// Returns stored latency statistics.
   StatisticsTracker latency_statistics() const;
+  /**
+   * \brief Adds the time spent serializing or deserializing a sample to the statistics.
+   * \param duration The time it took to convert the sample.
+   */
+  void add_serialization_to_statistics(const std::chrono::nanoseconds duration);
+  /// Returns stored serialization statistics.
+  StatisticsTracker serialization_statistics() const;
+  /**
+   * \brief Adds the number of samples taken after a single wakeup to the statistics.
+   *
+   * Wakeups which did not deliver any sample are not recorded.
+   * \param num_samples The number of samples taken.
+   */
+  void add_samples_per_wakeup_to_statistics(const std::uint64_t num_samples);
+  /// Returns stored samples per wakeup statistics.
+  StatisticsTracker samples_per_wakeup_statistics() const;
   /// Resets all internal counters.
   void reset();
 
@@ -57,6 +80,11 @@ protected:
    * \param increment Optional different increment step.
    */
   void increment_received(const std::uint64_t & increment = 1);
+  /**
+   * \brief Increment the number of samples received through shared memory.
+   * \param increment Optional different increment step.
+   */
+  void increment_received_shm(const std::uint64_t & increment = 1);
   /**
    * \brief Increment the number of sent samples.
    * \param increment Optional different increment step.
@@ -70,6 +98,36 @@ protected:
   void update_lost_samples_counter(const std::uint64_t sample_id);
   /// Returns the last sample id received.
   std::uint64_t prev_sample_id() const;
+  /**
+   * \brief Checks the configured maximum number of samples to take per wakeup.
+   * \param num_taken The number of samples already taken in the current wakeup.
+   * \returns Returns true if another sample may be taken in the current wakeup.
+   */
+  bool may_take_more(const std::uint64_t num_taken) const;
+  /**
+   * \brief Fills the header of the next sample to publish and counts it as sent.
+   * \param header The header to fill.
+   * \param time The time to fill into the header.
+   * \param payload_size The number of payload bytes following the header.
+   */
+  void init_header(
+    SampleHeader & header, const std::int64_t time,
+    const std::uint64_t payload_size);
+  /**
+   * \brief Verifies a received sample and updates the statistics. The lock must be held.
+   * \param header The header of the sample.
+   * \param payload_size The expected number of payload bytes following the header.
+   */
+  void handle_sample(const SampleHeader & header, const std::uint64_t payload_size);
+  /**
+   * \brief Stores the exception currently handled in a callback on a thread of the middleware.
+   *
+   * Exceptions must not propagate into the middleware, so they are rethrown on the runner
+   * thread by rethrow_callback_exception(). Only the first exception is kept.
+   */
+  void store_callback_exception();
+  /// Rethrows the exception stored by store_callback_exception(), if any.
+  void rethrow_callback_exception();
 
   /// The experiment configuration.
   const ExperimentConfiguration & m_ec;
@@ -87,30 +145,14 @@ protected:
     return m_lock;
   }
 
-  // TODO(erik.snider) switch to std::void_t when upgrading to C++17
-  template<class ...>
-  using void_t = void;
-
-  template<typename T, typename = void>
-  struct has_bounded_sequence : std::false_type {};
-
   template<typename T>
-  struct has_bounded_sequence<T,
-    void_t<decltype(std::declval<T>().bounded_sequence)>>: std::true_type {};
-
-  template<typename T, typename = void>
-  struct has_unbounded_sequence : std::false_type {};
+  using has_bounded_sequence = msg_traits::has_bounded_sequence<T>;
 
   template<typename T>
-  struct has_unbounded_sequence<T,
-    void_t<decltype(std::declval<T>().unbounded_sequence)>>: std::true_type {};
-
-  template<typename T, typename = void>
-  struct has_unbounded_string : std::false_type {};
+  using has_unbounded_sequence = msg_traits::has_unbounded_sequence<T>;
 
   template<typename T>
-  struct has_unbounded_string<T,
-    void_t<decltype(std::declval<T>().unbounded_string)>>: std::true_type {};
+  using has_unbounded_string = msg_traits::has_unbounded_string<T>;
 
   template<typename T>
   inline
@@ -123,10 +165,7 @@ protected:
 
   template<typename T>
   inline
-  std::enable_if_t<
-    has_bounded_sequence<T>::value ||
-    has_unbounded_sequence<T>::value ||
-    has_unbounded_string<T>::value, void>
+  std::enable_if_t<!msg_traits::is_fixed_size<T>::value, void>
   ensure_fixed_size(T &)
   {
     throw std::runtime_error("This plugin only supports messages with a fixed size");
@@ -134,24 +173,27 @@ protected:
 
   template<typename T>
   inline
-  std::enable_if_t<
-    !has_bounded_sequence<T>::value &&
-    !has_unbounded_sequence<T>::value &&
-    !has_unbounded_string<T>::value, void>
+  std::enable_if_t<msg_traits::is_fixed_size<T>::value, void>
   ensure_fixed_size(T &) {}
 
 private:
   std::uint64_t m_prev_sample_id;
   std::uint64_t m_num_lost_samples;
   std::uint64_t m_received_sample_counter;
+  std::uint64_t m_received_shm_sample_counter;
   std::uint64_t m_sent_sample_counter;
 #if defined(QNX)
   std::uint64_t m_cps;
 #endif
 
   StatisticsTracker m_latency;
+  StatisticsTracker m_serialization;
+  StatisticsTracker m_samples_per_wakeup;
 
   SpinLock & m_lock;
+
+  std::mutex m_callback_exception_mutex;
+  std::exception_ptr m_callback_exception;
 };
 
 }  // namespace performance_test
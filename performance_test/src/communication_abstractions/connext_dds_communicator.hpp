@@ -17,6 +17,10 @@
 
 #include <ndds/ndds_cpp.h>
 
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
 #include "communicator.hpp"
 #include "resource_manager.hpp"
 
@@ -85,15 +89,17 @@ private:
 /**
  * \brief The plugin for Connext DDS.
  * \tparam Topic The topic type to use.
+ * \tparam Type The data type to use. With Topic::ConnextDDSZeroCopyType the samples are loaned
+ *         from the data writer and transferred with zero copy over shared memory.
  *
  * The code in here is derived from the C++ example in the Connext DDS installation folder.
  */
-template<class Topic>
+template<class Topic, class Type = typename Topic::ConnextDDSType>
 class RTIDDSCommunicator : public Communicator
 {
 public:
   /// The data type to use.
-  using DataType = typename Topic::ConnextDDSType;
+  using DataType = Type;
   /// The TypeSupport for the Type.
   using TypeSupport = typename DataType::TypeSupport;
   /// The type of the data writer.
@@ -109,11 +115,26 @@ public:
     m_participant(ResourceManager::get().connext_dds_participant()),
     m_datawriter(nullptr),
     m_datareader(nullptr),
-    m_typed_datareader(nullptr)
+    m_typed_datareader(nullptr),
+    m_listener(*this)
   {
+    if (m_ec.is_zero_copy_transfer() && !s_zero_copy) {
+      throw std::runtime_error(
+              "Zero copy transfer requires an Array or PointCloud message and a build with "
+              "PERFORMANCE_TEST_CONNEXTDDS_ZERO_COPY_ENABLED");
+    }
     register_topic();
   }
 
+  ~RTIDDSCommunicator()
+  {
+    if (m_datareader != nullptr &&
+      m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER)
+    {
+      m_datareader->set_listener(nullptr, DDS_STATUS_MASK_NONE);
+    }
+  }
+
   /**
    * \brief Publishes the provided data.
    *
@@ -149,7 +170,8 @@ public:
       }
     }
     if (m_ec.is_zero_copy_transfer()) {
-      throw std::runtime_error("This plugin does not support zero copy transfer");
+      write_loaned_sample(time);
+      return;
     }
     lock();
     init_msg(m_data, time);
@@ -169,9 +191,16 @@ public:
    * * Verifies that the data arrived in the right order, chronologically and also consistent with the publishing order.
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the Connext DDS thread which invokes
+   * the data available listener instead and this function only sleeps.
    */
   void update_subscription()
   {
+    if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
+      throw std::runtime_error("Round trip mode is not implemented for Connext DDS!");
+    }
+
     if (m_datareader == nullptr) {
       DDSSubscriber * subscriber = nullptr;
       DDS_DataReaderQos dr_qos;
@@ -199,28 +228,107 @@ public:
         throw std::runtime_error("datareader == nullptr");
       }
 
-      m_condition = m_datareader->get_statuscondition();
-      m_condition->set_enabled_statuses(DDS_DATA_AVAILABLE_STATUS);
-      m_waitset.attach_condition(m_condition);
-
       m_typed_datareader = DataReaderType::narrow(m_datareader);
       if (m_typed_datareader == nullptr) {
         throw std::runtime_error("m_typed_datareader == nullptr");
       }
 
-      if (!m_condition_seq.ensure_length(2, 2)) {
-        throw std::runtime_error("Error ensuring length of active_conditions_seq.");
+      if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+        // The listener is set after narrowing, because it can be invoked right away.
+        if (m_datareader->set_listener(&m_listener, DDS_DATA_AVAILABLE_STATUS) !=
+          DDS_RETCODE_OK)
+        {
+          throw std::runtime_error("failed to set the datareader listener");
+        }
+      } else {
+        m_condition = m_datareader->get_statuscondition();
+        m_condition->set_enabled_statuses(DDS_DATA_AVAILABLE_STATUS);
+        m_waitset.attach_condition(m_condition);
+
+        if (!m_condition_seq.ensure_length(2, 2)) {
+          throw std::runtime_error("Error ensuring length of active_conditions_seq.");
+        }
       }
     }
 
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
     DDS_Duration_t wait_timeout = {15, 0};
     m_waitset.wait(m_condition_seq, wait_timeout);
+    take_samples();
+  }
+
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * sizeof(DataType);
+  }
+
+private:
+  /// Whether the data type has the SHMEM_REF transfer mode.
+  static constexpr bool s_zero_copy =
+    !std::is_same<DataType, typename Topic::ConnextDDSType>::value;
+
+  /**
+   * \brief Writes a sample loaned from the data writer.
+   *
+   * The sample is allocated in shared memory. Readers on the same host receive a reference to
+   * it instead of a serialized copy. The loan is returned to the data writer by writing it.
+   */
+  template<typename T = DataType>
+  std::enable_if_t<!std::is_same<T, typename Topic::ConnextDDSType>::value>
+  write_loaned_sample(std::int64_t time)
+  {
+    T * sample = nullptr;
+    if (m_typed_datawriter->get_loan(sample) != DDS_RETCODE_OK) {
+      throw std::runtime_error("Failed to loan a sample");
+    }
+    lock();
+    init_msg(*sample, time);
+    increment_sent();  // We increment before publishing so we don't have to lock twice.
+    unlock();
+    if (m_typed_datawriter->write(*sample, DDS_HANDLE_NIL) != DDS_RETCODE_OK) {
+      throw std::runtime_error("Failed to write to sample");
+    }
+  }
+
+  template<typename T = DataType>
+  std::enable_if_t<std::is_same<T, typename Topic::ConnextDDSType>::value>
+  write_loaned_sample(std::int64_t)
+  {
+    throw std::runtime_error("This message does not support zero copy transfer");
+  }
+
+  /// Takes the samples on the thread which Connext DDS invokes the listeners on.
+  class Listener : public DDSDataReaderListener
+  {
+  public:
+    explicit Listener(RTIDDSCommunicator & communicator)
+    : m_communicator(communicator) {}
 
+    void on_data_available(DDSDataReader *) override
+    {
+      m_communicator.take_samples();
+    }
+
+  private:
+    RTIDDSCommunicator & m_communicator;
+  };
+
+  /// Takes the available samples, up to the configured maximum per wakeup.
+  void take_samples()
+  {
+    const auto max_samples = m_ec.max_samples_per_take() == 0 ?
+      DDS_LENGTH_UNLIMITED : static_cast<DDS_Long>(m_ec.max_samples_per_take());
     auto ret = m_typed_datareader->take(
-      m_data_seq, m_sample_info_seq, DDS_LENGTH_UNLIMITED,
+      m_data_seq, m_sample_info_seq, max_samples,
       DDS_ANY_SAMPLE_STATE, DDS_ANY_VIEW_STATE, DDS_ANY_INSTANCE_STATE);
     if (ret == DDS_RETCODE_OK) {
       lock();
+      add_samples_per_wakeup_to_statistics(m_data_seq.length());
       for (decltype(m_data_seq.length()) j = 0; j < m_data_seq.length(); ++j) {
         const auto & data = m_data_seq[j];
         if (m_sample_info_seq[j].valid_data) {
@@ -241,21 +349,10 @@ public:
       }
       unlock();
 
-      if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
-        throw std::runtime_error("Round trip mode is not implemented for Connext DDS!");
-      }
-
       m_typed_datareader->return_loan(m_data_seq, m_sample_info_seq);
     }
   }
 
-  /// Returns the data received in bytes.
-  std::size_t data_received()
-  {
-    return num_received_samples() * sizeof(DataType);
-  }
-
-private:
   /// Registers a topic to the participant. It makes sure that each topic is only registered once.
   void register_topic()
   {
@@ -292,6 +389,7 @@ private:
 
   DataReaderType * m_typed_datareader;
   DataWriterType * m_typed_datawriter;
+  Listener m_listener;
 
   DataTypeSeq m_data_seq;
   DDS_SampleInfoSeq m_sample_info_seq;
@@ -300,8 +398,8 @@ private:
   DataType m_data;
 };
 
-template<class Topic>
-DDSTopic * RTIDDSCommunicator<Topic>::m_topic = nullptr;
+template<class Topic, class Type>
+DDSTopic * RTIDDSCommunicator<Topic, Type>::m_topic = nullptr;
 
 }  // namespace performance_test
 
@@ -21,6 +21,10 @@
 #include <dds_cpp/dds_cpp_rh_sm.hxx>
 #include <dds_cpp/dds_cpp_netio.hxx>
 
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include "communicator.hpp"
 #include "resource_manager.hpp"
 
@@ -114,11 +118,21 @@ public:
     m_participant(ResourceManager::get().connext_DDS_micro_participant()),
     m_datawriter(nullptr),
     m_datareader(nullptr),
-    m_typed_datareader(nullptr)
+    m_typed_datareader(nullptr),
+    m_listener(*this)
   {
     register_topic();
   }
 
+  ~RTIMicroDDSCommunicator()
+  {
+    if (m_datareader != nullptr &&
+      m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER)
+    {
+      m_datareader->set_listener(nullptr, DDS_STATUS_MASK_NONE);
+    }
+  }
+
   /**
    * \brief Publishes the provided data.
    *
@@ -142,7 +156,7 @@ public:
       qos_adapter.apply(dw_qos);
 
       m_datawriter = publisher->create_datawriter(
-        m_topic,
+        m_pub_topic,
         dw_qos, nullptr, DDS_STATUS_MASK_NONE);
       if (m_datawriter == nullptr) {
         throw std::runtime_error("Could not create datawriter");
@@ -189,6 +203,11 @@ public:
    * * Verifies that the data arrived in the right order, chronologically and also consistent with the publishing order.
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the Connext DDS Micro thread which invokes
+   * the data available listener instead and this function only sleeps.
+   *
+   * In relay mode, the received samples are published back with their original timestamp.
    */
   void update_subscription()
   {
@@ -209,7 +228,7 @@ public:
 
       /* Only DDS_DATA_AVAILABLE_STATUS supported currently */
       m_datareader = subscriber->create_datareader(
-        m_topic,
+        m_sub_topic,
         dr_qos,
         nullptr,
         DDS_STATUS_MASK_NONE);
@@ -218,32 +237,83 @@ public:
         throw std::runtime_error("datareader == nullptr");
       }
 
-      m_condition = m_datareader->get_statuscondition();
-      m_condition->set_enabled_statuses(DDS_DATA_AVAILABLE_STATUS);
-      m_waitset.attach_condition(m_condition);
-
       m_typed_datareader = DataReaderType::narrow(m_datareader);
       if (m_typed_datareader == nullptr) {
         throw std::runtime_error("m_typed_datareader == nullptr");
       }
 
-      if (!m_condition_seq.ensure_length(2, 2)) {
-        throw std::runtime_error("Error ensuring length of active_conditions_seq.");
+      if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+        // The listener is set after narrowing, because it can be invoked right away.
+        if (m_datareader->set_listener(&m_listener, DDS_DATA_AVAILABLE_STATUS) !=
+          DDS_RETCODE_OK)
+        {
+          throw std::runtime_error("failed to set the datareader listener");
+        }
+      } else {
+        m_condition = m_datareader->get_statuscondition();
+        m_condition->set_enabled_statuses(DDS_DATA_AVAILABLE_STATUS);
+        m_waitset.attach_condition(m_condition);
+
+        if (!m_condition_seq.ensure_length(2, 2)) {
+          throw std::runtime_error("Error ensuring length of active_conditions_seq.");
+        }
       }
     }
 
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
     DDS_Duration_t wait_timeout = {15, 0};
     m_waitset.wait(m_condition_seq, wait_timeout);
+    take_samples();
+  }
+
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * sizeof(DataType);
+  }
+
+private:
+  /// Takes the samples on the thread which Connext DDS Micro invokes the listeners on.
+  class Listener : public DDSDataReaderListener
+  {
+  public:
+    explicit Listener(RTIMicroDDSCommunicator & communicator)
+    : m_communicator(communicator) {}
+
+    void on_data_available(DDSDataReader *) override
+    {
+      m_communicator.take_samples();
+    }
+
+  private:
+    RTIMicroDDSCommunicator & m_communicator;
+  };
 
+  /// Takes the available samples, up to the configured maximum per wakeup.
+  void take_samples()
+  {
+    const auto max_samples = m_ec.max_samples_per_take() == 0 ?
+      DDS_LENGTH_UNLIMITED : static_cast<DDS_Long>(m_ec.max_samples_per_take());
     auto ret = m_typed_datareader->take(
-      m_data_seq, m_sample_info_seq, DDS_LENGTH_UNLIMITED,
+      m_data_seq, m_sample_info_seq, max_samples,
       DDS_ANY_SAMPLE_STATE, DDS_ANY_VIEW_STATE,
       DDS_ANY_INSTANCE_STATE);
     if (ret == DDS_RETCODE_OK) {
       lock();
+      add_samples_per_wakeup_to_statistics(m_data_seq.length());
       for (decltype(m_data_seq.length()) j = 0; j < m_data_seq.length(); ++j) {
         const auto & data = m_data_seq[j];
         if (m_sample_info_seq[j].valid_data) {
+          if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
+            unlock();
+            publish(data.time);
+            lock();
+            continue;
+          }
           if (m_prev_timestamp >= data.time) {
             throw std::runtime_error(
                     "Data consistency violated. Received sample with not strictly older timestamp. "
@@ -261,45 +331,51 @@ public:
       }
       unlock();
 
-      if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
-        throw std::runtime_error("Round trip mode is not implemented for Connext DDS Micro!");
-      }
-
       m_typed_datareader->return_loan(
         m_data_seq,
         m_sample_info_seq);
     }
   }
 
-  /// Returns the data received in bytes.
-  std::size_t data_received()
-  {
-    return num_received_samples() * sizeof(DataType);
-  }
-
-private:
-  /// Registers a topic to the participant. It makes sure that each topic is only registered once.
+  /**
+   * \brief Registers the topics to the participant. It makes sure that each topic is only
+   *        registered once.
+   *
+   * In round trip mode, the data writer and the data reader use different topics.
+   */
   void register_topic()
   {
-    if (m_topic == nullptr) {
+    if (m_pub_topic == nullptr) {
       auto retcode = Topic::ConnextDDSMicroType::TypeSupport::register_type(
         m_participant, Topic::msg_name().c_str());
       if (retcode != DDS_RETCODE_OK) {
         throw std::runtime_error("failed to register type");
       }
-      m_topic = m_participant->create_topic(
-        m_ec.topic_name().c_str(),
-        Topic::msg_name().c_str(),
-        DDS_TOPIC_QOS_DEFAULT,
-        nullptr,
-        DDS_STATUS_MASK_NONE);
-      if (m_topic == nullptr) {
-        throw std::runtime_error("topic == nullptr");
+      m_pub_topic = create_topic(m_ec.pub_topic_postfix());
+      if (m_ec.sub_topic_postfix() == m_ec.pub_topic_postfix()) {
+        m_sub_topic = m_pub_topic;
+      } else {
+        m_sub_topic = create_topic(m_ec.sub_topic_postfix());
       }
-      m_topic->enable();
     }
   }
 
+  /// Creates and enables the topic with the configured name and the given \param postfix.
+  DDSTopic * create_topic(const std::string & postfix)
+  {
+    DDSTopic * topic = m_participant->create_topic(
+      (m_ec.topic_name() + postfix).c_str(),
+      Topic::msg_name().c_str(),
+      DDS_TOPIC_QOS_DEFAULT,
+      nullptr,
+      DDS_STATUS_MASK_NONE);
+    if (topic == nullptr) {
+      throw std::runtime_error("topic == nullptr");
+    }
+    topic->enable();
+    return topic;
+  }
+
   /**
   * \brief Initializes the frame_id field in data header.
   * This is the overloaded method which is called if data header has frame_id
@@ -375,16 +451,21 @@ private:
 
   DataReaderType * m_typed_datareader;
   DataWriterType * m_typed_datawriter;
+  Listener m_listener;
 
   DataTypeSeq m_data_seq;
   DDS_SampleInfoSeq m_sample_info_seq;
-  static DDSTopic * m_topic;
+  static DDSTopic * m_pub_topic;
+  static DDSTopic * m_sub_topic;
 
   DataType m_data;
 };
 
 template<class Topic>
-DDSTopic * RTIMicroDDSCommunicator<Topic>::m_topic = nullptr;
+DDSTopic * RTIMicroDDSCommunicator<Topic>::m_pub_topic = nullptr;
+
+template<class Topic>
+DDSTopic * RTIMicroDDSCommunicator<Topic>::m_sub_topic = nullptr;
 
 }  // namespace performance_test
 
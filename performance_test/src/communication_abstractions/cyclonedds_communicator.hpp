@@ -16,8 +16,16 @@
 #define COMMUNICATION_ABSTRACTIONS__CYCLONEDDS_COMMUNICATOR_HPP_
 
 #include <dds/dds.h>
+#include <dds/ddsi/ddsi_serdata.h>
+#ifdef DDS_HAS_SHM
+  #include <dds/ddsi/ddsi_shm_transport.h>
+#endif
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "communicator.hpp"
 #include "resource_manager.hpp"
@@ -98,9 +106,11 @@ public:
    * \brief Constructs the QOS adapter.
    * \param qos The abstract QOS settings the adapter should use to derive the
    * implementation specific QOS settings.
+   * \param history_depth The KEEP_LAST history depth to use for shared memory.
    */
-  explicit CycloneDDSIceoryxQOSAdapter(const QOSAbstraction qos)
-  : m_qos(qos)
+  CycloneDDSIceoryxQOSAdapter(const QOSAbstraction qos, const uint32_t history_depth)
+  : m_qos(qos),
+    m_history_depth(history_depth)
   {}
   /**
    * \brief Applies the abstract QOS to an existing QOS leaving unsupported values as
@@ -121,12 +131,13 @@ public:
     dds_qset_durability(qos, DDS_DURABILITY_VOLATILE);
 
     std::cerr << "Cyclone DDS + iceoryx only supports KEEP_LAST history. " <<
-      "Setting history to KEEP_LAST, with a depth of 16." << std::endl;
-    dds_qset_history(qos, DDS_HISTORY_KEEP_LAST, static_cast<int32_t>(16));
+      "Setting history to KEEP_LAST, with a depth of " << m_history_depth << "." << std::endl;
+    dds_qset_history(qos, DDS_HISTORY_KEEP_LAST, static_cast<int32_t>(m_history_depth));
   }
 
 private:
   const QOSAbstraction m_qos;
+  const uint32_t m_history_depth;
 };
 
 /**
@@ -149,6 +160,16 @@ public:
   {
   }
 
+  ~CycloneDDSCommunicator()
+  {
+    if (m_datareader > 0 &&
+      m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER)
+    {
+      // Waits for a running listener callback to finish.
+      dds_set_listener(m_datareader, nullptr);
+    }
+  }
+
   /**
    * \brief Publishes the provided data.
    *
@@ -162,7 +183,7 @@ public:
     if (m_datawriter == 0) {
       dds_qos_t * dw_qos = dds_create_qos();
       if (m_ec.is_zero_copy_transfer()) {
-        CycloneDDSIceoryxQOSAdapter qos_adapter(m_ec.qos());
+        CycloneDDSIceoryxQOSAdapter qos_adapter(m_ec.qos(), m_ec.shm_history_depth());
         qos_adapter.apply(dw_qos);
       } else {
         CycloneDDSQOSAdapter qos_adapter(m_ec.qos());
@@ -214,13 +235,16 @@ public:
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics
        accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the Cyclone DDS thread which
+   * invokes the data available listener instead and this function only sleeps.
    */
   void update_subscription()
   {
     if (m_datareader == 0) {
       dds_qos_t * dw_qos = dds_create_qos();
       if (m_ec.is_zero_copy_transfer()) {
-        CycloneDDSIceoryxQOSAdapter qos_adapter(m_ec.qos());
+        CycloneDDSIceoryxQOSAdapter qos_adapter(m_ec.qos(), m_ec.shm_history_depth());
         qos_adapter.apply(dw_qos);
       } else {
         CycloneDDSQOSAdapter qos_adapter(m_ec.qos());
@@ -233,43 +257,38 @@ public:
       if (m_datareader < 0) {
         throw std::runtime_error("failed to create datareader");
       }
-      dds_set_status_mask(m_datareader, DDS_DATA_AVAILABLE_STATUS);
-      m_waitset = dds_create_waitset(m_participant);
-      if (dds_waitset_attach(m_waitset, m_datareader, 1) < 0) {
-        throw std::runtime_error("failed to attach waitset");
+      std::size_t batch_size = s_default_batch_size;
+      if (m_ec.is_zero_copy_transfer()) {
+        batch_size = m_ec.shm_history_depth();
+        m_serdata.resize(batch_size);
+      } else if (m_ec.max_samples_per_take() != 0) {
+        batch_size = m_ec.max_samples_per_take();
       }
-    }
-
-    dds_waitset_wait(m_waitset, nullptr, 0, DDS_SECS(15));
-
-    void * untyped = nullptr;
-    dds_sample_info_t si;
-    int32_t n;
-    while ((n = dds_take(m_datareader, &untyped, &si, 1, 1)) > 0) {
-      lock();
-      const DataType * data = static_cast<DataType *>(untyped);
-      if (si.valid_data) {
-        if (m_prev_timestamp >= data->time) {
-          throw std::runtime_error(
-                  "Data consistency violated. Received sample with not strictly older timestamp. "
-                  "Time diff: " + std::to_string(data->time - m_prev_timestamp) +
-                  " Data Time: " + std::to_string(data->time));
-        }
-        if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
-          unlock();
-          publish(data->time);
-          lock();
-        } else {
-          m_prev_timestamp = data->time;
-          update_lost_samples_counter(data->id);
-          add_latency_to_statistics(data->time);
-          increment_received();
+      m_samples.resize(batch_size);
+      m_sample_infos.resize(batch_size);
+      if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+        // The listener is set after the buffers exist, because it can be invoked right away.
+        dds_listener_t * listener = dds_create_listener(this);
+        dds_lset_data_available(listener, on_data_available);
+        dds_set_listener(m_datareader, listener);
+        dds_delete_listener(listener);
+      } else {
+        dds_set_status_mask(m_datareader, DDS_DATA_AVAILABLE_STATUS);
+        m_waitset = dds_create_waitset(m_participant);
+        if (dds_waitset_attach(m_waitset, m_datareader, 1) < 0) {
+          throw std::runtime_error("failed to attach waitset");
         }
       }
-      unlock();
+    }
 
-      dds_return_loan(m_datareader, &untyped, n);
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      rethrow_callback_exception();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
     }
+
+    dds_waitset_wait(m_waitset, nullptr, 0, DDS_SECS(15));
+    take_samples();
   }
 
   /// Returns the data received in bytes.
@@ -279,6 +298,141 @@ public:
   }
 
 private:
+  /**
+   * \brief Called by Cyclone DDS when the data reader has data available.
+   *
+   * The listener is not invoked again for the samples left after the maximum number of samples
+   * per take, so they are taken in further batches until the reader is empty.
+   */
+  static void on_data_available(dds_entity_t, void * arg)
+  {
+    auto self = static_cast<CycloneDDSCommunicator *>(arg);
+    try {
+      while (self->take_samples()) {}
+    } catch (...) {
+      self->store_callback_exception();
+    }
+  }
+
+  /**
+   * \brief Takes the available samples in batches, up to the configured maximum per wakeup.
+   * \returns Returns whether the maximum number of samples per wakeup was reached.
+   */
+  bool take_samples()
+  {
+    std::uint64_t num_taken = 0;
+    int32_t n;
+    while (may_take_more(num_taken) && (n = take_batch(next_batch_size(num_taken))) > 0) {
+      num_taken += static_cast<std::uint64_t>(n);
+    }
+    lock();
+    add_samples_per_wakeup_to_statistics(num_taken);
+    unlock();
+    return !may_take_more(num_taken);
+  }
+
+  /// Returns the number of samples to request from the next take, respecting the configured
+  /// maximum number of samples per wakeup.
+  uint32_t next_batch_size(const std::uint64_t num_taken) const
+  {
+    std::uint64_t batch_size = m_sample_infos.size();
+    if (m_ec.max_samples_per_take() != 0) {
+      batch_size = std::min<std::uint64_t>(batch_size, m_ec.max_samples_per_take() - num_taken);
+    }
+    return static_cast<uint32_t>(batch_size);
+  }
+
+  /**
+   * \brief Takes and handles up to \p max_samples samples.
+   * \returns Returns the number of samples taken, 0 if none were available.
+   */
+  int32_t take_batch(const uint32_t max_samples)
+  {
+    if (m_ec.is_zero_copy_transfer()) {
+      return take_serdata(max_samples);
+    }
+    // A null pointer in the first element makes Cyclone DDS loan the samples to us.
+    m_samples[0] = nullptr;
+    const int32_t n = dds_take(
+      m_datareader, m_samples.data(), m_sample_infos.data(), max_samples, max_samples);
+    for (int32_t i = 0; i < n; ++i) {
+      if (m_sample_infos[i].valid_data) {
+        handle_sample(*static_cast<const DataType *>(m_samples[i]), false);
+      }
+    }
+    if (n > 0) {
+      dds_return_loan(m_datareader, m_samples.data(), n);
+    }
+    return n;
+  }
+
+  /**
+   * \brief Takes and handles up to \p max_samples samples without copying them.
+   *
+   * The samples are taken as serialized data, which references the iceoryx chunk if the sample
+   * was delivered through shared memory. A chunk containing the raw sample is used in place.
+   * Samples which arrived over the network are deserialized.
+   * \returns Returns the number of samples taken, 0 if none were available.
+   */
+  int32_t take_serdata(const uint32_t max_samples)
+  {
+    const int32_t n = dds_takecdr(
+      m_datareader, m_serdata.data(), max_samples, m_sample_infos.data(), 0);
+    for (int32_t i = 0; i < n; ++i) {
+      if (m_sample_infos[i].valid_data) {
+        bool from_shm = false;
+        const DataType & data = sample_from_serdata(*m_serdata[i], from_shm);
+        handle_sample(data, from_shm);
+      }
+      ddsi_serdata_unref(m_serdata[i]);
+    }
+    return n;
+  }
+
+  /// Returns the sample referenced by \p serdata and sets \p from_shm if it arrived through SHM.
+  const DataType & sample_from_serdata(const ddsi_serdata & serdata, bool & from_shm)
+  {
+#ifdef DDS_HAS_SHM
+    if (serdata.iox_chunk != nullptr) {
+      from_shm = true;
+      const iceoryx_header_t * header = iceoryx_header_from_chunk(serdata.iox_chunk);
+      if (header->shm_data_state == IOX_CHUNK_CONTAINS_RAW_DATA) {
+        return *static_cast<const DataType *>(serdata.iox_chunk);
+      }
+    }
+#endif
+    if (!ddsi_serdata_to_sample(&serdata, &m_data, nullptr, nullptr)) {
+      throw std::runtime_error("failed to deserialize sample");
+    }
+    return m_data;
+  }
+
+  /// Verifies the received sample and updates the statistics, or relays it.
+  void handle_sample(const DataType & data, const bool from_shm)
+  {
+    lock();
+    if (m_prev_timestamp >= data.time) {
+      throw std::runtime_error(
+              "Data consistency violated. Received sample with not strictly older timestamp. "
+              "Time diff: " + std::to_string(data.time - m_prev_timestamp) +
+              " Data Time: " + std::to_string(data.time));
+    }
+    if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
+      unlock();
+      publish(data.time);
+      lock();
+    } else {
+      m_prev_timestamp = data.time;
+      update_lost_samples_counter(data.id);
+      add_latency_to_statistics(data.time);
+      increment_received();
+      if (from_shm) {
+        increment_received_shm();
+      }
+    }
+    unlock();
+  }
+
   /// Creates a new topic for the participant
   dds_entity_t create_topic(const std::string & postfix)
   {
@@ -301,6 +455,13 @@ private:
   dds_entity_t m_condition;
 
   DataType m_data;
+
+  /// The number of samples taken at once if the number of samples per wakeup is unlimited.
+  static constexpr std::size_t s_default_batch_size = 16;
+
+  std::vector<void *> m_samples;
+  std::vector<ddsi_serdata *> m_serdata;
+  std::vector<dds_sample_info_t> m_sample_infos;
 };
 
 }  // namespace performance_test
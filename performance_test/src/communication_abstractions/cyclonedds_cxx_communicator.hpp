@@ -17,8 +17,10 @@
 
 #include <dds/dds.hpp>
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "communicator.hpp"
 #include "resource_manager.hpp"
@@ -124,7 +126,9 @@ public:
     m_datawriter(make_cyclonedds_cxx_datawriter<DataType>(m_participant, m_publisher, m_ec)),
     m_datareader(make_cyclonedds_cxx_datareader<DataType>(m_participant, m_subscriber, m_ec)),
     m_read_condition(m_datareader, dds::sub::status::SampleState::not_read()),
-    m_waitset()
+    m_waitset(),
+    m_listener(*this),
+    m_listener_attached(false)
   {
     m_waitset.attach_condition(m_read_condition);
 
@@ -135,6 +139,9 @@ public:
 
   ~CycloneDDSCXXCommunicator()
   {
+    if (m_listener_attached) {
+      this->m_datareader.listener(nullptr, dds::core::status::StatusMask::none());
+    }
     this->m_datareader = dds::core::null;
     this->m_datawriter = dds::core::null;
     this->m_subscriber = dds::core::null;
@@ -173,9 +180,21 @@ public:
    * * Verifies that the data arrived in the right order, chronologically and also consistent with the publishing order.
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics accordingly.
+   *
+   * With the listener delivery mode, the first call attaches a data available listener, which
+   * takes the samples on a Cyclone DDS thread. This function then only sleeps.
    */
   void update_subscription()
   {
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      if (!m_listener_attached) {
+        m_datareader.listener(&m_listener, dds::core::status::StatusMask::data_available());
+        m_listener_attached = true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
     // Wait for the data to become available. This is the only condition, so no need to inspect the
     // returned list of triggered conditions.
     try {
@@ -184,7 +203,41 @@ public:
       // The timeout probably comes from reaching the maximum runtime
       return;
     }
-    dds::sub::LoanedSamples<DataType> samples = m_datareader->take();
+    take_samples();
+  }
+
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * sizeof(DataType);
+  }
+
+private:
+  /// Takes the samples on the thread which Cyclone DDS invokes the listeners on.
+  class Listener : public dds::sub::NoOpDataReaderListener<DataType>
+  {
+  public:
+    explicit Listener(CycloneDDSCXXCommunicator & communicator)
+    : m_communicator(communicator) {}
+
+    void on_data_available(dds::sub::DataReader<DataType> &) override
+    {
+      m_communicator.take_samples();
+    }
+
+  private:
+    CycloneDDSCXXCommunicator & m_communicator;
+  };
+
+  /// Takes the available samples, up to the configured maximum per wakeup.
+  void take_samples()
+  {
+    dds::sub::LoanedSamples<DataType> samples = m_ec.max_samples_per_take() == 0 ?
+      m_datareader->take() :
+      m_datareader.select().max_samples(m_ec.max_samples_per_take()).take();
+    lock();
+    add_samples_per_wakeup_to_statistics(samples.length());
+    unlock();
     for (auto & sample : samples) {
       if (sample->info().valid()) {
         if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
@@ -200,13 +253,6 @@ public:
     }
   }
 
-  /// Returns the data received in bytes.
-  std::size_t data_received()
-  {
-    return num_received_samples() * sizeof(DataType);
-  }
-
-private:
   dds::domain::DomainParticipant m_participant;
   dds::pub::Publisher m_publisher;
   dds::sub::Subscriber m_subscriber;
@@ -214,6 +260,8 @@ private:
   dds::sub::DataReader<DataType> m_datareader;
   dds::sub::cond::ReadCondition m_read_condition;
   dds::core::cond::WaitSet m_waitset;
+  Listener m_listener;
+  bool m_listener_attached;
 
   void init_msg(DataType & msg, std::int64_t time)
   {
@@ -0,0 +1,375 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__FAST_DDS_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__FAST_DDS_COMMUNICATOR_HPP_
+
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "communicator.hpp"
+#include "resource_manager.hpp"
+#include "../experiment_configuration/qos_abstraction.hpp"
+
+namespace performance_test
+{
+
+/// Translates abstract QOS settings to specific QOS settings for the Fast DDS DDS layer.
+class FastDDSQOSAdapter
+{
+public:
+  /**
+   * \brief Constructs the QOS adapter.
+   * \param qos The abstract QOS settings the adapter should use to derive the implementation
+   * specific QOS settings.
+   */
+  explicit FastDDSQOSAdapter(const QOSAbstraction qos)
+  : m_qos(qos)
+  {}
+
+  /**
+   * \brief Applies the abstract QOS to an existing QOS leaving unsupported values as they were.
+   * \tparam FastDDSQos The type of the QOS setting, for example data reader or data writer QOS.
+   * \param qos The QOS settings to fill supported values in.
+   * \param data_sharing Whether to deliver the samples through data-sharing.
+   */
+  template<class FastDDSQos>
+  void apply(FastDDSQos & qos, const bool data_sharing) const
+  {
+    if (m_qos.reliability == QOSAbstraction::Reliability::BEST_EFFORT) {
+      qos.reliability().kind = eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS;
+    } else if (m_qos.reliability == QOSAbstraction::Reliability::RELIABLE) {
+      qos.reliability().kind = eprosima::fastdds::dds::RELIABLE_RELIABILITY_QOS;
+    } else {
+      throw std::runtime_error("Unsupported QOS!");
+    }
+
+    if (m_qos.durability == QOSAbstraction::Durability::VOLATILE) {
+      qos.durability().kind = eprosima::fastdds::dds::VOLATILE_DURABILITY_QOS;
+    } else if (m_qos.durability == QOSAbstraction::Durability::TRANSIENT_LOCAL) {
+      qos.durability().kind = eprosima::fastdds::dds::TRANSIENT_LOCAL_DURABILITY_QOS;
+    } else {
+      throw std::runtime_error("Unsupported QOS!");
+    }
+
+    if (m_qos.history_kind == QOSAbstraction::HistoryKind::KEEP_ALL) {
+      qos.history().kind = eprosima::fastdds::dds::KEEP_ALL_HISTORY_QOS;
+    } else if (m_qos.history_kind == QOSAbstraction::HistoryKind::KEEP_LAST) {
+      qos.history().kind = eprosima::fastdds::dds::KEEP_LAST_HISTORY_QOS;
+      qos.history().depth = static_cast<int32_t>(m_qos.history_depth);
+    } else {
+      throw std::runtime_error("Unsupported QOS!");
+    }
+    qos.resource_limits().max_samples = static_cast<int32_t>(m_qos.history_depth);
+    qos.resource_limits().allocated_samples = static_cast<int32_t>(m_qos.history_depth);
+
+    if (data_sharing) {
+      qos.data_sharing().automatic();
+      qos.endpoint().history_memory_policy =
+        eprosima::fastrtps::rtps::PREALLOCATED_MEMORY_MODE;
+    } else {
+      qos.data_sharing().off();
+    }
+  }
+
+  /// Applies the abstract QOS settings which only exist for data writers.
+  void apply_writer(eprosima::fastdds::dds::DataWriterQos & qos) const
+  {
+    if (m_qos.sync_pubsub) {
+      qos.publish_mode().kind = eprosima::fastdds::dds::SYNCHRONOUS_PUBLISH_MODE;
+    } else {
+      qos.publish_mode().kind = eprosima::fastdds::dds::ASYNCHRONOUS_PUBLISH_MODE;
+    }
+    qos.reliable_writer_qos().times.heartbeatPeriod.seconds = 2;
+    qos.reliable_writer_qos().times.heartbeatPeriod.nanosec = 200 * 1000 * 1000;
+  }
+
+private:
+  const QOSAbstraction m_qos;
+};
+
+/**
+ * \brief Communication plugin for Fast DDS using the DDS layer API.
+ * \tparam Topic The topic type to use.
+ *
+ * With zero copy transfer the samples are delivered through data-sharing. The publisher writes
+ * into samples loaned from the data writer and the subscriber takes loaned samples from the data
+ * reader, so no sample is copied by the plugin.
+ */
+template<class Topic>
+class FastDDSCommunicator : public Communicator
+{
+public:
+  /// The topic type to use.
+  using TopicType = typename Topic::EprosimaTopicType;
+  /// The data type to publish and subscribe to.
+  using DataType = typename Topic::EprosimaType;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit FastDDSCommunicator(SpinLock & lock)
+  : Communicator(lock),
+    m_participant(ResourceManager::get().fastdds_participant()),
+    m_type(new TopicType()),
+    m_publisher(nullptr),
+    m_datawriter(nullptr),
+    m_subscriber(nullptr),
+    m_datareader(nullptr),
+    m_listener(*this)
+  {}
+
+  ~FastDDSCommunicator()
+  {
+    if (m_datareader &&
+      m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER)
+    {
+      m_datareader->set_listener(nullptr);
+    }
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   *  The first time this function is called it also creates the data writer.
+   *  Further it updates all internal counters while running.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    if (!m_datawriter) {
+      const FastDDSQOSAdapter qos_adapter(m_ec.qos());
+      auto topic = ResourceManager::get().fastdds_topic(
+        m_ec.topic_name() + m_ec.pub_topic_postfix(), m_type);
+      m_publisher = m_participant->create_publisher(eprosima::fastdds::dds::PUBLISHER_QOS_DEFAULT);
+      auto dw_qos = m_publisher->get_default_datawriter_qos();
+      qos_adapter.apply(dw_qos, m_ec.is_zero_copy_transfer());
+      qos_adapter.apply_writer(dw_qos);
+      m_datawriter = m_publisher->create_datawriter(topic, dw_qos);
+      if (!m_datawriter) {
+        throw std::runtime_error("failed to create datawriter");
+      }
+    }
+    if (m_ec.is_zero_copy_transfer()) {
+      void * loaned_sample = nullptr;
+      if (m_datawriter->loan_sample(loaned_sample) != ReturnCode_t::RETCODE_OK) {
+        throw std::runtime_error(
+                "Failed to obtain a loaned sample. Zero copy transfer requires a plain type.");
+      }
+      DataType * sample = static_cast<DataType *>(loaned_sample);
+      lock();
+      init_msg(*sample, time);
+      increment_sent();  // We increment before publishing so we don't have to lock twice.
+      unlock();
+      if (!m_datawriter->write(loaned_sample)) {
+        throw std::runtime_error("Failed to write the loaned sample");
+      }
+    } else {
+      lock();
+      init_msg(m_data, time);
+      increment_sent();  // We increment before publishing so we don't have to lock twice.
+      unlock();
+      if (!m_datawriter->write(static_cast<void *>(&m_data))) {
+        throw std::runtime_error("Failed to write the sample");
+      }
+    }
+  }
+
+  /**
+   * \brief Reads received data from DDS.
+   *
+   * In detail this function:
+   * * Reads samples from DDS.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+   *   accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the Fast DDS thread which invokes
+   * the data available listener instead and this function only sleeps.
+   */
+  void update_subscription()
+  {
+    if (!m_datareader) {
+      const FastDDSQOSAdapter qos_adapter(m_ec.qos());
+      auto topic = ResourceManager::get().fastdds_topic(
+        m_ec.topic_name() + m_ec.sub_topic_postfix(), m_type);
+      m_subscriber =
+        m_participant->create_subscriber(eprosima::fastdds::dds::SUBSCRIBER_QOS_DEFAULT);
+      auto dr_qos = m_subscriber->get_default_datareader_qos();
+      qos_adapter.apply(dr_qos, m_ec.is_zero_copy_transfer());
+      m_datareader = m_subscriber->create_datareader(topic, dr_qos);
+      if (!m_datareader) {
+        throw std::runtime_error("failed to create datareader");
+      }
+      if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+        // The listener is set after m_datareader is assigned, because it can be invoked right
+        // away.
+        m_datareader->set_listener(
+          &m_listener, eprosima::fastdds::dds::StatusMask::data_available());
+      }
+    }
+
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      rethrow_callback_exception();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
+    m_datareader->wait_for_unread_message(eprosima::fastrtps::Duration_t(15, 0));
+    take_samples();
+  }
+
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * sizeof(DataType);
+  }
+
+private:
+  /// Takes the samples on the thread which Fast DDS invokes the listeners on.
+  class Listener : public eprosima::fastdds::dds::DataReaderListener
+  {
+  public:
+    explicit Listener(FastDDSCommunicator & communicator)
+    : m_communicator(communicator) {}
+
+    /**
+     * Fast DDS does not invoke the listener again for the samples left after the maximum number
+     * of samples per take, so they are taken in further batches until the reader is empty.
+     */
+    void on_data_available(eprosima::fastdds::dds::DataReader *) override
+    {
+      try {
+        while (m_communicator.take_samples()) {}
+      } catch (...) {
+        m_communicator.store_callback_exception();
+      }
+    }
+
+  private:
+    FastDDSCommunicator & m_communicator;
+  };
+
+  /**
+   * \brief Takes the available samples, up to the configured maximum per wakeup.
+   * \returns Returns whether the maximum number of samples per wakeup was reached.
+   */
+  bool take_samples()
+  {
+    std::uint64_t num_taken = 0;
+    if (m_ec.is_zero_copy_transfer()) {
+      while (may_take_more(num_taken) &&
+        m_datareader->take(m_loaned_data, m_loaned_infos, remaining_samples(num_taken)) ==
+        ReturnCode_t::RETCODE_OK)
+      {
+        num_taken += static_cast<std::uint64_t>(m_loaned_infos.length());
+        for (eprosima::fastdds::dds::LoanableCollection::size_type i = 0;
+          i < m_loaned_infos.length(); ++i)
+        {
+          if (m_loaned_infos[i].valid_data) {
+            handle_sample(m_loaned_data[i]);
+          }
+        }
+        m_datareader->return_loan(m_loaned_data, m_loaned_infos);
+      }
+    } else {
+      while (may_take_more(num_taken) &&
+        m_datareader->take_next_sample(static_cast<void *>(&m_data), &m_info) ==
+        ReturnCode_t::RETCODE_OK)
+      {
+        ++num_taken;
+        if (m_info.valid_data) {
+          handle_sample(m_data);
+        }
+      }
+    }
+    lock();
+    add_samples_per_wakeup_to_statistics(num_taken);
+    unlock();
+    return !may_take_more(num_taken);
+  }
+
+  /// Returns the maximum number of samples the next take may return in this wakeup.
+  int32_t remaining_samples(const std::uint64_t num_taken) const
+  {
+    if (m_ec.max_samples_per_take() == 0) {
+      return eprosima::fastdds::dds::LENGTH_UNLIMITED;
+    }
+    return static_cast<int32_t>(m_ec.max_samples_per_take() - num_taken);
+  }
+
+  void handle_sample(const DataType & data)
+  {
+    lock();
+    if (m_prev_timestamp >= data.time()) {
+      throw std::runtime_error(
+              "Data consistency violated. Received sample with not strictly older timestamp. "
+              "Time diff: " + std::to_string(data.time() - m_prev_timestamp) +
+              " Data Time: " + std::to_string(data.time()));
+    }
+    if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
+      unlock();
+      publish(data.time());
+      lock();
+    } else {
+      m_prev_timestamp = data.time();
+      update_lost_samples_counter(data.id());
+      add_latency_to_statistics(data.time());
+      increment_received();
+    }
+    unlock();
+  }
+
+  void init_msg(DataType & msg, std::int64_t time)
+  {
+    msg.time(time);
+    msg.id(next_sample_id());
+    ensure_fixed_size(msg);
+  }
+
+  using ReturnCode_t = eprosima::fastrtps::types::ReturnCode_t;
+
+  eprosima::fastdds::dds::DomainParticipant * m_participant;
+  eprosima::fastdds::dds::TypeSupport m_type;
+
+  eprosima::fastdds::dds::Publisher * m_publisher;
+  eprosima::fastdds::dds::DataWriter * m_datawriter;
+  eprosima::fastdds::dds::Subscriber * m_subscriber;
+  eprosima::fastdds::dds::DataReader * m_datareader;
+
+  eprosima::fastdds::dds::SampleInfo m_info;
+  eprosima::fastdds::dds::LoanableSequence<DataType> m_loaned_data;
+  eprosima::fastdds::dds::SampleInfoSeq m_loaned_infos;
+
+  DataType m_data;
+  Listener m_listener;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__FAST_DDS_COMMUNICATOR_HPP_
@@ -208,7 +208,11 @@ public:
 
     m_subscriber->waitForUnreadMessage();
     lock();
-    while (m_subscriber->takeNextData(static_cast<void *>(&m_data), &m_info)) {
+    std::uint64_t num_taken = 0;
+    while (may_take_more(num_taken) &&
+      m_subscriber->takeNextData(static_cast<void *>(&m_data), &m_info))
+    {
+      ++num_taken;
       if (m_info.sampleKind == eprosima::fastrtps::rtps::ChangeKind_t::ALIVE) {
         if (m_prev_timestamp >= m_data.time()) {
           throw std::runtime_error(
@@ -232,6 +236,7 @@ public:
         }
       }
     }
+    add_samples_per_wakeup_to_statistics(num_taken);
     unlock();
   }
 
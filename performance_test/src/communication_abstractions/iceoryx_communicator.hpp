@@ -15,20 +15,36 @@
 #ifndef COMMUNICATION_ABSTRACTIONS__ICEORYX_COMMUNICATOR_HPP_
 #define COMMUNICATION_ABSTRACTIONS__ICEORYX_COMMUNICATOR_HPP_
 
+#include <iceoryx_posh/mepoo/chunk_header.hpp>
+#include <iceoryx_posh/popo/listener.hpp>
 #include <iceoryx_posh/popo/publisher.hpp>
 #include <iceoryx_posh/popo/subscriber.hpp>
+#include <iceoryx_posh/popo/untyped_publisher.hpp>
+#include <iceoryx_posh/popo/untyped_subscriber.hpp>
 
-#include <string>
+#include <chrono>
+#include <cstring>
+#include <iostream>
 #include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "communicator.hpp"
 #include "resource_manager.hpp"
+#include "sample_header.hpp"
 
 namespace performance_test
 {
 /**
  * \brief The plugin for iceoryx.
  * \tparam Msg The msg type to use.
+ *
+ * Messages with a fixed size are transferred with the typed publisher and subscriber. Messages
+ * with a bounded or unbounded sequence or an unbounded string are transferred with the untyped
+ * API instead: every chunk holds a SampleHeader followed by the payload bytes. The payload size
+ * is the capacity of a bounded sequence, and the configured unbounded message size otherwise.
  */
 template<class Msg>
 class IceoryxCommunicator : public Communicator
@@ -39,7 +55,8 @@ public:
 
   /// Constructor which takes a reference \param lock to the lock to use.
   explicit IceoryxCommunicator(SpinLock & lock)
-  : Communicator(lock)
+  : Communicator(lock),
+    m_payload_size(sample_payload_size<DataType>(m_ec))
   {
   }
 
@@ -53,13 +70,15 @@ public:
    */
   void publish(std::int64_t time)
   {
+    if (!s_fixed_size) {
+      publish_untyped(time);
+      return;
+    }
+
     if (m_publisher == nullptr) {
       ResourceManager::get().init_iceoryx_runtime();
-      iox::capro::IdString_t iox_pub_service{iox::cxx::TruncateToCapacity, Msg::msg_name()};
-      iox::capro::IdString_t iox_pub_instance{iox::cxx::TruncateToCapacity, m_ec.topic_name()};
-      iox::capro::IdString_t iox_pub_event{"Object"};
       m_publisher = std::unique_ptr<iox::popo::Publisher<DataType>>(
-        new iox::popo::Publisher<DataType>({iox_pub_service, iox_pub_instance, iox_pub_event}));
+        new iox::popo::Publisher<DataType>(service_description()));
     }
 
     if (m_ec.is_zero_copy_transfer()) {
@@ -100,58 +119,42 @@ public:
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics
        accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the thread of an iceoryx listener
+   * instead and this function only sleeps.
    */
   void update_subscription()
   {
-    if (m_subscriber == nullptr) {
+    if (m_subscriber == nullptr && m_untyped_subscriber == nullptr) {
       ResourceManager::get().init_iceoryx_runtime();
-      iox::capro::IdString_t iox_sub_service{iox::cxx::TruncateToCapacity, Msg::msg_name()};
-      iox::capro::IdString_t iox_sub_instance{iox::cxx::TruncateToCapacity, m_ec.topic_name()};
-      iox::capro::IdString_t iox_sub_event{"Object"};
       iox::popo::SubscriberOptions subscriberOptions;
       subscriberOptions.queueCapacity = m_ec.qos().history_depth;
-      m_subscriber = std::unique_ptr<iox::popo::Subscriber<DataType>>(
-        new iox::popo::Subscriber<DataType>(
-          {iox_sub_service, iox_sub_instance, iox_sub_event},
-          subscriberOptions));
-      m_waitset = std::unique_ptr<iox::popo::WaitSet<>>(new iox::popo::WaitSet<>());
-      m_waitset->attachEvent(*m_subscriber.get(), iox::popo::SubscriberEvent::DATA_RECEIVED)
-      .or_else(
-        [](
-          auto) {
-          std::cerr << "unable to attach Event DATA_RECEIVED to iceoryx Waitset" << std::endl;
-          std::exit(EXIT_FAILURE);
-        });
+      if (s_fixed_size) {
+        m_subscriber = std::unique_ptr<iox::popo::Subscriber<DataType>>(
+          new iox::popo::Subscriber<DataType>(service_description(), subscriberOptions));
+        attach(*m_subscriber);
+      } else {
+        m_untyped_subscriber = std::unique_ptr<iox::popo::UntypedSubscriber>(
+          new iox::popo::UntypedSubscriber(service_description(), subscriberOptions));
+        attach(*m_untyped_subscriber);
+      }
     }
 
-    if (m_subscriber->getSubscriptionState() == iox::SubscribeState::SUBSCRIBED) {
+    if (m_listener) {
+      rethrow_callback_exception();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
+    const auto subscription_state = s_fixed_size ?
+      m_subscriber->getSubscriptionState() : m_untyped_subscriber->getSubscriptionState();
+    if (subscription_state == iox::SubscribeState::SUBSCRIBED) {
       auto eventVector = m_waitset->timedWait(iox::units::Duration::fromSeconds(15));
       for (auto & event : eventVector) {
-        if (event->doesOriginateFrom(m_subscriber.get())) {
-          lock();
-          while (m_subscriber->hasData()) {
-            m_subscriber->take()
-            .and_then(
-              [this](auto & data) {
-                if (m_prev_timestamp >= data->time) {
-                  throw std::runtime_error(
-                    "Data consistency violated. Received sample with not strictly older timestamp. "
-                    "Time diff: " + std::to_string(data->time - m_prev_timestamp) +
-                    " Data Time: " + std::to_string(data->time));
-                }
-                m_prev_timestamp = data->time;
-                update_lost_samples_counter(data->id);
-                add_latency_to_statistics(data->time);
-                increment_received();
-              })
-            .or_else(
-              [](auto & result) {
-                if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
-                  throw std::runtime_error("Error: received Chunk not available");
-                }
-              });
-          }
-          unlock();
+        if (event->doesOriginateFrom(m_subscriber.get()) ||
+          event->doesOriginateFrom(m_untyped_subscriber.get()))
+        {
+          take_samples();
         }
       }
     } else {
@@ -162,15 +165,184 @@ public:
   /// Returns the data received in bytes.
   std::size_t data_received()
   {
-    return num_received_samples() * sizeof(DataType);
+    if (s_fixed_size) {
+      return num_received_samples() * sizeof(DataType);
+    }
+    return num_received_samples() * (sizeof(SampleHeader) + m_payload_size);
   }
 
 private:
+  /// Whether the message type can be transferred with the typed publisher and subscriber.
+  static constexpr bool s_fixed_size = msg_traits::is_fixed_size<DataType>::value;
+
+  iox::capro::ServiceDescription service_description() const
+  {
+    iox::capro::IdString_t iox_service{iox::cxx::TruncateToCapacity, Msg::msg_name()};
+    iox::capro::IdString_t iox_instance{iox::cxx::TruncateToCapacity, m_ec.topic_name()};
+    iox::capro::IdString_t iox_event{"Object"};
+    return {iox_service, iox_instance, iox_event};
+  }
+
+  /// Attaches the subscriber to the listener or the waitset, depending on the delivery mode.
+  template<class Subscriber>
+  void attach(Subscriber & subscriber)
+  {
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      m_listener = std::unique_ptr<iox::popo::Listener>(new iox::popo::Listener());
+      m_listener->attachEvent(
+        subscriber, iox::popo::SubscriberEvent::DATA_RECEIVED,
+        iox::popo::createEventCallback(on_data_received<Subscriber>, *this))
+      .or_else(
+        [](auto) {
+          std::cerr << "unable to attach Event DATA_RECEIVED to iceoryx Listener" << std::endl;
+          std::exit(EXIT_FAILURE);
+        });
+    } else {
+      m_waitset = std::unique_ptr<iox::popo::WaitSet<>>(new iox::popo::WaitSet<>());
+      m_waitset->attachEvent(subscriber, iox::popo::SubscriberEvent::DATA_RECEIVED)
+      .or_else(
+        [](
+          auto) {
+          std::cerr << "unable to attach Event DATA_RECEIVED to iceoryx Waitset" << std::endl;
+          std::exit(EXIT_FAILURE);
+        });
+    }
+  }
+
+  /**
+   * \brief Called by the iceoryx listener thread when the subscriber received samples.
+   *
+   * The listener is not notified again for the samples left after the maximum number of samples
+   * per take, so they are taken in further batches until the subscriber is empty.
+   */
+  template<class Subscriber>
+  static void on_data_received(Subscriber * const, IceoryxCommunicator * const self)
+  {
+    try {
+      while (self->take_samples()) {}
+    } catch (...) {
+      self->store_callback_exception();
+    }
+  }
+
+  /**
+   * \brief Takes the received samples and updates the statistics.
+   * \returns Returns whether the maximum number of samples per take was reached.
+   */
+  bool take_samples()
+  {
+    if (m_ec.iceoryx_introspection() &&
+      (s_fixed_size ? m_subscriber->hasMissedData() : m_untyped_subscriber->hasMissedData()))
+    {
+      ResourceManager::get().count_iceoryx_queue_overflow();
+    }
+    lock();
+    std::uint64_t num_taken = 0;
+    if (s_fixed_size) {
+      while (may_take_more(num_taken) && m_subscriber->hasData()) {
+        m_subscriber->take()
+        .and_then(
+          [this, &num_taken](auto & data) {
+            ++num_taken;
+            // The typed samples have no SampleHeader, so one is filled from the sample.
+            handle_sample({data->time, data->id, m_payload_size}, m_payload_size);
+          })
+        .or_else(
+          [](auto & result) {
+            if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+              throw std::runtime_error("Error: received Chunk not available");
+            }
+          });
+      }
+    } else {
+      while (may_take_more(num_taken) && m_untyped_subscriber->hasData()) {
+        m_untyped_subscriber->take()
+        .and_then(
+          [this, &num_taken](const void * user_payload) {
+            ++num_taken;
+            const auto & header = *static_cast<const SampleHeader *>(user_payload);
+            const auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
+            if (chunk_header->userPayloadSize != sizeof(SampleHeader) + header.size) {
+              throw std::runtime_error(
+                "Data consistency violated. The payload size of the chunk does not match the "
+                "size in the sample header.");
+            }
+            handle_sample(header, m_payload_size);
+            m_untyped_subscriber->release(user_payload);
+          })
+        .or_else(
+          [](auto & result) {
+            if (result != iox::popo::ChunkReceiveResult::NO_CHUNK_AVAILABLE) {
+              throw std::runtime_error("Error: received Chunk not available");
+            }
+          });
+      }
+    }
+    add_samples_per_wakeup_to_statistics(num_taken);
+    unlock();
+    return !may_take_more(num_taken);
+  }
+
+  /**
+   * \brief Publishes a chunk with a SampleHeader followed by the payload through the untyped API.
+   *
+   * Without zero copy transfer the payload is copied into the chunk, like the typed path copies
+   * the whole sample. With zero copy transfer only the header is written.
+   */
+  void publish_untyped(std::int64_t time)
+  {
+    if (m_untyped_publisher == nullptr) {
+      ResourceManager::get().init_iceoryx_runtime();
+      m_untyped_publisher = std::unique_ptr<iox::popo::UntypedPublisher>(
+        new iox::popo::UntypedPublisher(service_description()));
+      m_payload.resize(m_payload_size);
+    }
+
+    const auto user_payload_size = static_cast<std::uint32_t>(
+      sizeof(SampleHeader) + m_payload.size());
+    m_untyped_publisher->loan(user_payload_size, alignof(SampleHeader))
+    .and_then(
+      [&](auto & user_payload) {
+        auto header = new (user_payload) SampleHeader;
+        init_header(*header, time, m_payload.size());
+        if (!m_ec.is_zero_copy_transfer()) {
+          std::memcpy(header + 1, m_payload.data(), m_payload.size());
+        }
+        record_chunk(user_payload);
+        m_untyped_publisher->publish(user_payload);
+      })
+    .or_else(
+      [](auto &) {
+        throw std::runtime_error("Failed to loan a chunk");
+      });
+  }
+
+  /**
+   * \brief Records the size of the mempool chunk which iceoryx selected for the payload.
+   *
+   * RouDi hands out a chunk from the smallest mempool which fits the chunk header and the
+   * payload. The bytes left over in that chunk are unused, so a large share means that the
+   * mempool configuration does not fit the message size.
+   */
+  static void record_chunk(const void * user_payload)
+  {
+    const auto chunk_header = iox::mepoo::ChunkHeader::fromUserPayload(user_payload);
+    ResourceManager::get().record_iceoryx_chunk(
+      sizeof(iox::mepoo::ChunkHeader) + chunk_header->userPayloadSize, chunk_header->chunkSize);
+  }
+
   std::unique_ptr<iox::popo::Publisher<DataType>> m_publisher;
   std::unique_ptr<iox::popo::Subscriber<DataType>> m_subscriber;
+  std::unique_ptr<iox::popo::UntypedPublisher> m_untyped_publisher;
+  std::unique_ptr<iox::popo::UntypedSubscriber> m_untyped_subscriber;
   std::unique_ptr<iox::popo::WaitSet<>> m_waitset;
+  /// Declared after the subscribers, so the listener thread stops before they are gone.
+  std::unique_ptr<iox::popo::Listener> m_listener;
 
   DataType m_data;
+  std::vector<std::uint8_t> m_payload;
+  /// The number of payload bytes sent after the SampleHeader, or the size of a typed sample.
+  const std::size_t m_payload_size;
 };
 
 }  // namespace performance_test
@@ -0,0 +1,151 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__ICEORYX_INTROSPECTION_HPP_
+#define COMMUNICATION_ABSTRACTIONS__ICEORYX_INTROSPECTION_HPP_
+
+#include <iceoryx_posh/popo/subscriber.hpp>
+#include <iceoryx_posh/roudi/introspection_types.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace performance_test
+{
+
+/// The iceoryx resource usage during one experiment interval.
+struct IceoryxIntrospectionInfo
+{
+  /// The highest share of used chunks of any mempool, in percent.
+  float mempool_max_usage = 0.0F;
+  /// The lowest number of free chunks any mempool had since RouDi started.
+  uint32_t mempool_min_free_chunks = 0;
+  /// The highest number of queued samples of any subscriber port of this process.
+  uint64_t queue_max_fill = 0;
+  /// The queue capacity of the subscriber port with the highest fill.
+  uint64_t queue_capacity = 0;
+  /// The number of takes which found that samples were dropped from a full subscriber queue.
+  uint64_t queue_overflows = 0;
+  /// The size of the mempool chunks which the untyped publisher loaned, in bytes.
+  uint64_t chunk_size = 0;
+  /// The bytes of each of those chunks which neither the chunk header nor the payload use.
+  uint64_t chunk_unused = 0;
+};
+
+/**
+ * \brief Collects the mempool and subscriber port introspection which RouDi publishes.
+ *
+ * RouDi publishes the introspection topics periodically. Each call to sample() takes what was
+ * published since the previous call and keeps the latest values if nothing new arrived.
+ */
+class IceoryxIntrospection
+{
+public:
+  /// Constructor which takes the \param runtime_name of this process to select its ports.
+  explicit IceoryxIntrospection(const std::string & runtime_name)
+  : m_runtime_name(iox::cxx::TruncateToCapacity, runtime_name),
+    m_mempool_subscriber(iox::roudi::IntrospectionMempoolService, options()),
+    m_port_subscriber(iox::roudi::IntrospectionPortService, options()),
+    m_port_data_subscriber(iox::roudi::IntrospectionSubscriberPortChangingDataService, options())
+  {
+  }
+
+  /// Counts that a subscriber found samples dropped from its full queue. Thread-safe.
+  void count_queue_overflow()
+  {
+    ++m_queue_overflows;
+  }
+
+  /// Returns the latest introspection values and the queue overflows since the previous call.
+  IceoryxIntrospectionInfo sample()
+  {
+    while (m_mempool_subscriber.hasData()) {
+      m_mempool_subscriber.take().and_then(
+        [this](auto & segments) {
+          float max_usage = 0.0F;
+          uint32_t min_free_chunks = std::numeric_limits<uint32_t>::max();
+          for (const auto & segment : *segments) {
+            for (const auto & mempool : segment.m_mempoolInfo) {
+              if (mempool.m_numChunks == 0) {
+                continue;
+              }
+              max_usage = std::max(
+                max_usage, 100.0F * static_cast<float>(mempool.m_usedChunks) /
+                static_cast<float>(mempool.m_numChunks));
+              min_free_chunks = std::min(min_free_chunks, mempool.m_minFreeChunks);
+            }
+          }
+          m_info.mempool_max_usage = max_usage;
+          m_info.mempool_min_free_chunks =
+            min_free_chunks == std::numeric_limits<uint32_t>::max() ? 0 : min_free_chunks;
+        });
+    }
+
+    // The subscriber port data is sent in the order of the subscriber list of the port topic.
+    while (m_port_subscriber.hasData()) {
+      m_port_subscriber.take().and_then(
+        [this](auto & ports) {
+          m_own_subscriber_ports.clear();
+          for (const auto & port : ports->m_subscriberList) {
+            m_own_subscriber_ports.push_back(port.m_name == m_runtime_name);
+          }
+        });
+    }
+
+    while (m_port_data_subscriber.hasData()) {
+      m_port_data_subscriber.take().and_then(
+        [this](auto & port_data) {
+          m_info.queue_max_fill = 0;
+          m_info.queue_capacity = 0;
+          const auto & list = port_data->subscriberPortChangingDataList;
+          for (std::size_t i = 0; i < list.size() && i < m_own_subscriber_ports.size(); ++i) {
+            if (m_own_subscriber_ports[i] && list[i].fifoSize >= m_info.queue_max_fill) {
+              m_info.queue_max_fill = list[i].fifoSize;
+              m_info.queue_capacity = list[i].fifoCapacity;
+            }
+          }
+        });
+    }
+
+    IceoryxIntrospectionInfo info = m_info;
+    info.queue_overflows = m_queue_overflows.exchange(0);
+    return info;
+  }
+
+private:
+  static iox::popo::SubscriberOptions options()
+  {
+    iox::popo::SubscriberOptions subscriber_options;
+    subscriber_options.queueCapacity = 1U;
+    subscriber_options.historyRequest = 1U;
+    return subscriber_options;
+  }
+
+  const iox::RuntimeName_t m_runtime_name;
+  iox::popo::Subscriber<iox::roudi::MemPoolIntrospectionInfoContainer> m_mempool_subscriber;
+  iox::popo::Subscriber<iox::roudi::PortIntrospectionFieldTopic> m_port_subscriber;
+  iox::popo::Subscriber<iox::roudi::SubscriberPortChangingIntrospectionFieldTopic>
+  m_port_data_subscriber;
+  std::vector<bool> m_own_subscriber_ports;
+  IceoryxIntrospectionInfo m_info;
+  std::atomic<uint64_t> m_queue_overflows{0};
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__ICEORYX_INTROSPECTION_HPP_
@@ -0,0 +1,209 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_HPP_
+#define COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace performance_test
+{
+
+/**
+ * \brief A bounded lock-free queue for a single producer thread and a single consumer thread.
+ * \tparam T The element type. All elements are constructed up front and reused.
+ *
+ * The producer writes the element returned by back() and then calls push(). The consumer reads
+ * the element returned by front() and then calls pop().
+ */
+template<class T>
+class SpscQueue
+{
+public:
+  /// Constructor which takes the \param capacity of the queue and the \param prototype element.
+  SpscQueue(const std::size_t capacity, const T & prototype)
+  : m_elements(capacity + 1, prototype)
+  {
+  }
+
+  /// Returns the element to write next, or nullptr if the queue is full. Producer only.
+  T * back()
+  {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (next(tail) == m_head.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &m_elements[tail];
+  }
+
+  /// Makes the element returned by back() available to the consumer. Producer only.
+  void push()
+  {
+    m_tail.store(next(m_tail.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  /// Returns the oldest element, or nullptr if the queue is empty. Consumer only.
+  T * front()
+  {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &m_elements[head];
+  }
+
+  /// Returns the element returned by front() to the producer. Consumer only.
+  void pop()
+  {
+    m_head.store(next(m_head.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  /// Returns whether the queue is empty. Consumer only.
+  bool empty() const
+  {
+    return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire);
+  }
+
+private:
+  std::size_t next(const std::size_t index) const
+  {
+    return index + 1 == m_elements.size() ? 0 : index + 1;
+  }
+
+  std::vector<T> m_elements;
+  alignas(64) std::atomic<std::size_t> m_head{0};
+  alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+/// A sample which is passed between the threads: a SampleHeader followed by the payload bytes.
+using IntraQueueSample = std::vector<std::uint8_t>;
+
+/**
+ * \brief The queues of a single subscriber of an intra queue topic.
+ *
+ * Depending on the transfer mode, the publisher either copies the sample into the copy queue, or
+ * passes a shared pointer to it through the pointer queue. The subscriber sleeps on a condition
+ * variable while both are empty, and the publisher only notifies it if it is sleeping.
+ */
+class IntraQueueSubscription
+{
+public:
+  /**
+   * \brief Constructor.
+   * \param copy_capacity The capacity of the copy queue.
+   * \param pointer_capacity The capacity of the pointer queue.
+   * \param sample_size The size of a sample in bytes.
+   */
+  IntraQueueSubscription(
+    const std::size_t copy_capacity,
+    const std::size_t pointer_capacity,
+    const std::size_t sample_size)
+  : copies(copy_capacity, IntraQueueSample(sample_size)),
+    pointers(pointer_capacity, nullptr)
+  {
+  }
+
+  /// Wakes the subscriber if it is waiting. Called by the publisher after each push.
+  void notify()
+  {
+    // Pairs with the fence in wait_for(), so either the publisher sees the sleeping flag or the
+    // subscriber sees the pushed sample.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_condition.notify_one();
+    }
+  }
+
+  /**
+   * \brief Waits until a sample is queued or the \param timeout expires.
+   * \returns Returns whether a sample is queued.
+   */
+  bool wait_for(const std::chrono::nanoseconds timeout)
+  {
+    if (!empty()) {
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = m_condition.wait_for(lock, timeout, [this] {return !empty();});
+    m_sleeping.store(false, std::memory_order_relaxed);
+    return ready;
+  }
+
+  /// The queue for the copy transfer mode.
+  SpscQueue<IntraQueueSample> copies;
+  /// The queue for the shared pointer transfer mode.
+  SpscQueue<std::shared_ptr<const IntraQueueSample>> pointers;
+
+private:
+  bool empty() const
+  {
+    return copies.empty() && pointers.empty();
+  }
+
+  std::atomic<bool> m_sleeping{false};
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+};
+
+/**
+ * \brief The subscriptions of an intra queue topic.
+ *
+ * Subscribers may join while the publisher is running. The publisher keeps a snapshot of the
+ * subscriptions and only takes the lock to renew it after a subscriber joined.
+ */
+class IntraQueueTopic
+{
+public:
+  /// Adds the \param subscription to the topic.
+  void add(const std::shared_ptr<IntraQueueSubscription> & subscription)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_subscriptions.push_back(subscription);
+    m_version.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * \brief Updates a snapshot of the subscriptions if a subscriber joined since it was taken.
+   * \param snapshot The snapshot to update.
+   * \param version The version of the snapshot, which is updated as well.
+   */
+  void update_snapshot(
+    std::vector<std::shared_ptr<IntraQueueSubscription>> & snapshot,
+    std::uint64_t & version) const
+  {
+    if (m_version.load(std::memory_order_acquire) != version) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      snapshot = m_subscriptions;
+      version = m_version.load(std::memory_order_relaxed);
+    }
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<std::shared_ptr<IntraQueueSubscription>> m_subscriptions;
+  std::atomic<std::uint64_t> m_version{0};
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_HPP_
@@ -0,0 +1,217 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_COMMUNICATOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "baseline_communicator.hpp"
+#include "intra_queue.hpp"
+#include "resource_manager.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief The baseline plugin for passing samples between threads of the same process.
+ * \tparam Msg The msg type to use.
+ *
+ * Every subscriber has its own bounded lock-free queue, into which the publisher puts each
+ * sample, so every subscriber receives every sample. If the queue of a subscriber is full, the
+ * sample is dropped for this subscriber and counted as lost.
+ *
+ * With the copy transfer mode, the publisher copies the sample into each queue. With the shared
+ * pointer transfer mode, the publisher writes the sample once into a buffer from a preallocated
+ * pool and passes a shared pointer to it to each queue. The buffer returns to the pool when the
+ * last subscriber released it.
+ */
+template<class Msg>
+class IntraQueueCommunicator : public BaselineCommunicator<Msg>
+{
+  using Base = BaselineCommunicator<Msg>;
+  using SampleHeader = typename Base::SampleHeader;
+
+public:
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit IntraQueueCommunicator(SpinLock & lock)
+  : Base(lock),
+    m_topic(ResourceManager::get().intra_queue_topic(
+        Msg::msg_name() + "/" + this->m_ec.topic_name())),
+    m_sample_size(sizeof(SampleHeader) + this->payload_size())
+  {
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   *  The first time this function is called it also creates the buffer pool.
+   *  Further it updates all internal counters while running.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    if (!m_publisher_initialized) {
+      m_publisher_initialized = true;
+      m_payload.resize(this->payload_size());
+      if (shared_transfer()) {
+        // Enough buffers so that one is free even if every queue is full and every subscriber
+        // still holds the sample it took last.
+        const std::size_t depth = this->m_ec.intra_queue_depth();
+        m_pool.resize(this->m_ec.number_of_subscribers() * (depth + 1) + 1);
+        for (auto & buffer : m_pool) {
+          buffer = std::make_shared<IntraQueueSample>(m_sample_size);
+        }
+      }
+    }
+    m_topic->update_snapshot(m_subscriptions, m_subscriptions_version);
+
+    SampleHeader header;
+    this->init_header(header, time);
+    if (shared_transfer()) {
+      std::shared_ptr<IntraQueueSample> & buffer = free_buffer();
+      write_sample(header, *buffer);
+      for (const auto & subscription : m_subscriptions) {
+        auto slot = subscription->pointers.back();
+        if (slot != nullptr) {
+          *slot = buffer;
+          subscription->pointers.push();
+          subscription->notify();
+        }
+      }
+    } else {
+      for (const auto & subscription : m_subscriptions) {
+        auto slot = subscription->copies.back();
+        if (slot != nullptr) {
+          write_sample(header, *slot);
+          subscription->copies.push();
+          subscription->notify();
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Reads received data.
+   *
+   * The first time this function is called it also joins the topic. A subscriber receives the
+   * samples published after it joined.
+   * In detail this function:
+   * * Waits for queued samples.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+       accordingly.
+   */
+  void update_subscription()
+  {
+    if (!m_subscription) {
+      const std::size_t depth = this->m_ec.intra_queue_depth();
+      m_subscription = std::make_shared<IntraQueueSubscription>(
+        shared_transfer() ? 0 : depth, shared_transfer() ? depth : 0, m_sample_size);
+      m_topic->add(m_subscription);
+    }
+
+    if (!m_subscription->wait_for(std::chrono::milliseconds(100))) {
+      return;
+    }
+
+    std::uint64_t num_taken = 0;
+    this->lock();
+    if (shared_transfer()) {
+      while (this->may_take_more(num_taken)) {
+        auto sample = m_subscription->pointers.front();
+        if (sample == nullptr) {
+          break;
+        }
+        ++num_taken;
+        this->handle_sample(read_header(**sample));
+        // Releases the ownership, so the buffer can return to the pool.
+        sample->reset();
+        m_subscription->pointers.pop();
+      }
+    } else {
+      while (this->may_take_more(num_taken)) {
+        auto sample = m_subscription->copies.front();
+        if (sample == nullptr) {
+          break;
+        }
+        ++num_taken;
+        this->handle_sample(read_header(*sample));
+        m_subscription->copies.pop();
+      }
+    }
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+  }
+
+private:
+  bool shared_transfer() const
+  {
+    return this->m_ec.intra_queue_transfer() ==
+           ExperimentConfiguration::IntraQueueTransfer::SHARED_PTR;
+  }
+
+  /// Returns a buffer from the pool which no subscriber holds anymore.
+  std::shared_ptr<IntraQueueSample> & free_buffer()
+  {
+    for (std::size_t i = 0; i < m_pool.size(); ++i) {
+      m_next_buffer = m_next_buffer + 1 == m_pool.size() ? 0 : m_next_buffer + 1;
+      if (m_pool[m_next_buffer].use_count() == 1) {
+        // The subscribers release the buffer with a release operation.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_pool[m_next_buffer];
+      }
+    }
+    // More subscribers joined than configured, so the pool has to grow.
+    m_pool.push_back(std::make_shared<IntraQueueSample>(m_sample_size));
+    m_next_buffer = m_pool.size() - 1;
+    return m_pool.back();
+  }
+
+  void write_sample(const SampleHeader & header, IntraQueueSample & sample) const
+  {
+    std::memcpy(sample.data(), &header, sizeof(SampleHeader));
+    std::memcpy(sample.data() + sizeof(SampleHeader), m_payload.data(), m_payload.size());
+  }
+
+  static SampleHeader read_header(const IntraQueueSample & sample)
+  {
+    SampleHeader header;
+    std::memcpy(&header, sample.data(), sizeof(SampleHeader));
+    return header;
+  }
+
+  const std::shared_ptr<IntraQueueTopic> m_topic;
+  const std::size_t m_sample_size;
+
+  bool m_publisher_initialized = false;
+  std::vector<std::uint8_t> m_payload;
+  std::vector<std::shared_ptr<IntraQueueSample>> m_pool;
+  std::size_t m_next_buffer = 0;
+  std::vector<std::shared_ptr<IntraQueueSubscription>> m_subscriptions;
+  std::uint64_t m_subscriptions_version = 0;
+
+  std::shared_ptr<IntraQueueSubscription> m_subscription;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__INTRA_QUEUE_COMMUNICATOR_HPP_
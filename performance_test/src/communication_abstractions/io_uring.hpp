@@ -0,0 +1,205 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__IO_URING_HPP_
+#define COMMUNICATION_ABSTRACTIONS__IO_URING_HPP_
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+
+namespace performance_test
+{
+
+/**
+ * \brief A minimal io_uring instance, which uses the system calls directly.
+ *
+ * Submission queue entries are taken with get_sqe() and passed to the kernel with enter(), which
+ * can also wait for completions. The completions are consumed with for_each_cqe().
+ * The instance must only be used by a single thread.
+ */
+class IoUring
+{
+public:
+  /// Constructor which takes the number of submission queue \param entries.
+  explicit IoUring(const std::uint32_t entries)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0) {
+      throw std::runtime_error(std::string("Could not set up io_uring: ") + strerror(errno));
+    }
+    if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+      close(m_fd);
+      throw std::runtime_error("io_uring requires Linux 5.11 or newer");
+    }
+
+    m_sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    m_sq = map(m_sq_size, IORING_OFF_SQ_RING);
+    m_cq = map(m_cq_size, IORING_OFF_CQ_RING);
+    m_sqes = static_cast<io_uring_sqe *>(map(m_sqes_size, IORING_OFF_SQES));
+
+    auto sq = static_cast<std::uint8_t *>(m_sq);
+    m_sq_head = reinterpret_cast<std::atomic<std::uint32_t> *>(sq + params.sq_off.head);
+    m_sq_tail = reinterpret_cast<std::atomic<std::uint32_t> *>(sq + params.sq_off.tail);
+    m_sq_mask = *reinterpret_cast<std::uint32_t *>(sq + params.sq_off.ring_mask);
+    m_sq_entries = params.sq_entries;
+    m_sq_array = reinterpret_cast<std::uint32_t *>(sq + params.sq_off.array);
+    auto cq = static_cast<std::uint8_t *>(m_cq);
+    m_cq_head = reinterpret_cast<std::atomic<std::uint32_t> *>(cq + params.cq_off.head);
+    m_cq_tail = reinterpret_cast<std::atomic<std::uint32_t> *>(cq + params.cq_off.tail);
+    m_cq_mask = *reinterpret_cast<std::uint32_t *>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    m_sq_local_tail = m_sq_tail->load(std::memory_order_relaxed);
+  }
+
+  IoUring & operator=(const IoUring &) = delete;
+  IoUring(const IoUring &) = delete;
+
+  ~IoUring()
+  {
+    munmap(m_sqes, m_sqes_size);
+    munmap(m_cq, m_cq_size);
+    munmap(m_sq, m_sq_size);
+    close(m_fd);
+  }
+
+  /// Returns a cleared submission queue entry, or nullptr if the submission queue is full.
+  io_uring_sqe * get_sqe()
+  {
+    if (m_sq_local_tail - m_sq_head->load(std::memory_order_acquire) >= m_sq_entries) {
+      return nullptr;
+    }
+    const std::uint32_t index = m_sq_local_tail & m_sq_mask;
+    m_sq_array[index] = index;
+    ++m_sq_local_tail;
+    io_uring_sqe * sqe = &m_sqes[index];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+  }
+
+  /**
+   * \brief Submits the entries taken since the previous call and waits for completions.
+   * \param min_complete The number of completions to wait for.
+   * \param timeout The maximum time to wait, or a negative value to wait without a limit.
+   * \returns Returns false if the wait timed out or was interrupted.
+   */
+  bool enter(const std::uint32_t min_complete, const std::chrono::nanoseconds timeout)
+  {
+    const std::uint32_t to_submit = m_sq_local_tail - m_sq_tail->load(std::memory_order_relaxed);
+    m_sq_tail->store(m_sq_local_tail, std::memory_order_release);
+
+    __kernel_timespec timespec{};
+    io_uring_getevents_arg arg{};
+    if (timeout.count() >= 0) {
+      timespec.tv_sec = timeout.count() / 1000000000;
+      timespec.tv_nsec = timeout.count() % 1000000000;
+      arg.ts = reinterpret_cast<std::uint64_t>(&timespec);
+    }
+    const std::uint32_t flags =
+      (min_complete > 0 ? IORING_ENTER_GETEVENTS : 0U) | IORING_ENTER_EXT_ARG;
+    const long result = syscall(  // NOLINT
+      __NR_io_uring_enter, m_fd, to_submit, min_complete, flags, &arg, sizeof(arg));
+    if (result < 0) {
+      if (errno == ETIME || errno == EINTR) {
+        return false;
+      }
+      throw std::runtime_error(std::string("io_uring_enter failed: ") + strerror(errno));
+    }
+    return true;
+  }
+
+  /// Calls \param callback for every available completion queue entry and consumes them.
+  template<typename Callback>
+  std::uint32_t for_each_cqe(Callback && callback)
+  {
+    std::uint32_t head = m_cq_head->load(std::memory_order_relaxed);
+    const std::uint32_t tail = m_cq_tail->load(std::memory_order_acquire);
+    const std::uint32_t count = tail - head;
+    for (; head != tail; ++head) {
+      callback(m_cqes[head & m_cq_mask]);
+    }
+    m_cq_head->store(head, std::memory_order_release);
+    return count;
+  }
+
+  /// Returns whether completion queue entries are available.
+  bool has_cqe() const
+  {
+    return m_cq_head->load(std::memory_order_relaxed) !=
+           m_cq_tail->load(std::memory_order_acquire);
+  }
+
+  /// Registers the buffer \param iov, which WRITE_FIXED and READ_FIXED then refer to as index 0.
+  void register_buffer(const iovec & iov)
+  {
+    do_register(IORING_REGISTER_BUFFERS, &iov, 1);
+  }
+
+private:
+  void * map(const std::size_t size, const off_t offset) const
+  {
+    void * memory = mmap(
+      nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+    if (memory == MAP_FAILED) {
+      throw std::runtime_error(std::string("Could not map the io_uring: ") + strerror(errno));
+    }
+    return memory;
+  }
+
+  void do_register(const unsigned opcode, const void * arg, const unsigned count)
+  {
+    if (syscall(__NR_io_uring_register, m_fd, opcode, arg, count) < 0) {
+      throw std::runtime_error(
+              "io_uring registration " + std::to_string(opcode) + " failed: " +
+              strerror(errno));
+    }
+  }
+
+  int m_fd = -1;
+  void * m_sq = nullptr;
+  void * m_cq = nullptr;
+  io_uring_sqe * m_sqes = nullptr;
+  std::size_t m_sq_size = 0;
+  std::size_t m_cq_size = 0;
+  std::size_t m_sqes_size = 0;
+  std::atomic<std::uint32_t> * m_sq_head = nullptr;
+  std::atomic<std::uint32_t> * m_sq_tail = nullptr;
+  std::uint32_t m_sq_mask = 0;
+  std::uint32_t m_sq_entries = 0;
+  std::uint32_t * m_sq_array = nullptr;
+  std::uint32_t m_sq_local_tail = 0;
+  std::atomic<std::uint32_t> * m_cq_head = nullptr;
+  std::atomic<std::uint32_t> * m_cq_tail = nullptr;
+  std::uint32_t m_cq_mask = 0;
+  io_uring_cqe * m_cqes = nullptr;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__IO_URING_HPP_
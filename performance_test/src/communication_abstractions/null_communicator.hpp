@@ -0,0 +1,101 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__NULL_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__NULL_COMMUNICATOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "baseline_communicator.hpp"
+#include "null_mailbox.hpp"
+#include "resource_manager.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief The plugin which measures the overhead of perf_test itself.
+ * \tparam Msg The msg type to use.
+ *
+ * The publisher hands the timestamp and id of each sample to the paired subscriber through a
+ * single-slot mailbox, without a payload. What remains of the latency and the CPU usage is the
+ * cost of the data runners, the communicator bookkeeping, the lock and the statistics.
+ */
+template<class Msg>
+class NullCommunicator : public BaselineCommunicator<Msg>
+{
+  using Base = BaselineCommunicator<Msg>;
+  using SampleHeader = typename Base::SampleHeader;
+
+public:
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit NullCommunicator(SpinLock & lock)
+  : Base(lock),
+    m_mailbox(ResourceManager::get().null_mailbox(
+        Msg::msg_name() + "/" + this->m_ec.topic_name()))
+  {
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   * If the subscriber did not take the previous sample yet, the sample is dropped, and the
+   * subscriber counts it as lost.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    SampleHeader header;
+    this->init_header(header, time);
+    m_mailbox->put(header.time, header.id);
+  }
+
+  /**
+   * \brief Reads received data.
+   *
+   * In detail this function:
+   * * Polls the mailbox for a sample.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+       accordingly.
+   */
+  void update_subscription()
+  {
+    if (!m_mailbox->wait_for(std::chrono::milliseconds(100))) {
+      return;
+    }
+
+    SampleHeader header;
+    header.size = this->payload_size();
+    if (!m_mailbox->take(header.time, header.id)) {
+      return;
+    }
+    this->lock();
+    this->handle_sample(header);
+    this->add_samples_per_wakeup_to_statistics(1);
+    this->unlock();
+  }
+
+private:
+  const std::shared_ptr<NullMailbox> m_mailbox;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__NULL_COMMUNICATOR_HPP_
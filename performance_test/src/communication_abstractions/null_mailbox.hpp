@@ -0,0 +1,84 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__NULL_MAILBOX_HPP_
+#define COMMUNICATION_ABSTRACTIONS__NULL_MAILBOX_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace performance_test
+{
+
+/**
+ * \brief A mailbox with a single slot, which passes the timestamp and id of a sample from one
+ * publisher thread to one subscriber thread.
+ *
+ * The publisher drops the sample if the subscriber did not take the previous one yet. The
+ * subscriber polls the slot, so no wakeup mechanism adds to the latency.
+ */
+class NullMailbox
+{
+public:
+  /// Puts the sample into the slot. Returns false if the slot is still full. Publisher only.
+  bool put(const std::int64_t time, const std::uint64_t id)
+  {
+    if (m_full.load(std::memory_order_acquire)) {
+      return false;
+    }
+    m_time = time;
+    m_id = id;
+    m_full.store(true, std::memory_order_release);
+    return true;
+  }
+
+  /// Takes the sample from the slot. Returns false if the slot is empty. Subscriber only.
+  bool take(std::int64_t & time, std::uint64_t & id)
+  {
+    if (!m_full.load(std::memory_order_acquire)) {
+      return false;
+    }
+    time = m_time;
+    id = m_id;
+    m_full.store(false, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Polls the slot until it is full or the \param timeout expires. Subscriber only.
+   * \returns Returns whether the slot is full.
+   */
+  bool wait_for(const std::chrono::nanoseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!m_full.load(std::memory_order_acquire)) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+private:
+  alignas(64) std::atomic<bool> m_full{false};
+  std::int64_t m_time = 0;
+  std::uint64_t m_id = 0;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__NULL_MAILBOX_HPP_
@@ -15,9 +15,14 @@
 #ifndef COMMUNICATION_ABSTRACTIONS__OPENDDS_COMMUNICATOR_HPP_
 #define COMMUNICATION_ABSTRACTIONS__OPENDDS_COMMUNICATOR_HPP_
 
+#include <dds/DCPS/LocalObject.h>
 #include <dds/DCPS/Marked_Default_Qos.h>
 #include <dds/DCPS/WaitSet.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include "communicator.hpp"
 #include "resource_manager.hpp"
 
@@ -149,7 +154,13 @@ public:
     m_typed_datareader(nullptr)
   {
     m_participant = ResourceManager::get().opendds_participant();
-    register_topic();
+  }
+
+  ~OpenDDSCommunicator()
+  {
+    if (!CORBA::is_nil(m_datareader) && !CORBA::is_nil(m_listener.in())) {
+      m_datareader->set_listener(DDS::DataReaderListener::_nil(), OpenDDS::DCPS::NO_STATUS_MASK);
+    }
   }
 
   /**
@@ -171,7 +182,7 @@ public:
       qos_adapter.apply_dw(dw_qos);
 
       m_datawriter = publisher->create_datawriter(
-        m_topic,
+        topic(m_ec.pub_topic_postfix()),
         dw_qos, nullptr, OpenDDS::DCPS::DEFAULT_STATUS_MASK);
       if (CORBA::is_nil(m_datawriter)) {
         throw std::runtime_error("Could not create datawriter");
@@ -203,6 +214,9 @@ public:
    * * Verifies that the data arrived in the right order, chronologically and also consistent with the publishing order.
    * * Counts received and lost samples.
    * * Calculates the latency of the samples received and updates the statistics accordingly.
+   *
+   * With the listener delivery mode, the samples are taken on the OpenDDS thread which invokes
+   * the data available listener instead and this function only sleeps.
    */
 
   void update_subscription()
@@ -217,7 +231,7 @@ public:
 
       /* Only DDS_DATA_AVAILABLE_STATUS supported currently */
       m_datareader = subscriber->create_datareader(
-        m_topic,
+        topic(m_ec.sub_topic_postfix()),
         dr_qos,
         nullptr,
         OpenDDS::DCPS::DEFAULT_STATUS_MASK);
@@ -226,25 +240,82 @@ public:
         throw std::runtime_error("datareader == nullptr");
       }
 
-      m_condition = m_datareader->get_statuscondition();
-      m_condition->set_enabled_statuses(DDS::DATA_AVAILABLE_STATUS);
-      m_waitset.attach_condition(m_condition);
-
       m_typed_datareader = DataReaderType::_narrow(m_datareader);
       if (m_typed_datareader == nullptr) {
         throw std::runtime_error("m_typed_datareader == nullptr");
       }
+
+      if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+        // The listener is set after narrowing, because it can be invoked right away.
+        m_listener = new Listener(*this);
+        if (m_datareader->set_listener(m_listener.in(), DDS::DATA_AVAILABLE_STATUS) !=
+          DDS::RETCODE_OK)
+        {
+          throw std::runtime_error("failed to set the datareader listener");
+        }
+      } else {
+        m_condition = m_datareader->get_statuscondition();
+        m_condition->set_enabled_statuses(DDS::DATA_AVAILABLE_STATUS);
+        m_waitset.attach_condition(m_condition);
+      }
+    }
+
+    if (m_ec.delivery_mode() == ExperimentConfiguration::DeliveryMode::LISTENER) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
     }
 
     DDS::Duration_t wait_timeout = {15, 0};
     m_waitset.wait(m_condition_seq, wait_timeout);
+    take_samples();
+  }
 
+  /// Returns the data received in bytes.
+  std::size_t data_received()
+  {
+    return num_received_samples() * sizeof(DataType);
+  }
+
+private:
+  /// Takes the samples on the thread which OpenDDS invokes the listeners on.
+  class Listener : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener>
+  {
+  public:
+    explicit Listener(OpenDDSCommunicator & communicator)
+    : m_communicator(communicator) {}
+
+    void on_data_available(DDS::DataReader_ptr) override
+    {
+      m_communicator.take_samples();
+    }
+
+    void on_requested_deadline_missed(
+      DDS::DataReader_ptr, const DDS::RequestedDeadlineMissedStatus &) override {}
+    void on_requested_incompatible_qos(
+      DDS::DataReader_ptr, const DDS::RequestedIncompatibleQosStatus &) override {}
+    void on_sample_rejected(DDS::DataReader_ptr, const DDS::SampleRejectedStatus &) override {}
+    void on_liveliness_changed(
+      DDS::DataReader_ptr, const DDS::LivelinessChangedStatus &) override {}
+    void on_subscription_matched(
+      DDS::DataReader_ptr, const DDS::SubscriptionMatchedStatus &) override {}
+    void on_sample_lost(DDS::DataReader_ptr, const DDS::SampleLostStatus &) override {}
+
+  private:
+    OpenDDSCommunicator & m_communicator;
+  };
+
+  /// Takes the available samples, up to the configured maximum per wakeup.
+  void take_samples()
+  {
+    const auto max_samples = m_ec.max_samples_per_take() == 0 ?
+      DDS::LENGTH_UNLIMITED : static_cast<CORBA::Long>(m_ec.max_samples_per_take());
     auto ret = m_typed_datareader->take(
-      m_data_seq, m_sample_info_seq, DDS::LENGTH_UNLIMITED,
+      m_data_seq, m_sample_info_seq, max_samples,
       DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
       DDS::ANY_INSTANCE_STATE);
     if (ret == DDS::RETCODE_OK) {
       lock();
+      add_samples_per_wakeup_to_statistics(m_data_seq.length());
       for (decltype(m_data_seq.length()) j = 0; j < m_data_seq.length(); ++j) {
         const auto & data = m_data_seq[j];
         if (m_sample_info_seq[j].valid_data) {
@@ -257,52 +328,34 @@ public:
                     std::to_string(data.time)
             );
           }
-          m_prev_timestamp = data.time;
-          update_lost_samples_counter(data.id);
-          add_latency_to_statistics(data.time);
-          increment_received();
+          if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
+            unlock();
+            publish(data.time);
+            lock();
+          } else {
+            m_prev_timestamp = data.time;
+            update_lost_samples_counter(data.id);
+            add_latency_to_statistics(data.time);
+            increment_received();
+          }
         }
       }
       unlock();
 
-      if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
-        throw std::runtime_error("Round trip mode is not implemented for OpenDDS!");
-      }
-
       m_typed_datareader->return_loan(
         m_data_seq,
         m_sample_info_seq);
     }
   }
 
-  /// Returns the data received in bytes.
-  std::size_t data_received()
-  {
-    return num_received_samples() * sizeof(DataType);
-  }
-
-private:
-  /// Registers a topic to the participant. It makes sure that each topic is only registered once.
-  void register_topic()
+  /**
+   * \brief Returns the topic with the given postfix. The main and relay sides of a roundtrip use
+   * different postfixes for publishing and subscribing, so each of them gets its own topic.
+   */
+  DDS::Topic_ptr topic(const std::string & postfix)
   {
-    if (CORBA::is_nil(m_topic)) {
-      DDS::ReturnCode_t retcode;
-      retcode = Topic::get_type_support()->register_type(
-        m_participant,
-        Topic::msg_name().c_str());
-      if (retcode != DDS::RETCODE_OK) {
-        throw std::runtime_error("failed to register type");
-      }
-      m_topic = m_participant->create_topic(
-        m_ec.topic_name().c_str(),
-        Topic::msg_name().c_str(),
-        TOPIC_QOS_DEFAULT,
-        nullptr,
-        OpenDDS::DCPS::DEFAULT_STATUS_MASK);
-      if (CORBA::is_nil(m_topic)) {
-        throw std::runtime_error("topic == nullptr");
-      }
-    }
+    return ResourceManager::get().opendds_topic(
+      m_ec.topic_name() + postfix, Topic::get_type_support(), Topic::msg_name());
   }
 
   DDS::DomainParticipant_ptr m_participant;
@@ -319,13 +372,11 @@ private:
 
   DataTypeSeq m_data_seq;
   DDS::SampleInfoSeq m_sample_info_seq;
-  static DDS::Topic_ptr m_topic;
 
   DataType m_data;
-};
 
-template<class Topic>
-DDS::Topic_ptr OpenDDSCommunicator<Topic>::m_topic = nullptr;
+  DDS::DataReaderListener_var m_listener;
+};
 
 }  // namespace performance_test
 
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <atomic>
+#include <utility>
 
 #include "rclcpp_communicator.hpp"
 #include "resource_manager.hpp"
@@ -45,16 +46,32 @@ public:
   void update_subscription() override
   {
     if (!m_subscription) {
-      m_subscription = this->m_node->template create_subscription<DataType>(
-        this->m_ec.topic_name() + this->m_ec.sub_topic_postfix(), this->m_ROS2QOSAdapter,
-        [this](const typename DataType::SharedPtr data) {this->callback(data);});
+      m_subscription = create_subscription();
     }
     m_executor.spin_once(std::chrono::milliseconds(100));
   }
 
+protected:
+  /// Creates the subscription which passes the received data to the callback handler.
+  virtual std::shared_ptr<::rclcpp::SubscriptionBase> create_subscription()
+  {
+    return subscribe<DataType>(
+      [this](const typename DataType::SharedPtr data) {this->callback(data);});
+  }
+
+  /// Creates a subscription of the \tparam T messages on the node of this communicator, which
+  /// passes them to \param callback.
+  template<class T, class Callback>
+  std::shared_ptr<::rclcpp::SubscriptionBase> subscribe(Callback && callback)
+  {
+    return this->m_node->template create_subscription<T>(
+      this->m_ec.topic_name() + this->m_ec.sub_topic_postfix(), this->m_ROS2QOSAdapter,
+      std::forward<Callback>(callback));
+  }
+
 private:
   Executor m_executor;
-  std::shared_ptr<::rclcpp::Subscription<DataType>> m_subscription;
+  std::shared_ptr<::rclcpp::SubscriptionBase> m_subscription;
 };
 
 template<class Msg>
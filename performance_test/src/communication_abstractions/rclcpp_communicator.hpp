@@ -99,29 +99,25 @@ public:
    * \param data The data to publish.
    * \param time The time to fill into the data field.
    */
-  void publish(std::int64_t time)
+  virtual void publish(std::int64_t time)
   {
-    if (!m_publisher) {
-      auto ros2QOSAdapter = m_ROS2QOSAdapter;
-      m_publisher = m_node->create_publisher<DataType>(
-        m_ec.topic_name() + m_ec.pub_topic_postfix(), ros2QOSAdapter);
-    }
+    const auto publisher = this->publisher();
     if (m_ec.is_zero_copy_transfer()) {
-      if (!m_publisher->can_loan_messages()) {
+      if (!publisher->can_loan_messages()) {
         throw std::runtime_error("RMW implementation does not support zero copy!");
       }
-      auto borrowed_message{m_publisher->borrow_loaned_message()};
+      auto borrowed_message{publisher->borrow_loaned_message()};
       lock();
       init_msg(borrowed_message.get(), time);
       increment_sent();  // We increment before publishing so we don't have to lock twice.
       unlock();
-      m_publisher->publish(std::move(borrowed_message));
+      publisher->publish(std::move(borrowed_message));
     } else {
       lock();
       init_msg(m_data, time);
       increment_sent();  // We increment before publishing so we don't have to lock twice.
       unlock();
-      m_publisher->publish(m_data);
+      publisher->publish(m_data);
     }
   }
 
@@ -137,6 +133,20 @@ public:
 protected:
   std::shared_ptr<rclcpp::Node> m_node;
   rclcpp::QoS m_ROS2QOSAdapter;
+  /// The sample which is filled and published when not using loaned messages.
+  DataType m_data;
+
+  /// Returns the publisher, which is created on the first call.
+  std::shared_ptr<::rclcpp::Publisher<DataType>> publisher()
+  {
+    if (!m_publisher) {
+      auto ros2QOSAdapter = m_ROS2QOSAdapter;
+      m_publisher = m_node->create_publisher<DataType>(
+        m_ec.topic_name() + m_ec.pub_topic_postfix(), ros2QOSAdapter);
+    }
+    return m_publisher;
+  }
+
   /**
    * \brief Callback handler which handles the received data.
    *
@@ -158,28 +168,36 @@ protected:
       std::is_same<DataType,
       typename std::remove_cv<typename std::remove_reference<T>::type>::type>::value,
       "Parameter type passed to callback() does not match");
-    if (m_prev_timestamp >= data.time) {
+    on_sample(data.time, data.id);
+  }
+
+  /**
+   * \brief Handles a received sample given only its timestamp and id.
+   *
+   * This allows plugins which receive a type other than DataType to share the sample handling.
+   *
+   * \param time The time the sample was sent.
+   * \param id The id of the sample.
+   */
+  void on_sample(const std::int64_t time, const std::uint64_t id)
+  {
+    if (m_prev_timestamp >= time) {
       throw std::runtime_error(
               "Data consistency violated. Received sample with not strictly older timestamp");
     }
 
     if (m_ec.roundtrip_mode() == ExperimentConfiguration::RoundTripMode::RELAY) {
-      publish(data.time);
+      publish(time);
     } else {
       lock();
-      m_prev_timestamp = data.time;
-      update_lost_samples_counter(data.id);
-      add_latency_to_statistics(data.time);
+      m_prev_timestamp = time;
+      update_lost_samples_counter(id);
+      add_latency_to_statistics(time);
       increment_received();
       unlock();
     }
   }
 
-private:
-  std::shared_ptr<::rclcpp::Publisher<DataType>> m_publisher;
-
-  DataType m_data;
-
   inline
   void init_msg(DataType & msg, std::int64_t time)
   {
@@ -228,6 +246,9 @@ private:
   inline
   std::enable_if_t<!has_unbounded_string<T>::value, void>
   init_unbounded_string(T &) {}
+
+private:
+  std::shared_ptr<::rclcpp::Publisher<DataType>> m_publisher;
 };
 }  // namespace performance_test
 #endif  // COMMUNICATION_ABSTRACTIONS__RCLCPP_COMMUNICATOR_HPP_
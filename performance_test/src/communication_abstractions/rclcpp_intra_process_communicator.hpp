@@ -0,0 +1,106 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__RCLCPP_INTRA_PROCESS_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__RCLCPP_INTRA_PROCESS_COMMUNICATOR_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <utility>
+
+#include "rclcpp_callback_communicator.hpp"
+#include "rclcpp_shared_executor_communicator.hpp"
+
+namespace performance_test
+{
+/**
+ * \brief Communication plugin for ROS 2 using rclcpp intra-process communication.
+ *
+ * The node is created with intra-process communication enabled by the resource manager, so
+ * messages are handed from the publisher to the subscriptions by pointer and never pass through
+ * the RMW implementation. The subscriptions are executed by the \tparam Base communicator, which
+ * either spins its own executor or hosts them on the shared executor.
+ */
+template<class Msg, class Base>
+class RclcppIntraProcessCommunicator : public Base
+{
+public:
+  /// The data type to publish and subscribe to.
+  using DataType = typename Base::DataType;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit RclcppIntraProcessCommunicator(SpinLock & lock)
+  : Base(lock),
+    m_next_msg(std::make_unique<DataType>()) {}
+
+  /**
+   * \brief Publishes a newly allocated message by unique pointer.
+   *
+   * Giving up the ownership of the message allows rclcpp to move it into the subscriptions
+   * instead of copying it. The message for the next sample is allocated after publishing, so
+   * the allocation does not add to the latency.
+   *
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time) override
+  {
+    const auto publisher = this->publisher();
+    this->lock();
+    this->init_msg(*m_next_msg, time);
+    this->increment_sent();  // We increment before publishing so we don't have to lock twice.
+    this->unlock();
+    publisher->publish(std::move(m_next_msg));
+    m_next_msg = std::make_unique<DataType>();
+  }
+
+protected:
+  /**
+   * \brief Creates the subscription with the configured ownership of the received messages.
+   *
+   * A subscription taking a unique pointer receives the published message itself if it is the
+   * only subscription, while subscriptions taking a shared pointer all share a single message.
+   */
+  std::shared_ptr<::rclcpp::SubscriptionBase> create_subscription() override
+  {
+    if (this->m_ec.intra_process_ownership() ==
+      ExperimentConfiguration::IntraProcessOwnership::SHARED)
+    {
+      return this->template subscribe<DataType>(
+        [this](std::shared_ptr<const DataType> data) {this->callback(*data);});
+    }
+    return this->template subscribe<DataType>(
+      [this](std::unique_ptr<DataType> data) {this->callback(*data);});
+  }
+
+private:
+  /// The message to publish next.
+  std::unique_ptr<DataType> m_next_msg;
+};
+
+template<class Msg>
+using RclcppIntraProcessSingleThreadedExecutorCommunicator =
+  RclcppIntraProcessCommunicator<Msg, RclcppSingleThreadedExecutorCommunicator<Msg>>;
+
+template<class Msg>
+using RclcppIntraProcessStaticSingleThreadedExecutorCommunicator =
+  RclcppIntraProcessCommunicator<Msg, RclcppStaticSingleThreadedExecutorCommunicator<Msg>>;
+
+/// Hosts the subscriptions on the shared events or multi-threaded executor.
+template<class Msg>
+using RclcppIntraProcessSharedExecutorCommunicator =
+  RclcppIntraProcessCommunicator<Msg, RclcppSharedExecutorCommunicator<Msg>>;
+
+}  // namespace performance_test
+#endif  // COMMUNICATION_ABSTRACTIONS__RCLCPP_INTRA_PROCESS_COMMUNICATOR_HPP_
@@ -0,0 +1,130 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__RCLCPP_SERIALIZED_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__RCLCPP_SERIALIZED_COMMUNICATOR_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "rclcpp_callback_communicator.hpp"
+
+namespace performance_test
+{
+/**
+ * \brief Communication plugin for ROS 2 which publishes and receives serialized messages.
+ *
+ * For `rclcpp-serialized` the typed publisher and subscription are used with
+ * rclcpp::SerializedMessage. For `rclcpp-generic` the plugin uses rclcpp::GenericPublisher and
+ * rclcpp::GenericSubscription, which only know the type name at runtime, like bridges and
+ * recorders do. The plugin serializes and deserializes the samples itself and records the time
+ * spent doing so separately from the latency.
+ */
+template<class Msg, class Executor>
+class RclcppSerializedCommunicator : public RclcppCallbackCommunicator<Msg, Executor>
+{
+public:
+  /// The data type to publish and subscribe to.
+  using DataType = typename RclcppCallbackCommunicator<Msg, Executor>::DataType;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit RclcppSerializedCommunicator(SpinLock & lock)
+  : RclcppCallbackCommunicator<Msg, Executor>(lock),
+    m_is_generic(this->m_ec.com_mean() == CommunicationMean::RCLCPP_GENERIC),
+    m_type_name(rosidl_generator_traits::name<DataType>())
+  {
+    if (this->m_ec.is_zero_copy_transfer()) {
+      throw std::runtime_error("Serialized messages do not support zero copy transfer!");
+    }
+  }
+
+  /**
+   * \brief Serializes the sample into a reused buffer and publishes the buffer.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time) override
+  {
+    if (m_is_generic && !m_generic_publisher) {
+      m_generic_publisher = this->m_node->create_generic_publisher(
+        this->m_ec.topic_name() + this->m_ec.pub_topic_postfix(), m_type_name,
+        this->m_ROS2QOSAdapter);
+    }
+    this->lock();
+    this->init_msg(this->m_data, time);
+    this->unlock();
+
+    const auto serialization_start = std::chrono::steady_clock::now();
+    m_serialization.serialize_message(&this->m_data, &m_serialized_msg);
+    const auto serialization_end = std::chrono::steady_clock::now();
+
+    this->lock();
+    this->add_serialization_to_statistics(serialization_end - serialization_start);
+    this->increment_sent();  // We increment before publishing so we don't have to lock twice.
+    this->unlock();
+    if (m_is_generic) {
+      m_generic_publisher->publish(m_serialized_msg);
+    } else {
+      this->publisher()->publish(m_serialized_msg);
+    }
+  }
+
+protected:
+  /// Creates a subscription which receives the samples in serialized form.
+  std::shared_ptr<::rclcpp::SubscriptionBase> create_subscription() override
+  {
+    const auto topic = this->m_ec.topic_name() + this->m_ec.sub_topic_postfix();
+    auto callback = [this](std::shared_ptr<rclcpp::SerializedMessage> serialized_msg) {
+        this->serialized_callback(*serialized_msg);
+      };
+    if (m_is_generic) {
+      return this->m_node->create_generic_subscription(
+        topic, m_type_name, this->m_ROS2QOSAdapter, callback);
+    }
+    return this->m_node->template create_subscription<DataType>(
+      topic, this->m_ROS2QOSAdapter, callback);
+  }
+
+private:
+  /// Deserializes the received buffer into a reused sample and passes it to the callback handler.
+  void serialized_callback(const rclcpp::SerializedMessage & serialized_msg)
+  {
+    const auto deserialization_start = std::chrono::steady_clock::now();
+    m_serialization.deserialize_message(&serialized_msg, &m_received_data);
+    const auto deserialization_end = std::chrono::steady_clock::now();
+
+    this->lock();
+    this->add_serialization_to_statistics(deserialization_end - deserialization_start);
+    this->unlock();
+    this->callback(m_received_data);
+  }
+
+  const bool m_is_generic;
+  const std::string m_type_name;
+  std::shared_ptr<rclcpp::GenericPublisher> m_generic_publisher;
+  rclcpp::Serialization<DataType> m_serialization;
+  rclcpp::SerializedMessage m_serialized_msg;
+  DataType m_received_data;
+};
+
+template<class Msg>
+using RclcppSerializedSingleThreadedExecutorCommunicator =
+  RclcppSerializedCommunicator<Msg, rclcpp::executors::SingleThreadedExecutor>;
+
+}  // namespace performance_test
+#endif  // COMMUNICATION_ABSTRACTIONS__RCLCPP_SERIALIZED_COMMUNICATOR_HPP_
@@ -0,0 +1,86 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__RCLCPP_SHARED_EXECUTOR_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__RCLCPP_SHARED_EXECUTOR_COMMUNICATOR_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "rclcpp_communicator.hpp"
+#include "resource_manager.hpp"
+
+namespace performance_test
+{
+/**
+ * \brief Communication plugin for ROS 2 where all subscriptions share one executor.
+ *
+ * The executor and the node hosting the subscriptions are owned by the resource manager and spin
+ * on their own thread. The executor type, the number of executor threads and the assignment of
+ * subscriptions to callback groups are taken from the experiment configuration.
+ */
+template<class Msg>
+class RclcppSharedExecutorCommunicator : public RclcppCommunicator<Msg>
+{
+public:
+  /// The data type to publish and subscribe to.
+  using DataType = typename RclcppCommunicator<Msg>::DataType;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit RclcppSharedExecutorCommunicator(SpinLock & lock)
+  : RclcppCommunicator<Msg>(lock) {}
+
+  /**
+   * \brief Creates the subscription on the first call.
+   *
+   * The samples are processed by the shared executor, so this only waits.
+   */
+  void update_subscription() override
+  {
+    if (!m_subscription) {
+      m_subscription = create_subscription();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+protected:
+  /// Creates the subscription which passes the received data to the callback handler.
+  virtual std::shared_ptr<::rclcpp::SubscriptionBase> create_subscription()
+  {
+    return subscribe<DataType>(
+      [this](const typename DataType::SharedPtr data) {this->callback(data);});
+  }
+
+  /// Creates a subscription of the \tparam T messages on the node of the shared executor, which
+  /// passes them to \param callback.
+  template<class T, class Callback>
+  std::shared_ptr<::rclcpp::SubscriptionBase> subscribe(Callback && callback)
+  {
+    rclcpp::SubscriptionOptions options;
+    options.callback_group = ResourceManager::get().rclcpp_executor_callback_group();
+    return ResourceManager::get().rclcpp_executor_node()->template create_subscription<T>(
+      this->m_ec.topic_name() + this->m_ec.sub_topic_postfix(), this->m_ROS2QOSAdapter,
+      std::forward<Callback>(callback), options);
+  }
+
+private:
+  std::shared_ptr<::rclcpp::SubscriptionBase> m_subscription;
+};
+
+}  // namespace performance_test
+#endif  // COMMUNICATION_ABSTRACTIONS__RCLCPP_SHARED_EXECUTOR_COMMUNICATOR_HPP_
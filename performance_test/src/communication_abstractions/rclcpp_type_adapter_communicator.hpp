@@ -0,0 +1,327 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__RCLCPP_TYPE_ADAPTER_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__RCLCPP_TYPE_ADAPTER_COMMUNICATOR_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/type_adapter.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "rclcpp_callback_communicator.hpp"
+
+namespace performance_test
+{
+/// Custom in-memory representation of the Array* messages, holding the payload on the heap.
+template<class RosType>
+struct AdaptedArray
+{
+  /// The number of bytes in the payload.
+  static constexpr std::size_t size =
+    std::tuple_size<decltype(std::declval<RosType>().array)>::value;
+
+  AdaptedArray()
+  : time(), id(), array(size) {}
+
+  std::int64_t time;
+  std::uint64_t id;
+  std::vector<std::uint8_t> array;
+};
+
+/**
+ * \brief Custom in-memory representation of the PointCloud* messages in a structure of arrays
+ *        layout.
+ *
+ * The ROS message stores the points interleaved as x, y, z and intensity floats, this type stores
+ * every field in its own contiguous array.
+ */
+template<class RosType>
+struct AdaptedPointCloud
+{
+  /// The number of bytes per point in the ROS message.
+  static constexpr std::size_t point_step = 4 * sizeof(float);
+  /// The number of points which fit into the ROS message.
+  static constexpr std::size_t num_points =
+    std::tuple_size<decltype(std::declval<RosType>().data)>::value / point_step;
+
+  AdaptedPointCloud()
+  : time(), id(), x(num_points), y(num_points), z(num_points), intensity(num_points) {}
+
+  std::int64_t time;
+  std::uint64_t id;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> intensity;
+};
+
+/// Maps a ROS message type to its custom type. Only specialized for types which can be adapted.
+template<class RosType, class = void>
+struct TypeAdaptation {};
+
+template<class RosType>
+struct TypeAdaptation<RosType, decltype(std::declval<RosType>().array, void())>
+{
+  using CustomType = AdaptedArray<RosType>;
+};
+
+template<class RosType>
+struct TypeAdaptation<RosType,
+  decltype(std::declval<RosType>().data, std::declval<RosType>().point_step, void())>
+{
+  using CustomType = AdaptedPointCloud<RosType>;
+};
+
+/// Whether a custom type is defined for the ROS message type.
+template<class RosType, class = void>
+struct is_type_adaptable : std::false_type {};
+
+template<class RosType>
+struct is_type_adaptable<RosType,
+  decltype(std::declval<typename TypeAdaptation<RosType>::CustomType>(), void())>
+  : std::true_type {};
+
+/**
+ * \brief Accumulates the time spent in the type conversions on the calling thread.
+ *
+ * rclcpp calls the conversions on the thread which publishes or executes the subscription, so
+ * the communicator can pick up the time after publishing or inside the subscription callback.
+ */
+class ConversionRecorder
+{
+public:
+  /// Adds the duration of a conversion.
+  static void record(const std::chrono::nanoseconds duration)
+  {
+    auto & s = state();
+    s.duration += duration;
+    s.converted = true;
+  }
+
+  /**
+   * \brief Takes the time recorded since the last call.
+   * \param duration Is set to the recorded time.
+   * \returns Returns false if no conversion happened since the last call.
+   */
+  static bool take(std::chrono::nanoseconds & duration)
+  {
+    auto & s = state();
+    const bool converted = s.converted;
+    duration = s.duration;
+    s = State();
+    return converted;
+  }
+
+private:
+  struct State
+  {
+    std::chrono::nanoseconds duration{0};
+    bool converted{false};
+  };
+
+  static State & state()
+  {
+    thread_local State s;
+    return s;
+  }
+};
+}  // namespace performance_test
+
+namespace rclcpp
+{
+template<class RosType>
+struct TypeAdapter<performance_test::AdaptedArray<RosType>, RosType>
+{
+  using is_specialized = std::true_type;
+  using custom_type = performance_test::AdaptedArray<RosType>;
+  using ros_message_type = RosType;
+
+  static void convert_to_ros_message(const custom_type & source, ros_message_type & destination)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    destination.time = source.time;
+    destination.id = source.id;
+    std::memcpy(destination.array.data(), source.array.data(), custom_type::size);
+    performance_test::ConversionRecorder::record(std::chrono::steady_clock::now() - start);
+  }
+
+  static void convert_to_custom(const ros_message_type & source, custom_type & destination)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    destination.time = source.time;
+    destination.id = source.id;
+    destination.array.assign(source.array.begin(), source.array.end());
+    performance_test::ConversionRecorder::record(std::chrono::steady_clock::now() - start);
+  }
+};
+
+template<class RosType>
+struct TypeAdapter<performance_test::AdaptedPointCloud<RosType>, RosType>
+{
+  using is_specialized = std::true_type;
+  using custom_type = performance_test::AdaptedPointCloud<RosType>;
+  using ros_message_type = RosType;
+
+  static void convert_to_ros_message(const custom_type & source, ros_message_type & destination)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    destination.time = source.time;
+    destination.id = source.id;
+    destination.height = 1;
+    destination.width = static_cast<std::uint32_t>(custom_type::num_points);
+    destination.point_step = static_cast<std::uint32_t>(custom_type::point_step);
+    destination.row_step = destination.width * destination.point_step;
+    destination.is_dense = true;
+    // Describes the interleaved x, y, z and intensity FLOAT32 (datatype 7 of
+    // sensor_msgs/PointField) fields of every point.
+    const char * const names[] = {"x", "y", "z", "intensity"};
+    for (std::size_t i = 0; i < 4; ++i) {
+      auto & field = destination.fields[i];
+      field.name.fill(0);
+      for (std::size_t c = 0; names[i][c] != '\0'; ++c) {
+        field.name[c] = static_cast<typename std::decay_t<decltype(field.name)>::value_type>(
+          names[i][c]);
+      }
+      field.offset = static_cast<std::uint32_t>(i * sizeof(float));
+      field.datatype = 7;
+      field.count = 1;
+    }
+    auto * point = destination.data.data();
+    for (std::size_t i = 0; i < custom_type::num_points; ++i) {
+      const float fields[] = {source.x[i], source.y[i], source.z[i], source.intensity[i]};
+      std::memcpy(point, fields, custom_type::point_step);
+      point += custom_type::point_step;
+    }
+    performance_test::ConversionRecorder::record(std::chrono::steady_clock::now() - start);
+  }
+
+  static void convert_to_custom(const ros_message_type & source, custom_type & destination)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    destination.time = source.time;
+    destination.id = source.id;
+    const auto * point = source.data.data();
+    for (std::size_t i = 0; i < custom_type::num_points; ++i) {
+      float fields[4];
+      std::memcpy(fields, point, custom_type::point_step);
+      destination.x[i] = fields[0];
+      destination.y[i] = fields[1];
+      destination.z[i] = fields[2];
+      destination.intensity[i] = fields[3];
+      point += custom_type::point_step;
+    }
+    performance_test::ConversionRecorder::record(std::chrono::steady_clock::now() - start);
+  }
+};
+}  // namespace rclcpp
+
+namespace performance_test
+{
+/**
+ * \brief Communication plugin for ROS 2 which publishes and receives custom types through
+ *        rclcpp::TypeAdapter.
+ *
+ * If the publishers and subscribers run in the same process, intra-process communication is
+ * enabled and the custom type is passed by pointer without any conversion. Otherwise rclcpp
+ * converts the custom type to the ROS message before publishing and back after receiving. The
+ * time spent in these conversions is reported in the serialization and deserialization
+ * statistics.
+ */
+template<class Msg, class Executor>
+class RclcppTypeAdapterCommunicator : public RclcppCallbackCommunicator<Msg, Executor>
+{
+public:
+  /// The data type to publish and subscribe to.
+  using DataType = typename RclcppCallbackCommunicator<Msg, Executor>::DataType;
+  /// The custom type which is adapted to DataType.
+  using CustomType = typename TypeAdaptation<DataType>::CustomType;
+  /// The type adapter used for the publisher and the subscription.
+  using AdapterType = rclcpp::TypeAdapter<CustomType, DataType>;
+
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit RclcppTypeAdapterCommunicator(SpinLock & lock)
+  : RclcppCallbackCommunicator<Msg, Executor>(lock),
+    m_next_msg(std::make_unique<CustomType>())
+  {
+    if (this->m_ec.is_zero_copy_transfer()) {
+      throw std::runtime_error("Type adaptation does not support zero copy transfer!");
+    }
+  }
+
+  /**
+   * \brief Publishes a newly allocated custom type by unique pointer.
+   *
+   * The custom type for the next sample is allocated after publishing, so the allocation does
+   * not add to the latency.
+   *
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time) override
+  {
+    if (!m_adapted_publisher) {
+      m_adapted_publisher = this->m_node->template create_publisher<AdapterType>(
+        this->m_ec.topic_name() + this->m_ec.pub_topic_postfix(), this->m_ROS2QOSAdapter);
+    }
+    this->lock();
+    m_next_msg->time = time;
+    m_next_msg->id = this->next_sample_id();
+    this->increment_sent();  // We increment before publishing so we don't have to lock twice.
+    this->unlock();
+    m_adapted_publisher->publish(std::move(m_next_msg));
+    add_conversion_to_statistics();
+    m_next_msg = std::make_unique<CustomType>();
+  }
+
+protected:
+  /// Creates a subscription which receives the custom type.
+  std::shared_ptr<::rclcpp::SubscriptionBase> create_subscription() override
+  {
+    return this->m_node->template create_subscription<AdapterType>(
+      this->m_ec.topic_name() + this->m_ec.sub_topic_postfix(), this->m_ROS2QOSAdapter,
+      [this](const CustomType & msg) {
+        add_conversion_to_statistics();
+        this->on_sample(msg.time, msg.id);
+      });
+  }
+
+private:
+  /// Adds the time rclcpp spent converting on this thread, if it converted at all.
+  void add_conversion_to_statistics()
+  {
+    std::chrono::nanoseconds duration;
+    if (ConversionRecorder::take(duration)) {
+      this->lock();
+      this->add_serialization_to_statistics(duration);
+      this->unlock();
+    }
+  }
+
+  std::shared_ptr<::rclcpp::Publisher<AdapterType>> m_adapted_publisher;
+  /// The custom type to publish next.
+  std::unique_ptr<CustomType> m_next_msg;
+};
+
+template<class Msg>
+using RclcppTypeAdapterSingleThreadedExecutorCommunicator =
+  RclcppTypeAdapterCommunicator<Msg, rclcpp::executors::SingleThreadedExecutor>;
+
+}  // namespace performance_test
+#endif  // COMMUNICATION_ABSTRACTIONS__RCLCPP_TYPE_ADAPTER_COMMUNICATOR_HPP_
@@ -23,6 +23,7 @@
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <string>
 
 #include "../experiment_configuration/qos_abstraction.hpp"
 
@@ -43,7 +44,8 @@ public:
   /// Constructor which takes a reference \param lock to the lock to use.
   explicit RclcppWaitsetCommunicator(SpinLock & lock)
   : RclcppCommunicator<Msg>(lock),
-    m_subscription(nullptr)
+    m_subscription(nullptr),
+    m_received_data(std::make_unique<DataType>())
   {
     auto hz = static_cast<double>(this->m_ec.rate());
     auto period = std::chrono::duration<double>(1.0 / hz);
@@ -66,19 +68,66 @@ public:
     const auto wait_ret = m_waitset->wait(m_timeout);
 
     if (wait_ret.kind() == rclcpp::Ready) {
-      DataType msg;
-      rclcpp::MessageInfo msg_info;
-      bool success = m_subscription->take(msg, msg_info);
-      if (success) {
-        this->callback(msg);
-      }
+      const auto num_taken =
+        m_subscription->can_loan_messages() ? take_loaned_messages() : take_messages();
+      this->lock();
+      this->add_samples_per_wakeup_to_statistics(num_taken);
+      this->unlock();
     }
   }
 
 private:
+  /**
+   * \brief Takes the ready samples as loans from the RMW implementation, so they are not copied.
+   * \returns Returns the number of samples taken.
+   */
+  std::uint64_t take_loaned_messages()
+  {
+    const auto handle = m_subscription->get_subscription_handle();
+    std::uint64_t num_taken = 0;
+    while (this->may_take_more(num_taken)) {
+      void * loaned_msg = nullptr;
+      rmw_message_info_t msg_info = rmw_get_zero_initialized_message_info();
+      const auto ret = rcl_take_loaned_message(handle.get(), &loaned_msg, &msg_info, nullptr);
+      if (ret == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+        break;
+      }
+      if (ret != RCL_RET_OK) {
+        const std::string error = rcl_get_error_string().str;
+        rcl_reset_error();
+        throw std::runtime_error("Failed to take loaned message: " + error);
+      }
+      ++num_taken;
+      this->callback(*static_cast<const DataType *>(loaned_msg));
+      if (rcl_return_loaned_message_from_subscription(handle.get(), loaned_msg) != RCL_RET_OK) {
+        const std::string error = rcl_get_error_string().str;
+        rcl_reset_error();
+        throw std::runtime_error("Failed to return loaned message: " + error);
+      }
+    }
+    return num_taken;
+  }
+
+  /**
+   * \brief Takes the ready samples into the preallocated sample.
+   * \returns Returns the number of samples taken.
+   */
+  std::uint64_t take_messages()
+  {
+    rclcpp::MessageInfo msg_info;
+    std::uint64_t num_taken = 0;
+    while (this->may_take_more(num_taken) && m_subscription->take(*m_received_data, msg_info)) {
+      ++num_taken;
+      this->callback(*m_received_data);
+    }
+    return num_taken;
+  }
+
   std::shared_ptr<::rclcpp::Subscription<DataType>> m_subscription;
   std::unique_ptr<rclcpp::WaitSet> m_waitset;
   std::chrono::nanoseconds m_timeout;
+  /// Heap allocated, because large message types would not fit on the stack.
+  std::unique_ptr<DataType> m_received_data;
 };
 
 }  // namespace performance_test
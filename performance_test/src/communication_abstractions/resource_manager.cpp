@@ -16,12 +16,20 @@
 
 #if defined(PERFORMANCE_TEST_FASTRTPS_ENABLED)
   #include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+  #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+  #include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
+  #include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.h>
 #endif
 
 #ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
   #include "iceoryx_posh/runtime/posh_runtime.hpp"
 #endif
 
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  #include <rclcpp/experimental/executors/events_executor/events_executor.hpp>
+#endif
+
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -31,8 +39,18 @@ namespace performance_test
 
 void ResourceManager::shutdown()
 {
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  get().stop_rclcpp_executor();
+#endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   eprosima::fastrtps::Domain::stopAll();
+  auto & fastdds_participant = get().m_fastdds_participant;
+  if (fastdds_participant) {
+    fastdds_participant->delete_contained_entities();
+    eprosima::fastdds::dds::DomainParticipantFactory::get_instance()->delete_participant(
+      fastdds_participant);
+    fastdds_participant = nullptr;
+  }
 #endif
 }
 
@@ -60,6 +78,7 @@ std::shared_ptr<rclcpp::Node> ResourceManager::rclcpp_node() const
   }
 
   auto options = rclcpp::NodeOptions();
+  options.use_intra_process_comms(m_ec.use_rclcpp_intra_process_comms());
 
   auto env_name = "ROS_DOMAIN_ID";
   auto env_value = std::to_string(m_ec.dds_domain_id());
@@ -71,6 +90,64 @@ std::shared_ptr<rclcpp::Node> ResourceManager::rclcpp_node() const
 
   return rclcpp::Node::make_shared("performance_test" + rand_str, options);
 }
+
+std::shared_ptr<rclcpp::Node> ResourceManager::rclcpp_executor_node() const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  if (!m_node) {
+    const auto com_mean = m_ec.com_mean();
+    if (com_mean == CommunicationMean::RCLCPP_MULTI_THREADED_EXECUTOR ||
+      com_mean == CommunicationMean::RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR)
+    {
+      m_rclcpp_executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(
+        rclcpp::ExecutorOptions(), m_ec.executor_threads());
+    } else if (com_mean == CommunicationMean::RCLCPP_EVENTS_EXECUTOR ||
+      com_mean == CommunicationMean::RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR)
+    {
+      m_rclcpp_executor = std::make_shared<rclcpp::experimental::executors::EventsExecutor>();
+    } else {
+      throw std::runtime_error("The communication mean does not use a process-wide executor.");
+    }
+    m_node = rclcpp_node();
+    m_rclcpp_executor->add_node(m_node);
+    m_rclcpp_executor_thread = std::thread(
+      [this, executor = m_rclcpp_executor]() {
+        executor->spin();
+        m_rclcpp_executor_done = true;
+      });
+  }
+  return m_node;
+}
+
+rclcpp::CallbackGroup::SharedPtr ResourceManager::rclcpp_executor_callback_group() const
+{
+  const auto node = rclcpp_executor_node();
+
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+  if (m_ec.callback_group_mode() == ExperimentConfiguration::CallbackGroupMode::SHARED) {
+    if (!m_rclcpp_shared_callback_group) {
+      m_rclcpp_shared_callback_group =
+        node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+    }
+    return m_rclcpp_shared_callback_group;
+  }
+  return node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+}
+
+void ResourceManager::stop_rclcpp_executor() const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  if (m_rclcpp_executor_thread.joinable()) {
+    // A cancel before the executor started spinning is lost, so it is repeated until spin returns.
+    while (!m_rclcpp_executor_done) {
+      m_rclcpp_executor->cancel();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    m_rclcpp_executor_thread.join();
+  }
+}
 #endif
 
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
@@ -103,6 +180,58 @@ eprosima::fastrtps::Participant * ResourceManager::fastrtps_participant() const
   }
   return m_fastrtps_participant;
 }
+
+eprosima::fastdds::dds::DomainParticipant * ResourceManager::fastdds_participant() const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  if (!m_fastdds_participant) {
+    auto factory = eprosima::fastdds::dds::DomainParticipantFactory::get_instance();
+    factory->load_profiles();
+    auto qos = factory->get_default_participant_qos();
+    qos.name("performance_test_fastDDS");
+    qos.transport().send_socket_buffer_size = 1048576;
+    qos.transport().listen_socket_buffer_size = 4194304;
+    qos.wire_protocol().builtin.discovery_config.leaseDuration =
+      eprosima::fastrtps::c_TimeInfinite;
+
+    if (m_ec.fastdds_transport() == ExperimentConfiguration::FastDDSTransport::UDP) {
+      qos.transport().use_builtin_transports = false;
+      qos.transport().user_transports.push_back(
+        std::make_shared<eprosima::fastdds::rtps::UDPv4TransportDescriptor>());
+    } else if (m_ec.fastdds_transport() == ExperimentConfiguration::FastDDSTransport::SHM) {
+      qos.transport().use_builtin_transports = false;
+      qos.transport().user_transports.push_back(
+        std::make_shared<eprosima::fastdds::rtps::SharedMemTransportDescriptor>());
+    }
+
+    m_fastdds_participant = factory->create_participant(m_ec.dds_domain_id(), qos);
+    if (!m_fastdds_participant) {
+      throw std::runtime_error("failed to create participant");
+    }
+  }
+  return m_fastdds_participant;
+}
+
+eprosima::fastdds::dds::Topic * ResourceManager::fastdds_topic(
+  const std::string & topic_name,
+  eprosima::fastdds::dds::TypeSupport type) const
+{
+  auto participant = fastdds_participant();
+
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+  type.register_type(participant);
+  auto description = participant->lookup_topicdescription(topic_name);
+  if (description) {
+    return static_cast<eprosima::fastdds::dds::Topic *>(description);
+  }
+  auto topic = participant->create_topic(
+    topic_name, type.get_type_name(), eprosima::fastdds::dds::TOPIC_QOS_DEFAULT);
+  if (!topic) {
+    throw std::runtime_error("failed to create topic");
+  }
+  return topic;
+}
 #endif
 
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
@@ -118,8 +247,10 @@ DDSDomainParticipant * ResourceManager::connext_DDS_micro_participant() const
     registry->register_component("rh", RHSMHistoryFactory::get_interface(), nullptr, nullptr);
     registry->unregister(NETIO_DEFAULT_UDP_NAME, nullptr, nullptr);
 
-    m_shmem_property.received_message_count_max = 1024 * 16;
-    m_shmem_property.receive_buffer_size = 1024 * 1024 * 128 * 2;
+    m_shmem_property.received_message_count_max =
+      static_cast<RTI_INT32>(m_ec.connext_micro_shmem_message_count());
+    m_shmem_property.receive_buffer_size =
+      static_cast<RTI_INT32>(m_ec.connext_micro_shmem_buffer_size());
     registry->register_component(
       NETIO_DEFAULT_SHMEM_NAME,
       SHMEMInterfaceFactory::get_interface(),
@@ -307,15 +438,51 @@ void ResourceManager::init_iceoryx_runtime() const
 
   if (!m_iceoryx_initialized) {
     m_iceoryx_initialized = true;
+    std::string runtime_name;
     if (m_ec.number_of_subscribers() == 0) {
-      iox::runtime::PoshRuntime::initRuntime("iox-perf-test-pub");
+      runtime_name = "iox-perf-test-pub";
     } else if (m_ec.number_of_publishers() == 0) {
-      iox::runtime::PoshRuntime::initRuntime("iox-perf-test-sub");
+      runtime_name = "iox-perf-test-sub";
     } else {
-      iox::runtime::PoshRuntime::initRuntime("iox-perf-test-intra");
+      runtime_name = "iox-perf-test-intra";
+    }
+    iox::runtime::PoshRuntime::initRuntime(
+      iox::RuntimeName_t(iox::cxx::TruncateToCapacity, runtime_name));
+    if (m_ec.iceoryx_introspection()) {
+      m_iceoryx_introspection = std::make_unique<IceoryxIntrospection>(runtime_name);
     }
   }
 }
+
+void ResourceManager::count_iceoryx_queue_overflow() const
+{
+  // Every communicator calls init_iceoryx_runtime() before it takes samples, so the collector
+  // is visible without taking the lock.
+  if (m_iceoryx_introspection) {
+    m_iceoryx_introspection->count_queue_overflow();
+  }
+}
+
+void ResourceManager::record_iceoryx_chunk(
+  const std::uint64_t used,
+  const std::uint64_t chunk_size) const
+{
+  m_iceoryx_chunk_size.store(chunk_size, std::memory_order_relaxed);
+  m_iceoryx_chunk_unused.store(chunk_size > used ? chunk_size - used : 0,
+    std::memory_order_relaxed);
+}
+
+IceoryxIntrospectionInfo ResourceManager::iceoryx_introspection_info() const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+  IceoryxIntrospectionInfo info;
+  if (m_iceoryx_introspection) {
+    info = m_iceoryx_introspection->sample();
+  }
+  info.chunk_size = m_iceoryx_chunk_size.load(std::memory_order_relaxed);
+  info.chunk_unused = m_iceoryx_chunk_unused.load(std::memory_order_relaxed);
+  return info;
+}
 #endif
 
 #ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
@@ -329,26 +496,30 @@ ResourceManager::opendds_participant() const
 
     OpenDDS::DCPS::TransportConfig_rch config =
       OpenDDS::DCPS::TransportRegistry::instance()->create_config("ApexAiConfig");
+    const auto transport = m_ec.opendds_transport();
     OpenDDS::DCPS::TransportInst_rch inst =
-      OpenDDS::DCPS::TransportRegistry::instance()->create_inst("rtps_tran", "rtps_udp");
-    OpenDDS::DCPS::RtpsUdpInst_rch rui =
-      OpenDDS::DCPS::static_rchandle_cast<OpenDDS::DCPS::RtpsUdpInst>(inst);
-    rui->handshake_timeout_ = 1;
+      OpenDDS::DCPS::TransportRegistry::instance()->create_inst(
+      to_string(transport) + "_tran", to_string(transport));
+    if (transport == ExperimentConfiguration::OpenDDSTransport::RTPS_UDP) {
+      OpenDDS::DCPS::RtpsUdpInst_rch rui =
+        OpenDDS::DCPS::static_rchandle_cast<OpenDDS::DCPS::RtpsUdpInst>(inst);
+      rui->handshake_timeout_ = 1;
+      rui->use_multicast_ = true;
+      rui->local_address("127.0.0.1:");
+      rui->multicast_interface_ = "lo";
+    } else if (transport == ExperimentConfiguration::OpenDDSTransport::TCP) {
+      OpenDDS::DCPS::TcpInst_rch tci =
+        OpenDDS::DCPS::static_rchandle_cast<OpenDDS::DCPS::TcpInst>(inst);
+      tci->local_address("127.0.0.1:");
+    }
 
     config->instances_.push_back(inst);
     OpenDDS::DCPS::TransportRegistry::instance()->global_config(config);
 
     int domain = m_ec.dds_domain_id();
-    bool multicast = true;
-    unsigned int resend = 1;
-    std::string partition, governance, permissions;
-    int defaultSize = 0;
 
     OpenDDS::RTPS::RtpsDiscovery_rch disc;
     disc = OpenDDS::DCPS::make_rch<OpenDDS::RTPS::RtpsDiscovery>("RtpsDiscovery");
-    rui->use_multicast_ = true;
-    rui->local_address("127.0.0.1:");
-    rui->multicast_interface_ = "lo";
     disc->sedp_multicast(true);
 
     TheServiceParticipant->add_discovery(
@@ -412,5 +583,104 @@ ResourceManager::opendds_subscriber(
     throw std::runtime_error("Failed to get default datareader qos");
   }
 }
+
+DDS::Topic_ptr
+ResourceManager::opendds_topic(
+  const std::string & topic_name,
+  DDS::TypeSupport_ptr type_support,
+  const std::string & type_name) const
+{
+  DDS::DomainParticipant_ptr participant = opendds_participant();
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  if (type_support->register_type(participant, type_name.c_str()) != DDS::RETCODE_OK) {
+    throw std::runtime_error("failed to register type");
+  }
+  DDS::TopicDescription_var description =
+    participant->lookup_topicdescription(topic_name.c_str());
+  if (!CORBA::is_nil(description)) {
+    return DDS::Topic::_narrow(description);
+  }
+  DDS::Topic_ptr topic = participant->create_topic(
+    topic_name.c_str(),
+    type_name.c_str(),
+    TOPIC_QOS_DEFAULT,
+    nullptr,
+    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(topic)) {
+    throw std::runtime_error("topic == nullptr");
+  }
+  return topic;
+}
+#endif
+
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+std::shared_ptr<IntraQueueTopic> ResourceManager::intra_queue_topic(const std::string & name) const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  auto & topic = m_intra_queue_topics[name];
+  if (!topic) {
+    topic = std::make_shared<IntraQueueTopic>();
+  }
+  return topic;
+}
+#endif
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+std::shared_ptr<NullMailbox> ResourceManager::null_mailbox(const std::string & name) const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+
+  auto & entry = m_null_mailboxes[name];
+  auto mailbox = entry.lock();
+  if (!mailbox) {
+    mailbox = std::make_shared<NullMailbox>();
+    entry = mailbox;
+  }
+  return mailbox;
+}
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+void ResourceManager::record_shm_ring_wakeup(const int64_t latency_ns) const
+{
+  m_shm_ring_wakeup_recorder.add(latency_ns);
+}
+
+ShmRingWakeupInfo ResourceManager::shm_ring_wakeup_info() const
+{
+  return m_shm_ring_wakeup_recorder.sample();
+}
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+void ResourceManager::count_udp_socket_drops(const uint64_t drops) const
+{
+  m_udp_drop_counter.add_socket_drops(drops);
+}
+
+UdpDropInfo ResourceManager::udp_drop_info() const
+{
+  std::lock_guard<std::mutex> lock(m_global_mutex);
+  return m_udp_drop_counter.sample();
+}
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+void ResourceManager::count_stream_publisher_syscalls(const uint64_t syscalls) const
+{
+  m_stream_syscall_counter.add_publisher_syscalls(syscalls);
+}
+
+void ResourceManager::count_stream_subscriber_syscalls(const uint64_t syscalls) const
+{
+  m_stream_syscall_counter.add_subscriber_syscalls(syscalls);
+}
+
+StreamSyscallInfo ResourceManager::stream_syscall_info() const
+{
+  return m_stream_syscall_counter.sample();
+}
 #endif
 }  // namespace performance_test
@@ -20,6 +20,9 @@
   #include <fastrtps/attributes/ParticipantAttributes.h>
   #include <fastrtps/xmlparser/XMLProfileManager.h>
   #include <fastrtps/Domain.h>
+  #include <fastdds/dds/domain/DomainParticipant.hpp>
+  #include <fastdds/dds/topic/Topic.hpp>
+  #include <fastdds/dds/topic/TypeSupport.hpp>
 #endif
 
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
@@ -43,6 +46,10 @@
   #include <dds/DCPS/transport/framework/TransportRegistry.h>
   #include <dds/DCPS/transport/rtps_udp/RtpsUdpInst_rch.h>
   #include <dds/DCPS/transport/rtps_udp/RtpsUdpInst.h>
+  #include <dds/DCPS/transport/shmem/Shmem.h>
+  #include <dds/DCPS/transport/tcp/Tcp.h>
+  #include <dds/DCPS/transport/tcp/TcpInst.h>
+  #include <dds/DCPS/transport/tcp/TcpInst_rch.h>
   #include <dds/DdsDcpsInfrastructureC.h>
   #include <dds/DdsDcpsPublicationC.h>
   #include <dds/DdsDcpsSubscriptionC.h>
@@ -56,9 +63,38 @@
   #include <rclcpp/rclcpp.hpp>
 #endif
 
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  #include "iceoryx_introspection.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  #include "intra_queue.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  #include "null_mailbox.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  #include "shm_ring.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  #include "udp_raw.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  #include "stream.hpp"
+#endif
+
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 
 #include "../experiment_configuration/experiment_configuration.hpp"
 
@@ -88,11 +124,41 @@ public:
 #ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
   /// Returns the ROS 2 node.
   std::shared_ptr<rclcpp::Node> rclcpp_node() const;
+
+  /**
+   * \brief Returns the node which is hosted by the process-wide ROS 2 executor.
+   *
+   * The executor type is derived from the communication mean. On the first call the executor is
+   * created and starts spinning on its own thread.
+   */
+  std::shared_ptr<rclcpp::Node> rclcpp_executor_node() const;
+
+  /// Returns a callback group on the executor node according to the configured callback group mode.
+  rclcpp::CallbackGroup::SharedPtr rclcpp_executor_callback_group() const;
+
+  /**
+   * \brief Cancels the process-wide ROS 2 executor, if running, and waits for its thread to finish.
+   *
+   * Called once at the end of the experiment, as the executor is shared by all subscribers.
+   */
+  void stop_rclcpp_executor() const;
 #endif
 
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   /// Returns FastRTPS participant.
   eprosima::fastrtps::Participant * fastrtps_participant() const;
+
+  /// Returns the Fast DDS domain participant, which uses the configured transport.
+  eprosima::fastdds::dds::DomainParticipant * fastdds_participant() const;
+
+  /**
+   * \brief Returns the Fast DDS topic with the given name, creating it if it does not exist yet.
+   * \param topic_name The name of the topic.
+   * \param type The type of the topic, which is registered with the participant if needed.
+   */
+  eprosima::fastdds::dds::Topic * fastdds_topic(
+    const std::string & topic_name,
+    eprosima::fastdds::dds::TypeSupport type) const;
 #endif
 
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
@@ -143,7 +209,30 @@ public:
 #endif
 
 #ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  /**
+   * \brief Initializes the iceoryx runtime of this process, if not done yet.
+   *
+   * If the iceoryx introspection is enabled, this also starts collecting it.
+   */
   void init_iceoryx_runtime() const;
+
+  /// Counts a subscriber queue overflow, if the iceoryx introspection is enabled.
+  void count_iceoryx_queue_overflow() const;
+
+  /**
+   * \brief Records a chunk which the untyped publisher loaned. Thread-safe.
+   * \param used The bytes of the chunk used by the chunk header and the payload.
+   * \param chunk_size The size of the chunk.
+   */
+  void record_iceoryx_chunk(std::uint64_t used, std::uint64_t chunk_size) const;
+
+  /**
+   * \brief Returns the latest iceoryx introspection values and chunk sizes.
+   *
+   * The introspection values are zero if the introspection is disabled or the runtime is not
+   * initialized yet. The chunk sizes are zero if no chunk was loaned through the untyped API.
+   */
+  IceoryxIntrospectionInfo iceoryx_introspection_info() const;
 #endif
 
 #ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
@@ -163,6 +252,59 @@ public:
    * \param dr_qos Will be overwritten with the default QOS from the created subscriber.
    */
   void opendds_subscriber(DDS::Subscriber_ptr & subscriber, DDS::DataReaderQos & dr_qos) const;
+
+  /**
+   * \brief Returns the OpenDDS topic with the given name, creating it if it does not exist yet.
+   * \param topic_name The name of the topic.
+   * \param type_support The type support, which is registered with the participant if needed.
+   * \param type_name The name to register the type with.
+   */
+  DDS::Topic_ptr opendds_topic(
+    const std::string & topic_name,
+    DDS::TypeSupport_ptr type_support,
+    const std::string & type_name) const;
+#endif
+
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  /// Returns the intra queue topic with the given \param name, creating it if it does not exist.
+  std::shared_ptr<IntraQueueTopic> intra_queue_topic(const std::string & name) const;
+#endif
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  /**
+   * \brief Returns the null mailbox with the given \param name.
+   *
+   * The mailbox is shared while a publisher or subscriber holds it, and created anew otherwise,
+   * so a later experiment does not receive a stale sample.
+   */
+  std::shared_ptr<NullMailbox> null_mailbox(const std::string & name) const;
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  /// Records the wakeup \param latency_ns of a shm ring subscriber.
+  void record_shm_ring_wakeup(const int64_t latency_ns) const;
+
+  /// Returns the shm ring wakeups since the previous call.
+  ShmRingWakeupInfo shm_ring_wakeup_info() const;
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  /// Counts the \param drops a udp-raw subscriber socket reported.
+  void count_udp_socket_drops(const uint64_t drops) const;
+
+  /// Returns the UDP drops since the previous call.
+  UdpDropInfo udp_drop_info() const;
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  /// Counts \param syscalls of a stream publisher.
+  void count_stream_publisher_syscalls(const uint64_t syscalls) const;
+
+  /// Counts \param syscalls of a stream subscriber.
+  void count_stream_subscriber_syscalls(const uint64_t syscalls) const;
+
+  /// Returns the stream system calls since the previous call.
+  StreamSyscallInfo stream_syscall_info() const;
 #endif
 
 private:
@@ -173,6 +315,7 @@ private:
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
     , m_fastrtps_participant(nullptr)
+    , m_fastdds_participant(nullptr)
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
     , m_connext_dds_micro_participant(nullptr)
@@ -194,10 +337,15 @@ private:
 
 #ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
   mutable std::shared_ptr<rclcpp::Node> m_node;
+  mutable std::shared_ptr<rclcpp::Executor> m_rclcpp_executor;
+  mutable std::thread m_rclcpp_executor_thread;
+  mutable std::atomic<bool> m_rclcpp_executor_done{false};
+  mutable rclcpp::CallbackGroup::SharedPtr m_rclcpp_shared_callback_group;
 #endif
 
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   mutable eprosima::fastrtps::Participant * m_fastrtps_participant;
+  mutable eprosima::fastdds::dds::DomainParticipant * m_fastdds_participant;
 #endif
 
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
@@ -224,6 +372,29 @@ private:
 
 #ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
   mutable bool m_iceoryx_initialized = false;
+  mutable std::unique_ptr<IceoryxIntrospection> m_iceoryx_introspection;
+  mutable std::atomic<std::uint64_t> m_iceoryx_chunk_size{0};
+  mutable std::atomic<std::uint64_t> m_iceoryx_chunk_unused{0};
+#endif
+
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  mutable std::map<std::string, std::shared_ptr<IntraQueueTopic>> m_intra_queue_topics;
+#endif
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  mutable std::map<std::string, std::weak_ptr<NullMailbox>> m_null_mailboxes;
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  mutable ShmRingWakeupRecorder m_shm_ring_wakeup_recorder;
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  mutable UdpDropCounter m_udp_drop_counter;
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  mutable StreamSyscallCounter m_stream_syscall_counter;
 #endif
 
   mutable std::mutex m_global_mutex;
@@ -0,0 +1,76 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__SAMPLE_HEADER_HPP_
+#define COMMUNICATION_ABSTRACTIONS__SAMPLE_HEADER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../experiment_configuration/experiment_configuration.hpp"
+#include "../utilities/msg_traits.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief The header in front of the payload of a sample which is sent without serialization.
+ *
+ * Used by the plugins which transfer raw bytes instead of the message type.
+ */
+struct SampleHeader
+{
+  std::int64_t time;
+  std::uint64_t id;
+  /// The number of payload bytes following the header.
+  std::uint64_t size;
+};
+
+/// Returns the capacity of the bounded sequence of \param msg.
+template<typename T>
+std::enable_if_t<msg_traits::has_bounded_sequence<T>::value, std::size_t>
+bounded_sequence_capacity(const T & msg)
+{
+  return msg.bounded_sequence.capacity();
+}
+
+template<typename T>
+std::enable_if_t<!msg_traits::has_bounded_sequence<T>::value, std::size_t>
+bounded_sequence_capacity(const T &)
+{
+  return 0;
+}
+
+/**
+ * \brief Returns the number of payload bytes to send after the SampleHeader for a message type.
+ *
+ * The payload is as large as the message: the size of the message for messages with a fixed
+ * size, the capacity of a bounded sequence, and the configured unbounded message size otherwise.
+ * \param ec The experiment configuration with the unbounded message size.
+ */
+template<typename T>
+std::size_t sample_payload_size(const ExperimentConfiguration & ec)
+{
+  if (msg_traits::is_fixed_size<T>::value) {
+    return sizeof(T);
+  }
+  const bool unbounded =
+    msg_traits::has_unbounded_sequence<T>::value || msg_traits::has_unbounded_string<T>::value;
+  return bounded_sequence_capacity(T()) + (unbounded ? ec.unbounded_msg_size() : 0);
+}
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__SAMPLE_HEADER_HPP_
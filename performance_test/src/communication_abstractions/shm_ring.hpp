@@ -0,0 +1,140 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__SHM_RING_HPP_
+#define COMMUNICATION_ABSTRACTIONS__SHM_RING_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace performance_test
+{
+
+/// The wakeups of the shm ring subscribers during one experiment interval.
+struct ShmRingWakeupInfo
+{
+  /// The number of waits which ended with a sample, after the sample was not available first.
+  uint64_t wakeups = 0;
+  /// The percentiles of the wakeup latency in ms.
+  double latency_p50 = 0.0;
+  double latency_p90 = 0.0;
+  double latency_p99 = 0.0;
+  double latency_p999 = 0.0;
+  /// The maximum wakeup latency in ms.
+  double latency_max = 0.0;
+};
+
+/**
+ * \brief Records the wakeup latencies of the shm ring subscribers in a histogram. Thread-safe.
+ *
+ * The wakeup latency is the time from the publisher making a sample visible to a waiting
+ * subscriber running again. The histogram has eight linear buckets per power of two, so the
+ * percentiles are accurate to 12.5 %.
+ */
+class ShmRingWakeupRecorder
+{
+public:
+  /// Records the wakeup \param latency_ns.
+  void add(const int64_t latency_ns)
+  {
+    const uint64_t latency = latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0;
+    m_buckets[bucket(latency)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (latency > max && !m_max.compare_exchange_weak(max, latency)) {
+    }
+  }
+
+  /// Returns the wakeups since the previous call.
+  ShmRingWakeupInfo sample()
+  {
+    std::array<uint64_t, s_bucket_count> counts;
+    uint64_t total = 0;
+    for (std::size_t i = 0; i < s_bucket_count; ++i) {
+      counts[i] = m_buckets[i].exchange(0);
+      total += counts[i];
+    }
+    const uint64_t max = m_max.exchange(0);
+
+    ShmRingWakeupInfo info;
+    info.wakeups = total;
+    if (total > 0) {
+      info.latency_p50 = percentile(counts, total, 0.5);
+      info.latency_p90 = percentile(counts, total, 0.9);
+      info.latency_p99 = percentile(counts, total, 0.99);
+      info.latency_p999 = percentile(counts, total, 0.999);
+      info.latency_max = to_ms(max);
+    }
+    return info;
+  }
+
+private:
+  static constexpr unsigned s_sub_bits = 3;
+  static constexpr uint64_t s_sub_buckets = 1U << s_sub_bits;
+  /// Values below this are counted exactly, each in its own bucket.
+  static constexpr uint64_t s_linear_limit = 2 * s_sub_buckets;
+  static constexpr std::size_t s_bucket_count =
+    s_linear_limit + (64 - s_sub_bits - 1) * s_sub_buckets;
+
+  static std::size_t bucket(const uint64_t value)
+  {
+    if (value < s_linear_limit) {
+      return static_cast<std::size_t>(value);
+    }
+    const unsigned exponent = 63U - static_cast<unsigned>(__builtin_clzll(value));
+    const uint64_t sub = (value >> (exponent - s_sub_bits)) & (s_sub_buckets - 1);
+    return static_cast<std::size_t>(
+      s_linear_limit + (exponent - s_sub_bits - 1) * s_sub_buckets + sub);
+  }
+
+  /// Returns the largest value which falls into the bucket with the given \param index.
+  static uint64_t upper_bound(const std::size_t index)
+  {
+    if (index < s_linear_limit) {
+      return index;
+    }
+    const uint64_t offset = index - s_linear_limit;
+    const unsigned exponent = static_cast<unsigned>(offset / s_sub_buckets) + s_sub_bits + 1;
+    const uint64_t sub = offset % s_sub_buckets;
+    const uint64_t width = uint64_t{1} << (exponent - s_sub_bits);
+    return (uint64_t{1} << exponent) + (sub + 1) * width - 1;
+  }
+
+  static double percentile(
+    const std::array<uint64_t, s_bucket_count> & counts, const uint64_t total,
+    const double fraction)
+  {
+    const auto rank = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < s_bucket_count; ++i) {
+      seen += counts[i];
+      if (seen >= rank) {
+        return to_ms(upper_bound(i));
+      }
+    }
+    return 0.0;
+  }
+
+  static double to_ms(const uint64_t ns)
+  {
+    return static_cast<double>(ns) / 1000000.0;
+  }
+
+  std::array<std::atomic<uint64_t>, s_bucket_count> m_buckets{};
+  std::atomic<uint64_t> m_max{0};
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__SHM_RING_HPP_
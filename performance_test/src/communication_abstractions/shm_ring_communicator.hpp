@@ -0,0 +1,800 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__SHM_RING_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__SHM_RING_COMMUNICATOR_HPP_
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "baseline_communicator.hpp"
+#include "resource_manager.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief The baseline plugin for a lock-free ring buffer in POSIX shared memory.
+ * \tparam Msg The msg type to use.
+ *
+ * The publisher writes every sample into the next slot of a ring in memory created with shm_open,
+ * without waiting for the subscribers. Every subscriber keeps its own read position, so one
+ * publisher serves any number of subscribers in any number of processes. A sequence number in
+ * each slot tells a subscriber whether the slot holds the sample it expects, and whether the
+ * publisher overwrote it while it was copied. A subscriber which falls behind by more than the
+ * slot count loses samples, which are counted from the sample ids.
+ *
+ * The subscribers either busy poll the sequence number of the next slot or sleep until the
+ * publisher wakes them after a sample:
+ * * Futex: on a futex in the shared memory.
+ * * CondVar: on a process-shared condition variable in the shared memory.
+ * * Semaphore: every subscriber on its own process-shared semaphore in the shared memory.
+ * * Eventfd, Pipe: every subscriber polls its own eventfd or pipe. The subscriber passes the
+ *   descriptor the publisher writes to over a Unix domain socket of the publisher.
+ * Only subscribers which announced that they wait are woken, so the publisher makes no system
+ * call while the subscribers keep up. The time from the publisher making a sample visible to a
+ * waiting subscriber running again is recorded as the wakeup latency.
+ */
+template<class Msg>
+class ShmRingCommunicator : public BaselineCommunicator<Msg>
+{
+  using Base = BaselineCommunicator<Msg>;
+  using SampleHeader = typename Base::SampleHeader;
+
+public:
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit ShmRingCommunicator(SpinLock & lock)
+  : Base(lock)
+  {
+  }
+
+  ShmRingCommunicator & operator=(const ShmRingCommunicator &) = delete;
+  ShmRingCommunicator(const ShmRingCommunicator &) = delete;
+
+  ~ShmRingCommunicator()
+  {
+    for (const int fd : m_notify_fds) {
+      if (fd != -1) {
+        close(fd);
+      }
+    }
+    if (m_listen_fd != -1) {
+      close(m_listen_fd);
+    }
+    if (m_publisher_ring != nullptr) {
+      munmap(m_publisher_ring, m_mapping_size);
+      // The publisher owns the name. Mapped rings stay valid for the subscribers.
+      shm_unlink(m_publisher_name.c_str());
+    }
+    if (m_notify_fd != -1 && m_notify_fd != m_wait_fd) {
+      close(m_notify_fd);
+    }
+    if (m_wait_fd != -1) {
+      close(m_wait_fd);
+    }
+    if (m_subscriber_ring != nullptr) {
+      if (m_subscriber_index >= 0) {
+        Subscriber & subscriber = m_subscriber_ring->subscribers[m_subscriber_index];
+        subscriber.waiting.store(0);
+        subscriber.state.store(0, std::memory_order_release);
+      }
+      munmap(m_subscriber_ring, m_mapping_size);
+    }
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   *  The first time this function is called it also creates the ring.
+   *  Further it updates all internal counters while running.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    if (m_publisher_ring == nullptr) {
+      m_publisher_name = ring_name(this->m_ec.pub_topic_postfix());
+      m_publisher_ring = open_ring(m_publisher_name);
+      m_payload.resize(this->payload_size());
+      if (uses_notify_fds()) {
+        m_listen_fd = listen_for_subscribers();
+        if (this->m_ec.shm_ring_wakeup() == ExperimentConfiguration::ShmRingWakeup::PIPE) {
+          // A write to a pipe without a reader raises SIGPIPE. Ignoring it turns it into an
+          // error of the write.
+          signal(SIGPIPE, SIG_IGN);
+        }
+      }
+    }
+
+    // There is only a single publisher per ring, so the head is not contended.
+    const std::uint64_t index = m_publisher_ring->head.load(std::memory_order_relaxed);
+    Slot & slot = slot_at(m_publisher_ring, index);
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    this->init_header(slot.header, time);
+    if (!this->m_ec.is_zero_copy_transfer()) {
+      std::memcpy(slot.payload(), m_payload.data(), m_payload.size());
+    }
+    slot.published = std::chrono::steady_clock::now().time_since_epoch().count();
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    m_publisher_ring->head.store(index + 1, std::memory_order_release);
+
+    if (m_listen_fd != -1) {
+      const std::uint32_t registrations =
+        m_publisher_ring->registrations.load(std::memory_order_acquire);
+      if (registrations != m_registrations) {
+        m_registrations = registrations;
+        accept_subscribers();
+      }
+    }
+    wake_subscribers(*m_publisher_ring);
+  }
+
+  /**
+   * \brief Reads received data.
+   *
+   * The first time this function is called it also opens the ring. A subscriber starts with
+   * the next sample the publisher writes.
+   * In detail this function:
+   * * Waits for the next slot to be written, by busy polling or until the publisher wakes it.
+   * * Copies the samples out of the ring.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+       accordingly.
+   *
+   * In relay mode, the received samples are published back with their original timestamp.
+   */
+  void update_subscription()
+  {
+    if (m_subscriber_ring == nullptr) {
+      m_subscriber_ring = open_ring(ring_name(this->m_ec.sub_topic_postfix()));
+      m_next = m_subscriber_ring->head.load(std::memory_order_acquire);
+      m_payload.resize(this->payload_size());
+      if (uses_subscriber_entry()) {
+        m_subscriber_index = claim_subscriber_entry(*m_subscriber_ring);
+      }
+      if (uses_notify_fds()) {
+        create_notify_fds();
+      }
+    }
+
+    if (wait_for_data()) {
+      take_samples();
+    }
+  }
+
+private:
+  /// The slot layout in the shared memory. The payload follows the struct.
+  struct Slot
+  {
+    /// 2 * index + 1 while the sample with the index is written, 2 * index + 2 afterwards.
+    std::atomic<std::uint64_t> seq;
+    /// The steady clock time in ns when the publisher made the sample visible.
+    std::int64_t published;
+    SampleHeader header;
+
+    std::uint8_t * payload()
+    {
+      return reinterpret_cast<std::uint8_t *>(this + 1);
+    }
+
+    const std::uint8_t * payload() const
+    {
+      return reinterpret_cast<const std::uint8_t *>(this + 1);
+    }
+  };
+
+  /// A subscriber which is woken on its own, for the wakeups which need one object per waiter.
+  struct alignas(64) Subscriber
+  {
+    /// 0 when the entry is free, 1 while it is initialized and 2 while it is used.
+    std::atomic<std::uint32_t> state;
+    /// 1 while the subscriber waits for a sample and was not woken yet.
+    std::atomic<std::uint32_t> waiting;
+    sem_t semaphore;
+  };
+
+  /// The maximum number of subscribers with their own wakeup per ring.
+  static constexpr std::uint32_t s_max_subscribers = 64;
+
+  /// The ring layout in the shared memory. The slots follow the struct.
+  struct Ring
+  {
+    /// 0 when the memory was just created, 1 while it is initialized and 2 afterwards.
+    std::atomic<std::uint32_t> state;
+    std::uint32_t slot_count;
+    std::uint64_t slot_size;
+    /// The number of samples published so far.
+    alignas(64) std::atomic<std::uint64_t> head;
+    /// Incremented after every sample when the futex wakeup is used.
+    alignas(64) std::atomic<std::uint32_t> futex;
+    /// The number of subscribers sleeping on the futex or the condition variable.
+    std::atomic<std::uint32_t> waiters;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    /// One past the highest subscriber entry which was used.
+    std::atomic<std::uint32_t> subscriber_end;
+    /// Incremented whenever a subscriber passed its descriptor to the publisher.
+    std::atomic<std::uint32_t> registrations;
+    Subscriber subscribers[s_max_subscribers];
+  };
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+    "The shm ring requires lock-free atomics to share them between processes");
+
+  static constexpr std::size_t s_slot_alignment = 64;
+
+  /// Returns the size of a slot including the Slot struct, a multiple of the cache line size.
+  std::uint64_t slot_size() const
+  {
+    const std::uint64_t capacity = this->m_ec.shm_ring_payload_size() == 0 ?
+      this->payload_size() : this->m_ec.shm_ring_payload_size();
+    if (this->payload_size() > capacity) {
+      throw std::runtime_error(
+              "The message payload of " + std::to_string(this->payload_size()) +
+              " bytes does not fit into a shm ring slot of " + std::to_string(capacity) +
+              " bytes");
+    }
+    const std::uint64_t size = sizeof(Slot) + capacity;
+    return (size + s_slot_alignment - 1) / s_slot_alignment * s_slot_alignment;
+  }
+
+  /// Returns the shared memory name for the topic with the given \param postfix.
+  std::string ring_name(const std::string & postfix) const
+  {
+    std::string name = "/perf_test_shm_ring_" + Msg::msg_name() + "_" +
+      this->m_ec.topic_name() + postfix;
+    std::replace(name.begin() + 1, name.end(), '/', '_');
+    return name;
+  }
+
+  /**
+   * \brief Opens the ring with the given \param name, and creates it if it does not exist yet.
+   *
+   * Publishers and subscribers may start in any order, so whoever comes first creates and
+   * initializes the ring. The others wait until the initialization is done and verify that the
+   * ring was created with the same slot count and slot size.
+   */
+  Ring * open_ring(const std::string & name)
+  {
+    const std::uint32_t slot_count = this->m_ec.shm_ring_slots();
+    const std::uint64_t slot_size = this->slot_size();
+    m_mapping_size = sizeof(Ring) + slot_count * slot_size;
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+    if (fd == -1) {
+      throw std::runtime_error("Could not open the shm ring " + name + ": " + strerror(errno));
+    }
+    struct stat fd_stat;
+    if (fstat(fd, &fd_stat) == -1 ||
+      (fd_stat.st_size != 0 && static_cast<std::size_t>(fd_stat.st_size) != m_mapping_size) ||
+      ftruncate(fd, static_cast<off_t>(m_mapping_size)) == -1)
+    {
+      close(fd);
+      throw std::runtime_error(
+              "The shm ring " + name + " exists with a different size or could not be resized. "
+              "Remove it from /dev/shm if it was left behind by an earlier experiment.");
+    }
+    void * memory = mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+      throw std::runtime_error("Could not map the shm ring " + name + ": " + strerror(errno));
+    }
+
+    // The memory is zero-filled when it is created.
+    auto ring = static_cast<Ring *>(memory);
+    std::uint32_t state = 0;
+    if (ring->state.compare_exchange_strong(state, 1)) {
+      ring->slot_count = slot_count;
+      ring->slot_size = slot_size;
+      init_cond_var(*ring);
+      ring->state.store(2, std::memory_order_release);
+    } else {
+      while (ring->state.load(std::memory_order_acquire) != 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if (ring->slot_count != slot_count || ring->slot_size != slot_size) {
+        throw std::runtime_error(
+                "The shm ring " + name + " was created with a different slot count or size");
+      }
+    }
+    return ring;
+  }
+
+  /// Initializes the mutex and the condition variable of the \param ring for all processes.
+  static void init_cond_var(Ring & ring)
+  {
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutex_init(&ring.mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ring.cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+  }
+
+  /// Returns whether every subscriber has its own entry in the ring to be woken with.
+  bool uses_subscriber_entry() const
+  {
+    const auto wakeup = this->m_ec.shm_ring_wakeup();
+    return wakeup == ExperimentConfiguration::ShmRingWakeup::SEMAPHORE || uses_notify_fds();
+  }
+
+  /// Returns whether the publisher wakes the subscribers by writing to their descriptors.
+  bool uses_notify_fds() const
+  {
+    const auto wakeup = this->m_ec.shm_ring_wakeup();
+    return wakeup == ExperimentConfiguration::ShmRingWakeup::EVENTFD ||
+           wakeup == ExperimentConfiguration::ShmRingWakeup::PIPE;
+  }
+
+  /// Claims a free subscriber entry of the \param ring and returns its index.
+  int claim_subscriber_entry(Ring & ring) const
+  {
+    for (std::uint32_t index = 0; index < s_max_subscribers; ++index) {
+      Subscriber & subscriber = ring.subscribers[index];
+      std::uint32_t state = 0;
+      if (!subscriber.state.compare_exchange_strong(state, 1)) {
+        continue;
+      }
+      subscriber.waiting.store(0);
+      if (this->m_ec.shm_ring_wakeup() == ExperimentConfiguration::ShmRingWakeup::SEMAPHORE &&
+        sem_init(&subscriber.semaphore, 1, 0) == -1)
+      {
+        throw std::runtime_error(std::string("Could not create the semaphore: ") +
+                strerror(errno));
+      }
+      subscriber.state.store(2, std::memory_order_release);
+      std::uint32_t end = ring.subscriber_end.load();
+      while (end < index + 1 && !ring.subscriber_end.compare_exchange_weak(end, index + 1)) {
+      }
+      return static_cast<int>(index);
+    }
+    throw std::runtime_error(
+            "The shm ring supports at most " + std::to_string(s_max_subscribers) +
+            " subscribers with this wakeup");
+  }
+
+  /// Creates the descriptors the subscriber waits on and the publisher writes to.
+  void create_notify_fds()
+  {
+    if (this->m_ec.shm_ring_wakeup() == ExperimentConfiguration::ShmRingWakeup::EVENTFD) {
+      m_wait_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      m_notify_fd = m_wait_fd;
+      if (m_wait_fd == -1) {
+        throw std::runtime_error(std::string("Could not create the eventfd: ") +
+                strerror(errno));
+      }
+    } else {
+      int fds[2];
+      if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) == -1) {
+        throw std::runtime_error(std::string("Could not create the pipe: ") + strerror(errno));
+      }
+      m_wait_fd = fds[0];
+      m_notify_fd = fds[1];
+    }
+  }
+
+  /// Returns the address of the socket the publisher of the ring with the \param name listens on.
+  static socklen_t notify_address(const std::string & name, sockaddr_un & address)
+  {
+    // The socket uses the abstract namespace, so no file is left behind.
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    const std::string socket_name = name.substr(1) + "_notify";
+    const std::size_t length = std::min(socket_name.size(), sizeof(address.sun_path) - 1);
+    std::memcpy(address.sun_path + 1, socket_name.data(), length);
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + length);
+  }
+
+  /// Returns the socket the publisher receives the descriptors of the subscribers from.
+  int listen_for_subscribers() const
+  {
+    const int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+      throw std::runtime_error(std::string("Could not create a socket: ") + strerror(errno));
+    }
+    sockaddr_un address;
+    const socklen_t length = notify_address(m_publisher_name, address);
+    if (bind(fd, reinterpret_cast<const sockaddr *>(&address), length) == -1 ||
+      listen(fd, static_cast<int>(s_max_subscribers)) == -1)
+    {
+      const int error = errno;
+      close(fd);
+      throw std::runtime_error(
+              "Could not listen for the shm ring subscribers: " + std::string(strerror(error)) +
+              ". Is there another publisher on the topic?");
+    }
+    return fd;
+  }
+
+  /**
+   * \brief Receives the descriptors of the subscribers which connected since the previous call.
+   *
+   * The subscribers count their registrations in the ring, so the publisher only makes system
+   * calls for this when a subscriber registered.
+   */
+  void accept_subscribers()
+  {
+    while (true) {
+      const int connection = accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+      if (connection == -1) {
+        return;
+      }
+      // The subscriber sends its descriptor right after connecting.
+      timeval timeout{0, 100000};
+      setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+      std::uint32_t index = 0;
+      iovec iov{&index, sizeof(index)};
+      alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+      msghdr msg{};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      const ssize_t received = recvmsg(connection, &msg, MSG_CMSG_CLOEXEC);
+      close(connection);
+      const cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+      if (received != sizeof(index) || cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS) {
+        continue;
+      }
+      int fd;
+      std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(fd));
+      if (index >= s_max_subscribers) {
+        close(fd);
+        continue;
+      }
+      if (m_notify_fds.empty()) {
+        m_notify_fds.resize(s_max_subscribers, -1);
+      }
+      if (m_notify_fds[index] != -1) {
+        close(m_notify_fds[index]);
+      }
+      m_notify_fds[index] = fd;
+    }
+  }
+
+  /**
+   * \brief Passes the descriptor the publisher writes to over the socket of the publisher.
+   *
+   * The publisher may not run yet, so this is retried every 100 ms until it succeeds.
+   */
+  void register_notify_fd()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_next_registration) {
+      return;
+    }
+    m_next_registration = now + std::chrono::milliseconds(100);
+
+    const int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+      throw std::runtime_error(std::string("Could not create a socket: ") + strerror(errno));
+    }
+    sockaddr_un address;
+    const socklen_t length =
+      notify_address(ring_name(this->m_ec.sub_topic_postfix()), address);
+    std::uint32_t index = static_cast<std::uint32_t>(m_subscriber_index);
+    iovec iov{&index, sizeof(index)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &m_notify_fd, sizeof(int));
+    const bool sent = connect(fd, reinterpret_cast<const sockaddr *>(&address), length) == 0 &&
+      sendmsg(fd, &msg, MSG_NOSIGNAL) == sizeof(index);
+    close(fd);
+    if (sent) {
+      m_subscriber_ring->registrations.fetch_add(1, std::memory_order_release);
+      // The publisher holds its own copy of the write end of the pipe now.
+      if (m_notify_fd != m_wait_fd) {
+        close(m_notify_fd);
+      }
+      m_notify_fd = -1;
+    }
+  }
+
+  /// Wakes the subscribers of the \param ring which wait for a sample.
+  void wake_subscribers(Ring & ring)
+  {
+    const auto wakeup = this->m_ec.shm_ring_wakeup();
+    if (wakeup == ExperimentConfiguration::ShmRingWakeup::BUSY_POLL) {
+      return;
+    }
+    if (wakeup == ExperimentConfiguration::ShmRingWakeup::FUTEX) {
+      ring.futex.fetch_add(1);
+      if (ring.waiters.load() > 0) {
+        futex_syscall(&ring.futex, FUTEX_WAKE, INT_MAX, nullptr);
+      }
+      return;
+    }
+
+    // The sample is visible before the waiters are read, and the subscribers announce that they
+    // wait before they check for the sample, so either side sees the other.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (wakeup == ExperimentConfiguration::ShmRingWakeup::COND_VAR) {
+      if (ring.waiters.load(std::memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&ring.mutex);
+        pthread_cond_broadcast(&ring.cond);
+        pthread_mutex_unlock(&ring.mutex);
+      }
+      return;
+    }
+    const std::uint32_t end = ring.subscriber_end.load(std::memory_order_acquire);
+    for (std::uint32_t index = 0; index < end; ++index) {
+      Subscriber & subscriber = ring.subscribers[index];
+      if (subscriber.waiting.load(std::memory_order_relaxed) == 0 ||
+        subscriber.state.load(std::memory_order_acquire) != 2 ||
+        subscriber.waiting.exchange(0) == 0)
+      {
+        continue;
+      }
+      if (wakeup == ExperimentConfiguration::ShmRingWakeup::SEMAPHORE) {
+        sem_post(&subscriber.semaphore);
+      } else if (index < m_notify_fds.size() && m_notify_fds[index] != -1) {
+        const std::uint64_t value = 1;
+        if (write(m_notify_fds[index], &value, sizeof(value)) == -1 && errno == EPIPE) {
+          // The subscriber is gone.
+          close(m_notify_fds[index]);
+          m_notify_fds[index] = -1;
+        }
+      }
+    }
+  }
+
+  /// Returns the slot the sample with the given \param index is written to.
+  Slot & slot_at(Ring * const ring, const std::uint64_t index) const
+  {
+    auto slots = reinterpret_cast<std::uint8_t *>(ring + 1);
+    return *reinterpret_cast<Slot *>(slots + (index % ring->slot_count) * ring->slot_size);
+  }
+
+  /**
+   * \brief Returns whether the publisher finished writing the next slot.
+   *
+   * A slot which is still being written does not count, otherwise the subscriber would stop
+   * waiting before it can take the sample, and the wakeup would not be recorded.
+   */
+  bool next_slot_written() const
+  {
+    const Slot & slot = slot_at(m_subscriber_ring, m_next);
+    return slot.seq.load(std::memory_order_acquire) >= 2 * m_next + 2;
+  }
+
+  /**
+   * \brief Waits until the publisher wrote the next slot.
+   *
+   * The wait ends after 100 ms without a sample, so the caller can stop the experiment. If the
+   * next slot was not written when the wait started, the time it ended is kept to record the
+   * wakeup latency of the sample.
+   * \returns Returns whether the next slot was written.
+   */
+  bool wait_for_data()
+  {
+    m_woken = std::chrono::steady_clock::time_point();
+    if (next_slot_written()) {
+      return true;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (!next_slot_written()) {
+      const auto remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining <= std::chrono::nanoseconds::zero()) {
+        return false;
+      }
+      if (this->m_ec.shm_ring_wakeup() != ExperimentConfiguration::ShmRingWakeup::BUSY_POLL) {
+        wait_for_wakeup(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+      }
+    }
+    // Until the publisher has the descriptor of the subscriber, only the timeout ends the wait.
+    if (m_notify_fd == -1) {
+      m_woken = std::chrono::steady_clock::now();
+    }
+    return true;
+  }
+
+  /// Sleeps until the publisher wakes the subscriber, or at most for the \param timeout.
+  void wait_for_wakeup(const std::chrono::nanoseconds timeout)
+  {
+    Ring & ring = *m_subscriber_ring;
+    const auto wakeup = this->m_ec.shm_ring_wakeup();
+    if (wakeup == ExperimentConfiguration::ShmRingWakeup::FUTEX) {
+      // The waiter is registered before the futex value is read, so the publisher either sees
+      // the waiter and wakes it, or the futex value changes before the subscriber sleeps.
+      ring.waiters.fetch_add(1);
+      const std::uint32_t value = ring.futex.load();
+      if (!next_slot_written()) {
+        const struct timespec relative = to_timespec(timeout);
+        futex_syscall(&ring.futex, FUTEX_WAIT, value, &relative);
+      }
+      ring.waiters.fetch_sub(1);
+      return;
+    }
+
+    if (wakeup == ExperimentConfiguration::ShmRingWakeup::COND_VAR) {
+      ring.waiters.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const struct timespec deadline = deadline_on(CLOCK_MONOTONIC, timeout);
+      pthread_mutex_lock(&ring.mutex);
+      if (!next_slot_written()) {
+        pthread_cond_timedwait(&ring.cond, &ring.mutex, &deadline);
+      }
+      pthread_mutex_unlock(&ring.mutex);
+      ring.waiters.fetch_sub(1);
+      return;
+    }
+
+    if (m_notify_fd != -1) {
+      register_notify_fd();
+    }
+    Subscriber & subscriber = ring.subscribers[m_subscriber_index];
+    subscriber.waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!next_slot_written()) {
+      if (wakeup == ExperimentConfiguration::ShmRingWakeup::SEMAPHORE) {
+        const struct timespec deadline = deadline_on(CLOCK_REALTIME, timeout);
+        sem_timedwait(&subscriber.semaphore, &deadline);
+      } else {
+        pollfd poll_fd{m_wait_fd, POLLIN, 0};
+        const struct timespec relative = to_timespec(timeout);
+        if (ppoll(&poll_fd, 1, &relative, nullptr) == 1) {
+          // A single read resets the eventfd, and takes many wakeups out of the pipe.
+          std::uint8_t buffer[512];
+          const ssize_t ignored = read(m_wait_fd, buffer, sizeof(buffer));
+          static_cast<void>(ignored);
+        }
+      }
+    }
+    subscriber.waiting.store(0, std::memory_order_relaxed);
+  }
+
+  static struct timespec to_timespec(const std::chrono::nanoseconds duration)
+  {
+    struct timespec result;
+    result.tv_sec = static_cast<time_t>(duration.count() / 1000000000);
+    result.tv_nsec = static_cast<long>(duration.count() % 1000000000);  // NOLINT
+    return result;
+  }
+
+  /// Returns the time on the \param clock after the \param timeout.
+  static struct timespec deadline_on(const clockid_t clock, const std::chrono::nanoseconds timeout)
+  {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return to_timespec(
+      std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec) + timeout);
+  }
+
+  /// Copies the written samples out of the ring and updates the statistics.
+  void take_samples()
+  {
+    SampleHeader header;
+    std::uint64_t num_taken = 0;
+    this->lock();
+    while (this->may_take_more(num_taken)) {
+      const Slot & slot = slot_at(m_subscriber_ring, m_next);
+      const std::uint64_t expected = 2 * m_next + 2;
+      const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq < expected) {
+        break;
+      }
+      if (seq == expected) {
+        header = slot.header;
+        if (!this->m_ec.is_zero_copy_transfer()) {
+          std::memcpy(m_payload.data(), slot.payload(), m_payload.size());
+        }
+        const std::int64_t published = slot.published;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == expected) {
+          ++m_next;
+          ++num_taken;
+          if (m_woken != std::chrono::steady_clock::time_point()) {
+            ResourceManager::get().record_shm_ring_wakeup(
+              m_woken.time_since_epoch().count() - published);
+            m_woken = std::chrono::steady_clock::time_point();
+          }
+          if (this->is_relay()) {
+            this->unlock();
+            publish(header.time);
+            this->lock();
+            continue;
+          }
+          this->handle_sample(header);
+          continue;
+        }
+      }
+      // The publisher overwrote the slot. Continue with the oldest sample which is still in the
+      // ring, the skipped samples are counted as lost from the sample ids.
+      const std::uint64_t head = m_subscriber_ring->head.load(std::memory_order_acquire);
+      const std::uint64_t oldest =
+        head - std::min<std::uint64_t>(head, m_subscriber_ring->slot_count - 1);
+      m_next = std::max(m_next + 1, oldest);
+    }
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+  }
+
+  static long futex_syscall(  // NOLINT
+    std::atomic<std::uint32_t> * address, const int op, const std::uint32_t value,
+    const struct timespec * timeout)
+  {
+    return syscall(
+      SYS_futex, reinterpret_cast<std::uint32_t *>(address), op, value, timeout, nullptr, 0);
+  }
+
+  Ring * m_publisher_ring = nullptr;
+  Ring * m_subscriber_ring = nullptr;
+  std::string m_publisher_name;
+  std::size_t m_mapping_size = 0;
+  /// The index of the next sample the subscriber takes.
+  std::uint64_t m_next = 0;
+  std::vector<std::uint8_t> m_payload;
+  /// When the subscriber woke up for the next sample, or zero if it did not wait for it.
+  std::chrono::steady_clock::time_point m_woken;
+
+  /// The socket the publisher receives the descriptors of the subscribers from.
+  int m_listen_fd = -1;
+  /// The registrations of the ring when the publisher last received descriptors.
+  std::uint32_t m_registrations = 0;
+  /// The descriptors the publisher writes to, by subscriber entry.
+  std::vector<int> m_notify_fds;
+
+  /// The subscriber entry in the ring, or -1 if the wakeup does not use one.
+  int m_subscriber_index = -1;
+  /// The descriptor the subscriber waits on.
+  int m_wait_fd = -1;
+  /// The descriptor which is passed to the publisher, -1 once it was passed.
+  int m_notify_fd = -1;
+  std::chrono::steady_clock::time_point m_next_registration;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__SHM_RING_COMMUNICATOR_HPP_
@@ -0,0 +1,71 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__STREAM_HPP_
+#define COMMUNICATION_ABSTRACTIONS__STREAM_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+namespace performance_test
+{
+
+/// The system calls the stream plugin made during one experiment interval.
+struct StreamSyscallInfo
+{
+  /// The system calls of the publishers of this process.
+  uint64_t publisher_syscalls = 0;
+  /// The system calls of the subscribers of this process.
+  uint64_t subscriber_syscalls = 0;
+
+  /// Returns the \param syscalls per sample for the given number of \param samples.
+  static double per_sample(const uint64_t syscalls, const uint64_t samples)
+  {
+    return samples == 0 ? 0.0 : static_cast<double>(syscalls) / static_cast<double>(samples);
+  }
+};
+
+/// Counts the system calls of the stream plugin. Thread-safe.
+class StreamSyscallCounter
+{
+public:
+  /// Adds \param syscalls of a publisher.
+  void add_publisher_syscalls(const uint64_t syscalls)
+  {
+    m_publisher_syscalls.fetch_add(syscalls, std::memory_order_relaxed);
+  }
+
+  /// Adds \param syscalls of a subscriber.
+  void add_subscriber_syscalls(const uint64_t syscalls)
+  {
+    m_subscriber_syscalls.fetch_add(syscalls, std::memory_order_relaxed);
+  }
+
+  /// Returns the system calls since the previous call.
+  StreamSyscallInfo sample()
+  {
+    StreamSyscallInfo info;
+    info.publisher_syscalls = m_publisher_syscalls.exchange(0);
+    info.subscriber_syscalls = m_subscriber_syscalls.exchange(0);
+    return info;
+  }
+
+private:
+  std::atomic<uint64_t> m_publisher_syscalls{0};
+  std::atomic<uint64_t> m_subscriber_syscalls{0};
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__STREAM_HPP_
@@ -0,0 +1,713 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__STREAM_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__STREAM_COMMUNICATOR_HPP_
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "baseline_communicator.hpp"
+#include "io_uring.hpp"
+#include "resource_manager.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief The baseline plugin for a byte stream over a Unix domain socket or TCP loopback.
+ * \tparam Msg The msg type to use.
+ *
+ * Every sample is sent as a frame: the SampleHeader, which holds the payload size, followed by
+ * the payload. The publisher listens and writes every frame to each connected subscriber. A
+ * stream does not lose samples, so a slow subscriber slows down the publisher.
+ *
+ * The socket I/O uses one of three backends:
+ * * Blocking: blocking send and read.
+ * * Epoll: non-blocking sockets, which wait in epoll_wait until they are ready.
+ * * IoUring: the publisher writes from a registered buffer with WRITE_FIXED, and the subscriber
+ *   keeps a multishot receive armed, which fills buffers the subscriber provided to the kernel.
+ *
+ * The system calls of each side are counted, so the results show them per sample.
+ */
+template<class Msg>
+class StreamCommunicator : public BaselineCommunicator<Msg>
+{
+  using Base = BaselineCommunicator<Msg>;
+  using SampleHeader = typename Base::SampleHeader;
+  using StreamBackend = ExperimentConfiguration::StreamBackend;
+
+public:
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit StreamCommunicator(SpinLock & lock)
+  : Base(lock),
+    m_frame_size(sizeof(SampleHeader) + this->payload_size())
+  {
+  }
+
+  StreamCommunicator & operator=(const StreamCommunicator &) = delete;
+  StreamCommunicator(const StreamCommunicator &) = delete;
+
+  ~StreamCommunicator()
+  {
+    for (const auto & connection : m_connections) {
+      close(connection.fd);
+    }
+    for (const int fd : {m_listen_socket, m_publisher_epoll, m_socket, m_subscriber_epoll}) {
+      if (fd != -1) {
+        close(fd);
+      }
+    }
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   *  The first time this function is called it also starts listening. New subscribers are
+   *  accepted at most every 100 ms.
+   *  Further it updates all internal counters while running.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    if (m_listen_socket == -1) {
+      init_publisher();
+    }
+    std::uint64_t syscalls = accept_connections();
+
+    SampleHeader header;
+    this->init_header(header, time);
+    std::memcpy(m_send_frame.data(), &header, sizeof(SampleHeader));
+    for (auto & connection : m_connections) {
+      connection.offset = 0;
+    }
+    switch (backend()) {
+      case StreamBackend::BLOCKING:
+        syscalls += send_blocking();
+        break;
+      case StreamBackend::EPOLL:
+        syscalls += send_epoll();
+        break;
+      case StreamBackend::IO_URING:
+        syscalls += send_io_uring();
+        break;
+    }
+    m_connections.erase(
+      std::remove_if(
+        m_connections.begin(), m_connections.end(),
+        [](const Connection & connection) {return connection.fd == -1;}),
+      m_connections.end());
+    ResourceManager::get().count_stream_publisher_syscalls(syscalls);
+  }
+
+  /**
+   * \brief Reads received data.
+   *
+   * The first time this function is called it also connects to the publisher, and it
+   * reconnects if the publisher closed the connection.
+   * In detail this function:
+   * * Waits for data with the configured backend.
+   * * Splits the received bytes into frames.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+       accordingly.
+   *
+   * In relay mode, the received samples are published back with their original timestamp.
+   */
+  void update_subscription()
+  {
+    std::uint64_t num_taken = 0;
+    if (!m_unhandled.empty()) {
+      // The frames left over by the limit of samples per take are taken before waiting again.
+      this->lock();
+      take_unhandled(num_taken);
+      this->add_samples_per_wakeup_to_statistics(num_taken);
+      this->unlock();
+      return;
+    }
+
+    std::uint64_t syscalls = 0;
+    if (m_socket == -1 && !connect_subscriber(syscalls)) {
+      ResourceManager::get().count_stream_subscriber_syscalls(syscalls);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return;
+    }
+
+    switch (backend()) {
+      case StreamBackend::BLOCKING:
+        syscalls += receive_blocking(num_taken);
+        break;
+      case StreamBackend::EPOLL:
+        syscalls += receive_epoll(num_taken);
+        break;
+      case StreamBackend::IO_URING:
+        syscalls += receive_io_uring(num_taken);
+        break;
+    }
+    ResourceManager::get().count_stream_subscriber_syscalls(syscalls);
+  }
+
+private:
+  struct Connection
+  {
+    int fd;
+    /// The number of bytes of the current frame written so far.
+    std::size_t offset;
+  };
+
+  /// The number of buffers the multishot receive selects from.
+  static constexpr std::uint32_t s_buffer_count = 64;
+  /// The number of submission queue entries, enough to return every buffer and receive again.
+  static constexpr std::uint32_t s_ring_entries = 2 * s_buffer_count;
+  /// The user data of the requests which provide buffers, whose completions are ignored.
+  static constexpr std::uint64_t s_provide_buffers = 1;
+  /// The size of each buffer of the multishot receive, and the minimum size of a read.
+  static constexpr std::size_t s_buffer_size = 64 * 1024;
+  static constexpr std::uint16_t s_buffer_group = 0;
+
+  StreamBackend backend() const
+  {
+    return this->m_ec.stream_backend();
+  }
+
+  bool is_tcp() const
+  {
+    return this->m_ec.stream_socket() == ExperimentConfiguration::StreamSocket::TCP;
+  }
+
+  /**
+   * \brief Creates the socket address for the topic with the given \param postfix.
+   *
+   * The Unix domain socket uses the abstract namespace, so no file is left behind. The relay
+   * direction of a roundtrip uses the next TCP port.
+   */
+  socklen_t address(const std::string & postfix, sockaddr_storage & storage) const
+  {
+    std::memset(&storage, 0, sizeof(storage));
+    if (is_tcp()) {
+      auto & address = reinterpret_cast<sockaddr_in &>(storage);
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      address.sin_port = htons(
+        static_cast<std::uint16_t>(this->m_ec.stream_port() + (postfix == "relay" ? 1 : 0)));
+      return sizeof(sockaddr_in);
+    }
+    auto & address = reinterpret_cast<sockaddr_un &>(storage);
+    address.sun_family = AF_UNIX;
+    const std::string name = "perf_test_stream_" + Msg::msg_name() + "_" +
+      this->m_ec.topic_name() + postfix;
+    const std::size_t length = std::min(name.size(), sizeof(address.sun_path) - 1);
+    std::memcpy(address.sun_path + 1, name.data(), length);
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + length);
+  }
+
+  int create_socket() const
+  {
+    const int fd = socket(is_tcp() ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+      throw std::runtime_error(std::string("Could not create a stream socket: ") +
+              strerror(errno));
+    }
+    return fd;
+  }
+
+  void set_no_delay(const int fd) const
+  {
+    if (is_tcp()) {
+      const int enable = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+  }
+
+  void init_publisher()
+  {
+    m_send_frame.resize(m_frame_size);
+    m_listen_socket = create_socket();
+    const int enable = 1;
+    setsockopt(m_listen_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_storage storage;
+    const socklen_t length = address(this->m_ec.pub_topic_postfix(), storage);
+    if (bind(m_listen_socket, reinterpret_cast<const sockaddr *>(&storage), length) == -1 ||
+      listen(m_listen_socket, 16) == -1)
+    {
+      throw std::runtime_error(
+              std::string("Could not listen for stream subscribers: ") + strerror(errno) +
+              ". There can only be a single publisher per topic.");
+    }
+    fcntl(m_listen_socket, F_SETFL, O_NONBLOCK);
+
+    if (backend() == StreamBackend::EPOLL) {
+      m_publisher_epoll = epoll_create1(EPOLL_CLOEXEC);
+    } else if (backend() == StreamBackend::IO_URING) {
+      m_publisher_ring = std::make_unique<IoUring>(s_ring_entries);
+      m_publisher_ring->register_buffer(iovec{m_send_frame.data(), m_send_frame.size()});
+      // Unlike send, a write to a closed connection raises SIGPIPE. Ignoring it turns it into
+      // an error of the write.
+      signal(SIGPIPE, SIG_IGN);
+    }
+  }
+
+  /// Accepts the waiting subscribers and returns the number of system calls.
+  std::uint64_t accept_connections()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_next_accept) {
+      return 0;
+    }
+    m_next_accept = now + std::chrono::milliseconds(100);
+    std::uint64_t syscalls = 0;
+    while (true) {
+      const int flags = SOCK_CLOEXEC | (backend() == StreamBackend::EPOLL ? SOCK_NONBLOCK : 0);
+      const int fd = accept4(m_listen_socket, nullptr, nullptr, flags);
+      ++syscalls;
+      if (fd == -1) {
+        break;
+      }
+      set_no_delay(fd);
+      if (backend() == StreamBackend::EPOLL) {
+        // Edge triggered, so that connections which are done do not wake the publisher.
+        epoll_event event{};
+        event.events = EPOLLOUT | EPOLLET;
+        event.data.fd = fd;
+        epoll_ctl(m_publisher_epoll, EPOLL_CTL_ADD, fd, &event);
+      }
+      m_connections.push_back(Connection{fd, m_frame_size});
+    }
+    return syscalls;
+  }
+
+  /// Closes a connection whose subscriber left. It is removed after the frame is sent.
+  static void drop(Connection & connection)
+  {
+    close(connection.fd);
+    connection.fd = -1;
+  }
+
+  std::uint64_t send_blocking()
+  {
+    std::uint64_t syscalls = 0;
+    for (auto & connection : m_connections) {
+      while (connection.offset < m_frame_size) {
+        const ssize_t result = send(
+          connection.fd, m_send_frame.data() + connection.offset,
+          m_frame_size - connection.offset, MSG_NOSIGNAL);
+        ++syscalls;
+        if (result > 0) {
+          connection.offset += static_cast<std::size_t>(result);
+        } else if (errno != EINTR) {
+          drop(connection);
+          break;
+        }
+      }
+    }
+    return syscalls;
+  }
+
+  std::uint64_t send_epoll()
+  {
+    std::uint64_t syscalls = 0;
+    epoll_event events[16];
+    while (true) {
+      bool pending = false;
+      for (auto & connection : m_connections) {
+        while (connection.fd != -1 && connection.offset < m_frame_size) {
+          const ssize_t result = send(
+            connection.fd, m_send_frame.data() + connection.offset,
+            m_frame_size - connection.offset, MSG_NOSIGNAL);
+          ++syscalls;
+          if (result > 0) {
+            connection.offset += static_cast<std::size_t>(result);
+          } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            pending = true;
+            break;
+          } else if (errno != EINTR) {
+            drop(connection);
+          }
+        }
+      }
+      if (!pending) {
+        return syscalls;
+      }
+      epoll_wait(m_publisher_epoll, events, 16, -1);
+      ++syscalls;
+    }
+  }
+
+  std::uint64_t send_io_uring()
+  {
+    std::uint64_t syscalls = 0;
+    while (true) {
+      // Submits a write for every connection which is not done, as many as fit into the ring.
+      std::uint32_t submitted = 0;
+      for (std::size_t i = 0; i < m_connections.size(); ++i) {
+        Connection & connection = m_connections[i];
+        if (connection.fd == -1 || connection.offset == m_frame_size) {
+          continue;
+        }
+        io_uring_sqe * sqe = m_publisher_ring->get_sqe();
+        if (sqe == nullptr) {
+          break;
+        }
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = connection.fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(m_send_frame.data() + connection.offset);
+        sqe->len = static_cast<std::uint32_t>(m_frame_size - connection.offset);
+        sqe->buf_index = 0;
+        sqe->user_data = i;
+        ++submitted;
+      }
+      if (submitted == 0) {
+        return syscalls;
+      }
+
+      std::uint32_t completed = 0;
+      while (completed < submitted) {
+        m_publisher_ring->enter(submitted - completed, std::chrono::nanoseconds(-1));
+        ++syscalls;
+        completed += m_publisher_ring->for_each_cqe(
+          [this](const io_uring_cqe & cqe) {
+            Connection & connection = m_connections[cqe.user_data];
+            if (cqe.res > 0) {
+              connection.offset += static_cast<std::size_t>(cqe.res);
+            } else if (cqe.res != -EINTR && cqe.res != -EAGAIN) {
+              drop(connection);
+            }
+          });
+      }
+    }
+  }
+
+  /// Connects to the publisher and returns whether it succeeded.
+  bool connect_subscriber(std::uint64_t & syscalls)
+  {
+    m_socket = create_socket();
+    sockaddr_storage storage;
+    const socklen_t length = address(this->m_ec.sub_topic_postfix(), storage);
+    ++syscalls;
+    if (connect(m_socket, reinterpret_cast<const sockaddr *>(&storage), length) == -1) {
+      close(m_socket);
+      m_socket = -1;
+      return false;
+    }
+    set_no_delay(m_socket);
+    // A new connection starts with a new frame, so the bytes of the previous one are dropped.
+    m_num_pending = 0;
+    m_unhandled.clear();
+    if (m_pending.empty()) {
+      m_pending.resize(m_frame_size);
+    }
+
+    switch (backend()) {
+      case StreamBackend::BLOCKING:
+        {
+          // The read returns after 100 ms without data, so the caller can stop the experiment.
+          timeval timeout{0, 100000};
+          setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+          m_read_buffer.resize(std::max(m_frame_size, s_buffer_size));
+          break;
+        }
+      case StreamBackend::EPOLL:
+        {
+          fcntl(m_socket, F_SETFL, O_NONBLOCK);
+          if (m_subscriber_epoll == -1) {
+            m_subscriber_epoll = epoll_create1(EPOLL_CLOEXEC);
+          }
+          epoll_event event{};
+          event.events = EPOLLIN;
+          event.data.fd = m_socket;
+          epoll_ctl(m_subscriber_epoll, EPOLL_CTL_ADD, m_socket, &event);
+          m_read_buffer.resize(std::max(m_frame_size, s_buffer_size));
+          break;
+        }
+      case StreamBackend::IO_URING:
+        if (!m_subscriber_ring) {
+          init_subscriber_ring();
+        }
+        arm_receive();
+        break;
+    }
+    return true;
+  }
+
+  void disconnect_subscriber()
+  {
+    // Closing the socket also removes it from the epoll set.
+    close(m_socket);
+    m_socket = -1;
+  }
+
+  /// Creates the ring and provides the buffers the multishot receive selects from.
+  void init_subscriber_ring()
+  {
+    m_subscriber_ring = std::make_unique<IoUring>(s_ring_entries);
+    m_ring_buffers.resize(s_buffer_count * s_buffer_size);
+    provide_buffers(0, s_buffer_count);
+  }
+
+  /**
+   * \brief Returns a submission queue entry of the subscriber ring.
+   *
+   * If the submission queue is full, the queued requests are submitted first to make room.
+   */
+  io_uring_sqe * subscriber_sqe()
+  {
+    io_uring_sqe * sqe = m_subscriber_ring->get_sqe();
+    if (sqe == nullptr) {
+      m_subscriber_ring->enter(0, std::chrono::nanoseconds(-1));
+      ResourceManager::get().count_stream_subscriber_syscalls(1);
+      m_sqes_queued = false;
+      sqe = m_subscriber_ring->get_sqe();
+      if (sqe == nullptr) {
+        throw std::runtime_error("The io_uring submission queue of the subscriber is full");
+      }
+    }
+    return sqe;
+  }
+
+  /**
+   * \brief Queues a request which returns buffers to the kernel, submitted with the next wait.
+   * \param id The id of the first buffer.
+   * \param count The number of consecutive buffers.
+   */
+  void provide_buffers(const std::uint16_t id, const std::uint32_t count)
+  {
+    io_uring_sqe * sqe = subscriber_sqe();
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<std::int32_t>(count);
+    sqe->addr = reinterpret_cast<std::uint64_t>(m_ring_buffers.data() + id * s_buffer_size);
+    sqe->len = s_buffer_size;
+    sqe->off = id;
+    sqe->buf_group = s_buffer_group;
+    sqe->user_data = s_provide_buffers;
+    m_sqes_queued = true;
+  }
+
+  /// Queues a multishot receive, which is submitted with the next wait.
+  void arm_receive()
+  {
+    io_uring_sqe * sqe = subscriber_sqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = m_socket;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = s_buffer_group;
+    m_sqes_queued = true;
+  }
+
+  std::uint64_t receive_blocking(std::uint64_t & num_taken)
+  {
+    const ssize_t result = read(m_socket, m_read_buffer.data(), m_read_buffer.size());
+    if (result == 0 || (result < 0 && errno != EAGAIN && errno != EINTR)) {
+      disconnect_subscriber();
+    }
+    this->lock();
+    if (result > 0) {
+      receive(m_read_buffer.data(), static_cast<std::size_t>(result), num_taken);
+    }
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+    return 1;
+  }
+
+  std::uint64_t receive_epoll(std::uint64_t & num_taken)
+  {
+    std::uint64_t syscalls = 1;
+    epoll_event event;
+    if (epoll_wait(m_subscriber_epoll, &event, 1, 100) <= 0) {
+      return syscalls;
+    }
+    this->lock();
+    while (this->may_take_more(num_taken)) {
+      const ssize_t result = read(m_socket, m_read_buffer.data(), m_read_buffer.size());
+      ++syscalls;
+      if (result > 0) {
+        receive(m_read_buffer.data(), static_cast<std::size_t>(result), num_taken);
+        continue;
+      }
+      if (result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        disconnect_subscriber();
+      }
+      break;
+    }
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+    return syscalls;
+  }
+
+  std::uint64_t receive_io_uring(std::uint64_t & num_taken)
+  {
+    std::uint64_t syscalls = 0;
+    // Queued requests are submitted with the wait, which does not wait if completions are
+    // ready already.
+    const bool ready = m_subscriber_ring->has_cqe();
+    if (!ready || m_sqes_queued) {
+      ++syscalls;
+      m_sqes_queued = false;
+      if (!m_subscriber_ring->enter(ready ? 0 : 1, std::chrono::milliseconds(100)) && !ready) {
+        return syscalls;
+      }
+    }
+
+    bool rearm = false;
+    bool closed = false;
+    int error = 0;
+    this->lock();
+    m_subscriber_ring->for_each_cqe(
+      [&](const io_uring_cqe & cqe) {
+        if (cqe.user_data == s_provide_buffers) {
+          return;
+        }
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+          const auto id = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+          if (cqe.res > 0) {
+            receive(
+              m_ring_buffers.data() + id * s_buffer_size, static_cast<std::size_t>(cqe.res),
+              num_taken);
+          }
+          provide_buffers(id, 1);
+        }
+        if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+          // The receive ended: at the end of the stream, or when it ran out of buffers.
+          if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP) {
+            // Reconnecting would fail the same way.
+            error = -cqe.res;
+          } else if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS)) {
+            closed = true;
+          } else {
+            rearm = true;
+          }
+        }
+      });
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+
+    if (error != 0) {
+      throw std::runtime_error(
+              std::string("io_uring multishot receive not supported: ") + strerror(error) +
+              ". It requires Linux 6.0 or newer.");
+    }
+    if (closed) {
+      disconnect_subscriber();
+    } else if (rearm) {
+      arm_receive();
+    }
+    return syscalls;
+  }
+
+  /**
+   * \brief Splits the received bytes into frames and handles them, until no more samples may be
+   * taken in this wakeup. The remaining bytes are kept for the next one. The lock must be held.
+   */
+  void receive(const std::uint8_t * data, const std::size_t size, std::uint64_t & num_taken)
+  {
+    const std::size_t consumed = consume(data, size, num_taken);
+    m_unhandled.insert(m_unhandled.end(), data + consumed, data + size);
+  }
+
+  /// Handles the frames kept from the previous wakeups. The lock must be held.
+  void take_unhandled(std::uint64_t & num_taken)
+  {
+    const std::size_t consumed = consume(m_unhandled.data(), m_unhandled.size(), num_taken);
+    m_unhandled.erase(
+      m_unhandled.begin(), m_unhandled.begin() + static_cast<std::ptrdiff_t>(consumed));
+  }
+
+  /**
+   * \brief Splits the bytes into frames and handles them, until no more samples may be taken in
+   * this wakeup.
+   * \returns Returns the number of bytes consumed.
+   */
+  std::size_t consume(const std::uint8_t * data, std::size_t size, std::uint64_t & num_taken)
+  {
+    const std::size_t total = size;
+    while (size > 0 && this->may_take_more(num_taken)) {
+      // Complete frames are handled in place, only the parts of a frame are collected.
+      if (m_num_pending == 0 && size >= m_frame_size) {
+        handle_frame(data, num_taken);
+        data += m_frame_size;
+        size -= m_frame_size;
+        continue;
+      }
+      const std::size_t length = std::min(size, m_frame_size - m_num_pending);
+      std::memcpy(m_pending.data() + m_num_pending, data, length);
+      m_num_pending += length;
+      data += length;
+      size -= length;
+      if (m_num_pending == m_frame_size) {
+        m_num_pending = 0;
+        handle_frame(m_pending.data(), num_taken);
+      }
+    }
+    return total - size;
+  }
+
+  void handle_frame(const std::uint8_t * frame, std::uint64_t & num_taken)
+  {
+    SampleHeader header;
+    std::memcpy(&header, frame, sizeof(SampleHeader));
+    ++num_taken;
+    if (this->is_relay()) {
+      this->unlock();
+      publish(header.time);
+      this->lock();
+      return;
+    }
+    this->handle_sample(header);
+  }
+
+  const std::size_t m_frame_size;
+
+  int m_listen_socket = -1;
+  int m_publisher_epoll = -1;
+  std::unique_ptr<IoUring> m_publisher_ring;
+  std::vector<Connection> m_connections;
+  std::vector<std::uint8_t> m_send_frame;
+  std::chrono::steady_clock::time_point m_next_accept;
+
+  int m_socket = -1;
+  int m_subscriber_epoll = -1;
+  std::unique_ptr<IoUring> m_subscriber_ring;
+  std::vector<std::uint8_t> m_ring_buffers;
+  bool m_sqes_queued = false;
+  std::vector<std::uint8_t> m_read_buffer;
+  /// The part of a frame which was received so far.
+  std::vector<std::uint8_t> m_pending;
+  std::size_t m_num_pending = 0;
+  /// The received bytes which were not handled because of the limit of samples per take.
+  std::vector<std::uint8_t> m_unhandled;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__STREAM_COMMUNICATOR_HPP_
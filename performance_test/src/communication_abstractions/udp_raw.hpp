@@ -0,0 +1,108 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__UDP_RAW_HPP_
+#define COMMUNICATION_ABSTRACTIONS__UDP_RAW_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace performance_test
+{
+
+/// The UDP datagrams the kernel dropped during one experiment interval.
+struct UdpDropInfo
+{
+  /// The datagrams dropped because the receive buffer of a subscriber socket of this process was
+  /// full, as reported with SO_RXQ_OVFL.
+  uint64_t socket_drops = 0;
+  /// The UDP RcvbufErrors of the network namespace, from /proc/net/snmp.
+  uint64_t rcvbuf_errors = 0;
+  /// The UDP SndbufErrors of the network namespace, from /proc/net/snmp.
+  uint64_t sndbuf_errors = 0;
+};
+
+/**
+ * \brief Collects the kernel drop counters of the udp-raw plugin.
+ *
+ * The subscribers add the socket drops they learn from the received datagrams. The buffer error
+ * counters are read from /proc/net/snmp on each call to sample(), and count the drops of all UDP
+ * sockets, not only the ones of the experiment.
+ */
+class UdpDropCounter
+{
+public:
+  UdpDropCounter()
+  : m_snmp(read_snmp())
+  {
+  }
+
+  /// Adds the \param drops a subscriber socket reported. Thread-safe.
+  void add_socket_drops(const uint64_t drops)
+  {
+    m_socket_drops += drops;
+  }
+
+  /// Returns the drops since the previous call.
+  UdpDropInfo sample()
+  {
+    const UdpDropInfo snmp = read_snmp();
+    UdpDropInfo info;
+    info.socket_drops = m_socket_drops.exchange(0);
+    info.rcvbuf_errors = snmp.rcvbuf_errors - m_snmp.rcvbuf_errors;
+    info.sndbuf_errors = snmp.sndbuf_errors - m_snmp.sndbuf_errors;
+    m_snmp = snmp;
+    return info;
+  }
+
+private:
+  /// Reads the UDP buffer error counters, which are zero if /proc/net/snmp is not available.
+  static UdpDropInfo read_snmp()
+  {
+    // The file has a line with the UDP counter names followed by a line with their values.
+    UdpDropInfo info;
+    std::ifstream snmp("/proc/net/snmp");
+    std::string names;
+    std::string values;
+    while (std::getline(snmp, names)) {
+      if (names.compare(0, 4, "Udp:") != 0 || !std::getline(snmp, values)) {
+        continue;
+      }
+      std::istringstream name_stream(names);
+      std::istringstream value_stream(values);
+      std::string name;
+      std::string value;
+      while (name_stream >> name && value_stream >> value) {
+        if (name == "RcvbufErrors") {
+          info.rcvbuf_errors = std::stoull(value);
+        } else if (name == "SndbufErrors") {
+          info.sndbuf_errors = std::stoull(value);
+        }
+      }
+      break;
+    }
+    return info;
+  }
+
+  std::atomic<uint64_t> m_socket_drops{0};
+  UdpDropInfo m_snmp;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__UDP_RAW_HPP_
@@ -0,0 +1,436 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMUNICATION_ABSTRACTIONS__UDP_RAW_COMMUNICATOR_HPP_
+#define COMMUNICATION_ABSTRACTIONS__UDP_RAW_COMMUNICATOR_HPP_
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "baseline_communicator.hpp"
+#include "resource_manager.hpp"
+
+// Older C libraries do not define the UDP offload options. The kernel rejects them if it does
+// not support them, and the plugin falls back to a datagram per fragment.
+#ifndef UDP_SEGMENT
+  #define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+  #define UDP_GRO 104
+#endif
+
+namespace performance_test
+{
+
+/**
+ * \brief The baseline plugin for UDP datagrams over the loopback interface.
+ * \tparam Msg The msg type to use.
+ *
+ * The publisher splits every sample into fragments of the configured datagram size, each with a
+ * FragmentHeader in front, and sends them to a port on 127.0.0.1 with sendmmsg. The subscriber
+ * receives them in batches with recvmmsg and reassembles the sample. A sample with a missing
+ * fragment is dropped and counted as lost from the sample ids.
+ *
+ * If the kernel supports UDP generic segmentation offload, the publisher passes up to 64
+ * fragments at once and the kernel splits them into datagrams. If it supports UDP generic receive
+ * offload, the kernel may pass several datagrams to the subscriber at once.
+ *
+ * There can only be a single subscriber per topic, which binds the port.
+ */
+template<class Msg>
+class UdpRawCommunicator : public BaselineCommunicator<Msg>
+{
+  using Base = BaselineCommunicator<Msg>;
+  using SampleHeader = typename Base::SampleHeader;
+
+public:
+  /// Constructor which takes a reference \param lock to the lock to use.
+  explicit UdpRawCommunicator(SpinLock & lock)
+  : Base(lock),
+    m_sample_size(sizeof(SampleHeader) + this->payload_size()),
+    m_chunk_size(this->m_ec.udp_raw_datagram_size() - sizeof(FragmentHeader)),
+    m_fragment_count(static_cast<std::uint32_t>(
+        std::max<std::size_t>(1, (m_sample_size + m_chunk_size - 1) / m_chunk_size)))
+  {
+  }
+
+  UdpRawCommunicator & operator=(const UdpRawCommunicator &) = delete;
+  UdpRawCommunicator(const UdpRawCommunicator &) = delete;
+
+  ~UdpRawCommunicator()
+  {
+    if (m_publisher_socket != -1) {
+      close(m_publisher_socket);
+    }
+    if (m_subscriber_socket != -1) {
+      close(m_subscriber_socket);
+    }
+  }
+
+  /**
+   * \brief Publishes the provided data.
+   *
+   *  The first time this function is called it also creates the socket.
+   *  Further it updates all internal counters while running.
+   * \param time The time to fill into the data field.
+   */
+  void publish(std::int64_t time)
+  {
+    if (m_publisher_socket == -1) {
+      init_publisher();
+    }
+
+    SampleHeader header;
+    this->init_header(header, time);
+    std::memcpy(m_send_sample.data(), &header, sizeof(SampleHeader));
+    for (auto & fragment : m_send_fragments) {
+      fragment.id = header.id;
+    }
+
+    std::size_t sent = 0;
+    while (sent < m_send_messages.size()) {
+      const int result = sendmmsg(
+        m_publisher_socket, m_send_messages.data() + sent,
+        static_cast<unsigned int>(m_send_messages.size() - sent), 0);
+      if (result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error(std::string("Could not send a UDP sample: ") + strerror(errno));
+      }
+      sent += static_cast<std::size_t>(result);
+    }
+  }
+
+  /**
+   * \brief Reads received data.
+   *
+   * The first time this function is called it also binds the socket. A subscriber receives the
+   * samples published after it bound the socket.
+   * In detail this function:
+   * * Waits for datagrams.
+   * * Receives batches of datagrams and reassembles the samples.
+   * * Verifies that the data arrived in the right order, chronologically and also
+   *   consistent with the publishing order.
+   * * Counts received and lost samples.
+   * * Calculates the latency of the samples received and updates the statistics
+       accordingly.
+   *
+   * The maximum number of samples per take is checked between the batches.
+   * In relay mode, the received samples are published back with their original timestamp.
+   */
+  void update_subscription()
+  {
+    if (m_subscriber_socket == -1) {
+      init_subscriber();
+    }
+
+    pollfd poll_fd{m_subscriber_socket, POLLIN, 0};
+    if (poll(&poll_fd, 1, 100) <= 0) {
+      return;
+    }
+
+    std::uint64_t num_taken = 0;
+    this->lock();
+    while (this->may_take_more(num_taken)) {
+      for (auto & message : m_receive_messages) {
+        message.msg_hdr.msg_controllen = s_control_size;
+      }
+      const int result = recvmmsg(
+        m_subscriber_socket, m_receive_messages.data(),
+        static_cast<unsigned int>(m_receive_messages.size()), MSG_DONTWAIT, nullptr);
+      if (result <= 0) {
+        break;
+      }
+      for (int i = 0; i < result; ++i) {
+        receive_message(m_receive_messages[static_cast<std::size_t>(i)], num_taken);
+      }
+    }
+    this->add_samples_per_wakeup_to_statistics(num_taken);
+    this->unlock();
+  }
+
+private:
+  /// The header in front of every fragment of a sample.
+  struct FragmentHeader
+  {
+    /// The id of the sample.
+    std::uint64_t id;
+    /// The index of the fragment in the sample.
+    std::uint32_t index;
+    /// The number of fragments of the sample.
+    std::uint32_t count;
+  };
+
+  /// The maximum number of datagrams passed to the kernel at once, as in UDP_MAX_SEGMENTS.
+  static constexpr std::size_t s_max_segments = 64;
+  /// The maximum payload of a UDP datagram over IPv4, which also limits a segmented send.
+  static constexpr std::size_t s_max_datagram_size = 65507;
+  /// The number of messages received with a single recvmmsg call.
+  static constexpr std::size_t s_receive_batch = 64;
+  static constexpr std::size_t s_control_size =
+    CMSG_SPACE(sizeof(std::uint32_t)) + CMSG_SPACE(sizeof(int));
+
+  /// Returns the loopback address for the topic with the given \param postfix.
+  sockaddr_in address(const std::string & postfix) const
+  {
+    // The relay direction of a roundtrip uses the next port.
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(
+      static_cast<std::uint16_t>(this->m_ec.udp_raw_port() + (postfix == "relay" ? 1 : 0)));
+    return address;
+  }
+
+  /// Sets the socket buffer \param option to the configured \param size, if it is not 0.
+  static void set_buffer_size(
+    const int socket, const int option, const int force_option, const std::uint32_t size)
+  {
+    if (size == 0) {
+      return;
+    }
+    const int value = static_cast<int>(std::min<std::uint32_t>(
+        size, static_cast<std::uint32_t>(std::numeric_limits<int>::max())));
+    // The forced option exceeds the system limit, but requires CAP_NET_ADMIN.
+    if (setsockopt(socket, SOL_SOCKET, force_option, &value, sizeof(value)) == 0) {
+      return;
+    }
+    if (setsockopt(socket, SOL_SOCKET, option, &value, sizeof(value)) == -1) {
+      throw std::runtime_error(std::string("Could not set the UDP socket buffer size: ") +
+              strerror(errno));
+    }
+    int actual = 0;
+    socklen_t length = sizeof(actual);
+    // The kernel doubles the requested size to account for its bookkeeping.
+    if (getsockopt(socket, SOL_SOCKET, option, &actual, &length) == 0 && actual / 2 < value) {
+      std::cerr << "The UDP socket buffer size is limited to " << actual / 2 <<
+        " bytes by the system, raise net.core.wmem_max or net.core.rmem_max." << std::endl;
+    }
+  }
+
+  static int create_socket()
+  {
+    const int socket_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (socket_fd == -1) {
+      throw std::runtime_error(std::string("Could not create a UDP socket: ") + strerror(errno));
+    }
+    return socket_fd;
+  }
+
+  /// Creates the socket and prepares the messages for all fragments of a sample.
+  void init_publisher()
+  {
+    m_publisher_socket = create_socket();
+    set_buffer_size(
+      m_publisher_socket, SO_SNDBUF, SO_SNDBUFFORCE, this->m_ec.udp_raw_sndbuf());
+    m_destination = address(this->m_ec.pub_topic_postfix());
+
+    // With segmentation offload, the kernel splits each message at the datagram size.
+    const std::size_t datagram_size = this->m_ec.udp_raw_datagram_size();
+    std::size_t segments = 1;
+    if (this->m_ec.udp_raw_offload() && m_fragment_count > 1) {
+      const int gso_size = static_cast<int>(datagram_size);
+      const std::size_t max_segments =
+        std::min(s_max_segments, s_max_datagram_size / datagram_size);
+      if (max_segments > 1 &&
+        setsockopt(m_publisher_socket, SOL_UDP, UDP_SEGMENT, &gso_size, sizeof(gso_size)) == 0)
+      {
+        segments = max_segments;
+      }
+    }
+
+    m_send_sample.resize(m_fragment_count * m_chunk_size);
+    m_send_fragments.resize(m_fragment_count);
+    m_send_iovecs.resize(2 * m_fragment_count);
+    for (std::uint32_t i = 0; i < m_fragment_count; ++i) {
+      m_send_fragments[i].index = i;
+      m_send_fragments[i].count = m_fragment_count;
+      const std::size_t offset = i * m_chunk_size;
+      m_send_iovecs[2 * i].iov_base = &m_send_fragments[i];
+      m_send_iovecs[2 * i].iov_len = sizeof(FragmentHeader);
+      m_send_iovecs[2 * i + 1].iov_base = m_send_sample.data() + offset;
+      m_send_iovecs[2 * i + 1].iov_len = std::min(m_chunk_size, m_sample_size - offset);
+    }
+
+    for (std::size_t first = 0; first < m_fragment_count; first += segments) {
+      const std::size_t count = std::min<std::size_t>(segments, m_fragment_count - first);
+      mmsghdr message{};
+      message.msg_hdr.msg_name = &m_destination;
+      message.msg_hdr.msg_namelen = sizeof(m_destination);
+      message.msg_hdr.msg_iov = &m_send_iovecs[2 * first];
+      message.msg_hdr.msg_iovlen = 2 * count;
+      m_send_messages.push_back(message);
+    }
+  }
+
+  /// Binds the socket and prepares the buffers for a batch of messages.
+  void init_subscriber()
+  {
+    m_subscriber_socket = create_socket();
+    set_buffer_size(
+      m_subscriber_socket, SO_RCVBUF, SO_RCVBUFFORCE, this->m_ec.udp_raw_rcvbuf());
+    const int enable = 1;
+    if (setsockopt(
+        m_subscriber_socket, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) == -1)
+    {
+      throw std::runtime_error(std::string("Could not enable the UDP drop counter: ") +
+              strerror(errno));
+    }
+    // With receive offload, a message may hold several datagrams of the maximum size.
+    std::size_t buffer_size = this->m_ec.udp_raw_datagram_size();
+    if (this->m_ec.udp_raw_offload() &&
+      setsockopt(m_subscriber_socket, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0)
+    {
+      buffer_size = std::numeric_limits<std::uint16_t>::max();
+    }
+
+    const sockaddr_in local = address(this->m_ec.sub_topic_postfix());
+    if (bind(m_subscriber_socket, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) ==
+      -1)
+    {
+      throw std::runtime_error(
+              "Could not bind the UDP port " + std::to_string(ntohs(local.sin_port)) + ": " +
+              strerror(errno) + ". There can only be a single subscriber per topic.");
+    }
+
+    m_receive_sample.resize(m_fragment_count * m_chunk_size);
+    m_receive_buffers.resize(s_receive_batch * buffer_size);
+    m_receive_control.resize(s_receive_batch * s_control_size);
+    m_receive_iovecs.resize(s_receive_batch);
+    m_receive_messages.resize(s_receive_batch);
+    for (std::size_t i = 0; i < s_receive_batch; ++i) {
+      m_receive_iovecs[i].iov_base = m_receive_buffers.data() + i * buffer_size;
+      m_receive_iovecs[i].iov_len = buffer_size;
+      msghdr & header = m_receive_messages[i].msg_hdr;
+      header = msghdr{};
+      header.msg_iov = &m_receive_iovecs[i];
+      header.msg_iovlen = 1;
+      header.msg_control = m_receive_control.data() + i * s_control_size;
+      header.msg_controllen = s_control_size;
+    }
+  }
+
+  /// Handles the datagrams in a received \param message. The lock must be held.
+  void receive_message(mmsghdr & message, std::uint64_t & num_taken)
+  {
+    std::size_t segment_size = message.msg_len;
+    for (cmsghdr * control = CMSG_FIRSTHDR(&message.msg_hdr); control != nullptr;
+      control = CMSG_NXTHDR(&message.msg_hdr, control))
+    {
+      if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SO_RXQ_OVFL) {
+        // The number of drops of the socket so far, which wraps around.
+        std::uint32_t drops;
+        std::memcpy(&drops, CMSG_DATA(control), sizeof(drops));
+        ResourceManager::get().count_udp_socket_drops(drops - m_socket_drops);
+        m_socket_drops = drops;
+      } else if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO) {
+        int gso_size;
+        std::memcpy(&gso_size, CMSG_DATA(control), sizeof(gso_size));
+        segment_size = static_cast<std::size_t>(gso_size);
+      }
+    }
+
+    auto data = static_cast<const std::uint8_t *>(message.msg_hdr.msg_iov->iov_base);
+    for (std::size_t offset = 0; offset < message.msg_len; offset += segment_size) {
+      const std::size_t size = std::min<std::size_t>(segment_size, message.msg_len - offset);
+      if (receive_fragment(data + offset, size)) {
+        ++num_taken;
+        SampleHeader header;
+        std::memcpy(&header, m_receive_sample.data(), sizeof(SampleHeader));
+        if (this->is_relay()) {
+          this->unlock();
+          publish(header.time);
+          this->lock();
+          continue;
+        }
+        this->handle_sample(header);
+      }
+    }
+  }
+
+  /**
+   * \brief Copies a received fragment into the sample which is reassembled.
+   *
+   * A fragment of another sample replaces the incomplete sample, which is then lost.
+   * \returns Returns whether the sample is complete.
+   */
+  bool receive_fragment(const std::uint8_t * data, const std::size_t size)
+  {
+    FragmentHeader fragment;
+    if (size < sizeof(FragmentHeader)) {
+      throw std::runtime_error("Data consistency violated. Received a truncated UDP datagram.");
+    }
+    std::memcpy(&fragment, data, sizeof(FragmentHeader));
+    const std::size_t offset = std::size_t{fragment.index} * m_chunk_size;
+    if (fragment.count != m_fragment_count || fragment.index >= m_fragment_count ||
+      size - sizeof(FragmentHeader) != std::min(m_chunk_size, m_sample_size - offset))
+    {
+      throw std::runtime_error(
+              "Data consistency violated. The UDP fragment does not match the size of the "
+              "message.");
+    }
+    if (m_num_reassembled == 0 || fragment.id != m_reassembled_id) {
+      m_reassembled_id = fragment.id;
+      m_num_reassembled = 0;
+    }
+    std::memcpy(
+      m_receive_sample.data() + offset, data + sizeof(FragmentHeader),
+      size - sizeof(FragmentHeader));
+    if (++m_num_reassembled < m_fragment_count) {
+      return false;
+    }
+    m_num_reassembled = 0;
+    return true;
+  }
+
+  const std::size_t m_sample_size;
+  const std::size_t m_chunk_size;
+  const std::uint32_t m_fragment_count;
+
+  int m_publisher_socket = -1;
+  sockaddr_in m_destination{};
+  std::vector<std::uint8_t> m_send_sample;
+  std::vector<FragmentHeader> m_send_fragments;
+  std::vector<iovec> m_send_iovecs;
+  std::vector<mmsghdr> m_send_messages;
+
+  int m_subscriber_socket = -1;
+  std::vector<std::uint8_t> m_receive_sample;
+  std::vector<std::uint8_t> m_receive_buffers;
+  std::vector<std::uint8_t> m_receive_control;
+  std::vector<iovec> m_receive_iovecs;
+  std::vector<mmsghdr> m_receive_messages;
+  std::uint64_t m_reassembled_id = 0;
+  std::uint32_t m_num_reassembled = 0;
+  std::uint32_t m_socket_drops = 0;
+};
+
+}  // namespace performance_test
+
+#endif  // COMMUNICATION_ABSTRACTIONS__UDP_RAW_COMMUNICATOR_HPP_
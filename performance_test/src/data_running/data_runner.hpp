@@ -29,6 +29,10 @@
 #include <inttypes.h>
 #endif
 
+#if defined(PERFORMANCE_TEST_LINUX)
+#include <pthread.h>
+#endif
+
 #include "../utilities/spin_lock.hpp"
 
 namespace performance_test
@@ -47,6 +51,7 @@ public:
   : m_com(m_lock),
     m_run(true),
     m_sum_received_samples(0),
+    m_sum_received_shm_samples(0),
     m_sum_lost_samples(0),
     m_sum_received_data(0),
     m_sum_sent_samples(0),
@@ -72,6 +77,13 @@ public:
     }
     return m_sum_received_samples;
   }
+  uint64_t sum_received_shm_samples() const override
+  {
+    if (m_run_type == RunType::PUBLISHER) {
+      throw std::logic_error("Not available on a publisher.");
+    }
+    return m_sum_received_shm_samples;
+  }
   uint64_t sum_lost_samples() const override
   {
     if (m_run_type == RunType::PUBLISHER) {
@@ -104,10 +116,42 @@ public:
   {
     return m_time_reserve_statistics_store;
   }
+  StatisticsTracker serialization_statistics() const override
+  {
+    return m_serialization_statistics;
+  }
+  StatisticsTracker samples_per_wakeup_statistics() const override
+  {
+    if (m_run_type == RunType::PUBLISHER) {
+      throw std::logic_error("Not available on a publisher.");
+    }
+    return m_samples_per_wakeup_statistics;
+  }
+  PerfCounterInfo perf_counters() const override
+  {
+    return m_perf_counter_info;
+  }
+  SchedInfo sched_info() const override
+  {
+    return m_sched_info;
+  }
+  StatisticsTracker run_delay_statistics() const override
+  {
+    if (m_run_type == RunType::PUBLISHER) {
+      throw std::logic_error("Not available on a publisher.");
+    }
+    return m_run_delay_statistics_store;
+  }
+  bool entities_created() const override
+  {
+    return m_entities_created;
+  }
   void sync_reset() override
   {
     namespace sc = std::chrono;
     const auto now = sc::steady_clock::now();
+    // Read before taking the lock, so the runner thread does not wait for /proc.
+    const auto sched_info = m_sched_stats.sample();
     m_lock.lock();
     sc::duration<double> iteration_duration = now - m_last_sync;
 
@@ -120,12 +164,20 @@ public:
     if (m_run_type == RunType::SUBSCRIBER) {
       m_sum_received_samples = static_cast<decltype(m_sum_received_samples)>(
         static_cast<double>(m_com.num_received_samples()) / iteration_duration.count());
+      m_sum_received_shm_samples = static_cast<decltype(m_sum_received_shm_samples)>(
+        static_cast<double>(m_com.num_received_shm_samples()) / iteration_duration.count());
       m_sum_received_data = static_cast<decltype(m_sum_received_data)>(
         static_cast<double>(m_com.data_received()) / iteration_duration.count());
       m_sum_lost_samples = static_cast<decltype(m_sum_lost_samples)>(
         static_cast<double>(m_com.num_lost_samples()) / iteration_duration.count());
       m_latency_statistics = m_com.latency_statistics();
+      m_samples_per_wakeup_statistics = m_com.samples_per_wakeup_statistics();
     }
+    m_serialization_statistics = m_com.serialization_statistics();
+    m_perf_counter_info = m_perf_counters.sample();
+    m_sched_info = sched_info;
+    m_run_delay_statistics_store = m_run_delay_statistics;
+    m_run_delay_statistics = StatisticsTracker();
     m_time_reserve_statistics_store = m_time_reserve_statistics;
     m_time_reserve_statistics = StatisticsTracker();
     m_com.reset();
@@ -138,6 +190,18 @@ private:
   /// The function running inside the thread doing all the work.
   void thread_function()
   {
+#if defined(PERFORMANCE_TEST_LINUX)
+    // Tells the runner threads apart from the threads of the middleware in /proc.
+    pthread_setname_np(
+      pthread_self(), m_run_type == RunType::PUBLISHER ? "perf_test_pub" : "perf_test_sub");
+#endif
+
+    // Only the work of this thread is counted, not that of the threads of the middleware.
+    m_lock.lock();
+    m_perf_counters.open();
+    m_sched_stats.open();
+    m_lock.unlock();
+
     auto next_run = std::chrono::steady_clock::now() +
       std::chrono::duration_cast<std::chrono::nanoseconds>(
       std::chrono::duration<double>(1.0 / m_ec.rate()));
@@ -160,6 +224,12 @@ private:
       }
       if (m_run_type == RunType::SUBSCRIBER) {
         m_com.update_subscription();
+        if (m_ec.sample_run_delay()) {
+          sample_run_delay();
+        }
+      }
+      if (loop_counter == 1) {
+        m_entities_created = true;
       }
       const std::chrono::nanoseconds reserve = next_run - std::chrono::steady_clock::now();
       {
@@ -192,6 +262,21 @@ private:
     }
   }
 
+  /// Adds the time this thread waited in the run queue since the previous wakeup to the
+  /// statistics. This is mostly the time from the wakeup of the waitset until the thread got a
+  /// CPU.
+  void sample_run_delay()
+  {
+    uint64_t run_delay = 0;
+    if (!m_sched_stats.run_delay_since_last(run_delay)) {
+      return;
+    }
+    m_lock.lock();
+    m_run_delay_statistics.add_sample(
+      std::chrono::duration<double>(std::chrono::nanoseconds(run_delay)).count());
+    m_lock.unlock();
+  }
+
   /// Enables the memory tool checker.
   void enable_memory_tools()
   {
@@ -211,17 +296,27 @@ private:
   }
   TCommunicator m_com;
   std::atomic<bool> m_run;
+  std::atomic<bool> m_entities_created{false};
   SpinLock m_lock;
 
   uint64_t m_sum_received_samples;
+  uint64_t m_sum_received_shm_samples;
   uint64_t m_sum_lost_samples;
   std::size_t m_sum_received_data;
 
   std::uint64_t m_sum_sent_samples;
 
   StatisticsTracker m_latency_statistics;
+  StatisticsTracker m_serialization_statistics;
+  StatisticsTracker m_samples_per_wakeup_statistics;
   StatisticsTracker m_time_reserve_statistics, m_time_reserve_statistics_store;
 
+  PerfCounterGroup m_perf_counters;
+  PerfCounterInfo m_perf_counter_info;
+  SchedStatReader m_sched_stats;
+  SchedInfo m_sched_info;
+  StatisticsTracker m_run_delay_statistics, m_run_delay_statistics_store;
+
   std::chrono::steady_clock::time_point m_last_sync;
   const RunType m_run_type;
 
@@ -22,6 +22,8 @@
 #include <osrf_testing_tools_cpp/scope_exit.hpp>
 #endif
 
+#include "../utilities/perf_counters.hpp"
+#include "../utilities/sched_stats.hpp"
 #include "../utilities/statistics_tracker.hpp"
 #include "../experiment_configuration/experiment_configuration.hpp"
 
@@ -72,6 +74,8 @@ public:
   virtual ~DataRunnerBase() = default;
   /// Sum of the received samples per second.
   virtual uint64_t sum_received_samples() const = 0;
+  /// Sum of the samples per second which were received through shared memory.
+  virtual uint64_t sum_received_shm_samples() const = 0;
   /// Sum of the lost samples per second.
   virtual uint64_t sum_lost_samples() const = 0;
   /// Sum of the data received in bytes per second.
@@ -83,6 +87,21 @@ public:
   virtual StatisticsTracker latency_statistics() const = 0;
   /// Statistics about how much time every loop iteration had left over.
   virtual StatisticsTracker loop_time_reserve_statistics() const = 0;
+  /// Statistics about the time spent serializing (publisher) or deserializing (subscriber)
+  /// samples. Only filled by communication means which convert the samples themselves.
+  virtual StatisticsTracker serialization_statistics() const = 0;
+  /// Statistics about the number of samples taken after a single wakeup of the subscriber.
+  virtual StatisticsTracker samples_per_wakeup_statistics() const = 0;
+  /// The hardware performance counters of the runner thread.
+  virtual PerfCounterInfo perf_counters() const = 0;
+  /// The scheduler statistics of the runner thread.
+  virtual SchedInfo sched_info() const = 0;
+  /// Statistics about the time the subscriber waited in the run queue for a CPU per wakeup.
+  /// Only filled if sampling the run delay is enabled.
+  virtual StatisticsTracker run_delay_statistics() const = 0;
+  /// Whether the runner thread created its entities, which the communicators do lazily on the
+  /// first publish or take.
+  virtual bool entities_created() const = 0;
 
   /// Resets all the stored metrics and replaces them with current ones from the running threads.
   virtual void sync_reset() = 0;
@@ -24,10 +24,15 @@
   #include "factories/rclcpp_ste_data_runner_factory.hpp"
   #include "factories/rclcpp_sste_data_runner_factory.hpp"
   #include "factories/rclcpp_waitset_data_runner_factory.hpp"
+  #include "factories/rclcpp_intra_process_data_runner_factory.hpp"
+  #include "factories/rclcpp_serialized_data_runner_factory.hpp"
+  #include "factories/rclcpp_shared_executor_data_runner_factory.hpp"
+  #include "factories/rclcpp_type_adapter_data_runner_factory.hpp"
 #endif
 
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   #include "../communication_abstractions/fast_rtps_communicator.hpp"
+  #include "../communication_abstractions/fast_dds_communicator.hpp"
 #endif
 
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
@@ -53,6 +58,26 @@
 #ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
   #include "../communication_abstractions/opendds_communicator.hpp"
 #endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  #include "../communication_abstractions/shm_ring_communicator.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  #include "../communication_abstractions/intra_queue_communicator.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  #include "../communication_abstractions/udp_raw_communicator.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  #include "../communication_abstractions/stream_communicator.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  #include "../communication_abstractions/null_communicator.hpp"
+#endif
 #include "data_runner.hpp"
 
 namespace performance_test
@@ -85,11 +110,30 @@ std::shared_ptr<DataRunnerBase> DataRunnerFactory::get(
         if (com_mean == CommunicationMean::RCLCPP_WAITSET) {
           ptr = RclcppWaitsetDataRunnerFactory::get(msg_name, run_type);
         }
+        if (is_rclcpp_intra_process(com_mean)) {
+          ptr = RclcppIntraProcessDataRunnerFactory::get(msg_name, run_type, com_mean);
+        }
+        if (com_mean == CommunicationMean::RCLCPP_SERIALIZED ||
+          com_mean == CommunicationMean::RCLCPP_GENERIC)
+        {
+          ptr = RclcppSerializedDataRunnerFactory::get(msg_name, run_type);
+        }
+        if (com_mean == CommunicationMean::RCLCPP_EVENTS_EXECUTOR ||
+          com_mean == CommunicationMean::RCLCPP_MULTI_THREADED_EXECUTOR)
+        {
+          ptr = RclcppSharedExecutorDataRunnerFactory::get(msg_name, run_type);
+        }
+        if (com_mean == CommunicationMean::RCLCPP_TYPE_ADAPTER) {
+          ptr = RclcppTypeAdapterDataRunnerFactory::get(msg_name, run_type);
+        }
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
         if (com_mean == CommunicationMean::FASTRTPS) {
           ptr = std::make_shared<DataRunner<FastRTPSCommunicator<T>>>(run_type);
         }
+        if (com_mean == CommunicationMean::FASTDDS) {
+          ptr = std::make_shared<DataRunner<FastDDSCommunicator<T>>>(run_type);
+        }
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
         if (com_mean == CommunicationMean::CONNEXTDDSMICRO) {
@@ -98,7 +142,12 @@ std::shared_ptr<DataRunnerBase> DataRunnerFactory::get(
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDS_ENABLED
         if (com_mean == CommunicationMean::CONNEXTDDS) {
-          ptr = std::make_shared<DataRunner<RTIDDSCommunicator<T>>>(run_type);
+          if (ExperimentConfiguration::get().is_zero_copy_transfer()) {
+            ptr = std::make_shared<DataRunner<RTIDDSCommunicator<T,
+                typename T::ConnextDDSZeroCopyType>>>(run_type);
+          } else {
+            ptr = std::make_shared<DataRunner<RTIDDSCommunicator<T>>>(run_type);
+          }
         }
 #endif
 #ifdef PERFORMANCE_TEST_CYCLONEDDS_ENABLED
@@ -120,6 +169,31 @@ std::shared_ptr<DataRunnerBase> DataRunnerFactory::get(
         if (com_mean == CommunicationMean::OPENDDS) {
           ptr = std::make_shared<DataRunner<OpenDDSCommunicator<T>>>(run_type);
         }
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+        if (com_mean == CommunicationMean::SHM_RING) {
+          ptr = std::make_shared<DataRunner<ShmRingCommunicator<T>>>(run_type);
+        }
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+        if (com_mean == CommunicationMean::INTRA_QUEUE) {
+          ptr = std::make_shared<DataRunner<IntraQueueCommunicator<T>>>(run_type);
+        }
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+        if (com_mean == CommunicationMean::UDP_RAW) {
+          ptr = std::make_shared<DataRunner<UdpRawCommunicator<T>>>(run_type);
+        }
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+        if (com_mean == CommunicationMean::STREAM) {
+          ptr = std::make_shared<DataRunner<StreamCommunicator<T>>>(run_type);
+        }
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+        if (com_mean == CommunicationMean::NULL_MAILBOX) {
+          ptr = std::make_shared<DataRunner<NullCommunicator<T>>>(run_type);
+        }
 #endif
       }
     });
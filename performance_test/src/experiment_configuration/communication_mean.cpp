@@ -31,11 +31,41 @@ std::string to_string(const CommunicationMean cm)
   if (cm == CommunicationMean::RCLCPP_WAITSET) {
     return "RCLCPP_WAITSET";
   }
+  if (cm == CommunicationMean::RCLCPP_INTRA_PROCESS) {
+    return "RCLCPP_INTRA_PROCESS";
+  }
+  if (cm == CommunicationMean::RCLCPP_INTRA_PROCESS_STATIC_SINGLE_THREADED_EXECUTOR) {
+    return "RCLCPP_INTRA_PROCESS_STATIC_SINGLE_THREADED_EXECUTOR";
+  }
+  if (cm == CommunicationMean::RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR) {
+    return "RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR";
+  }
+  if (cm == CommunicationMean::RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR) {
+    return "RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR";
+  }
+  if (cm == CommunicationMean::RCLCPP_SERIALIZED) {
+    return "RCLCPP_SERIALIZED";
+  }
+  if (cm == CommunicationMean::RCLCPP_GENERIC) {
+    return "RCLCPP_GENERIC";
+  }
+  if (cm == CommunicationMean::RCLCPP_EVENTS_EXECUTOR) {
+    return "RCLCPP_EVENTS_EXECUTOR";
+  }
+  if (cm == CommunicationMean::RCLCPP_MULTI_THREADED_EXECUTOR) {
+    return "RCLCPP_MULTI_THREADED_EXECUTOR";
+  }
+  if (cm == CommunicationMean::RCLCPP_TYPE_ADAPTER) {
+    return "RCLCPP_TYPE_ADAPTER";
+  }
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   if (cm == CommunicationMean::FASTRTPS) {
     return "FASTRTPS";
   }
+  if (cm == CommunicationMean::FASTDDS) {
+    return "FASTDDS";
+  }
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
   if (cm == CommunicationMean::CONNEXTDDSMICRO) {
@@ -66,8 +96,46 @@ std::string to_string(const CommunicationMean cm)
   if (cm == CommunicationMean::OPENDDS) {
     return "OpenDDS";
   }
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  if (cm == CommunicationMean::SHM_RING) {
+    return "SHM_RING";
+  }
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  if (cm == CommunicationMean::INTRA_QUEUE) {
+    return "INTRA_QUEUE";
+  }
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  if (cm == CommunicationMean::UDP_RAW) {
+    return "UDP_RAW";
+  }
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  if (cm == CommunicationMean::STREAM) {
+    return "STREAM";
+  }
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  if (cm == CommunicationMean::NULL_MAILBOX) {
+    return "NULL";
+  }
 #endif
   throw std::invalid_argument("Enum value not supported!");
 }
 
+bool is_rclcpp_intra_process(const CommunicationMean cm)
+{
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  return cm == CommunicationMean::RCLCPP_INTRA_PROCESS ||
+         cm == CommunicationMean::RCLCPP_INTRA_PROCESS_STATIC_SINGLE_THREADED_EXECUTOR ||
+         cm == CommunicationMean::RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR ||
+         cm == CommunicationMean::RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR;
+#else
+  (void)cm;
+  return false;
+#endif
+}
+
 }  // namespace performance_test
@@ -30,9 +30,19 @@ enum class CommunicationMean
   RCLCPP_SINGLE_THREADED_EXECUTOR,
   RCLCPP_STATIC_SINGLE_THREADED_EXECUTOR,
   RCLCPP_WAITSET,
+  RCLCPP_INTRA_PROCESS,
+  RCLCPP_INTRA_PROCESS_STATIC_SINGLE_THREADED_EXECUTOR,
+  RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR,
+  RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR,
+  RCLCPP_SERIALIZED,
+  RCLCPP_GENERIC,
+  RCLCPP_EVENTS_EXECUTOR,
+  RCLCPP_MULTI_THREADED_EXECUTOR,
+  RCLCPP_TYPE_ADAPTER,
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
   FASTRTPS,
+  FASTDDS,
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
   CONNEXTDDSMICRO,
@@ -51,12 +61,30 @@ enum class CommunicationMean
 #endif
 #ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
   OPENDDS,
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  SHM_RING,
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+  INTRA_QUEUE,
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  UDP_RAW,
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  STREAM,
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  NULL_MAILBOX,
 #endif
   INVALID
 };
 
 std::string to_string(const CommunicationMean cm);
 
+/// Returns whether \param cm is one of the rclcpp intra-process communication means.
+bool is_rclcpp_intra_process(const CommunicationMean cm);
+
 /// Outstream operator for CommunicationMean.
 inline std::ostream & operator<<(std::ostream & stream, const CommunicationMean cm)
 {
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <iomanip>
 #include <exception>
+#include <limits>
 #include <string>
 #include <vector>
 #include <memory>
@@ -56,6 +57,164 @@ std::ostream & operator<<(std::ostream & stream, const ExperimentConfiguration::
   return stream << to_string(e);
 }
 
+std::string to_string(const ExperimentConfiguration::IntraProcessOwnership e)
+{
+  if (e == ExperimentConfiguration::IntraProcessOwnership::SHARED) {
+    return "SHARED";
+  } else {
+    return "UNIQUE";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::IntraProcessOwnership & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::CallbackGroupMode e)
+{
+  if (e == ExperimentConfiguration::CallbackGroupMode::SHARED) {
+    return "SHARED";
+  } else {
+    return "PER_SUBSCRIPTION";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::CallbackGroupMode & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::FastDDSTransport e)
+{
+  if (e == ExperimentConfiguration::FastDDSTransport::UDP) {
+    return "UDP";
+  } else if (e == ExperimentConfiguration::FastDDSTransport::SHM) {
+    return "SHM";
+  } else {
+    return "DEFAULT";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::FastDDSTransport & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::OpenDDSTransport e)
+{
+  if (e == ExperimentConfiguration::OpenDDSTransport::SHMEM) {
+    return "shmem";
+  } else if (e == ExperimentConfiguration::OpenDDSTransport::TCP) {
+    return "tcp";
+  } else {
+    return "rtps_udp";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::OpenDDSTransport & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::DeliveryMode e)
+{
+  if (e == ExperimentConfiguration::DeliveryMode::LISTENER) {
+    return "LISTENER";
+  } else {
+    return "WAITSET";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::DeliveryMode & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::ShmRingWakeup e)
+{
+  if (e == ExperimentConfiguration::ShmRingWakeup::BUSY_POLL) {
+    return "BUSY_POLL";
+  } else if (e == ExperimentConfiguration::ShmRingWakeup::FUTEX) {
+    return "FUTEX";
+  } else if (e == ExperimentConfiguration::ShmRingWakeup::EVENTFD) {
+    return "EVENTFD";
+  } else if (e == ExperimentConfiguration::ShmRingWakeup::SEMAPHORE) {
+    return "SEMAPHORE";
+  } else if (e == ExperimentConfiguration::ShmRingWakeup::COND_VAR) {
+    return "COND_VAR";
+  } else {
+    return "PIPE";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::ShmRingWakeup & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::IntraQueueTransfer e)
+{
+  if (e == ExperimentConfiguration::IntraQueueTransfer::SHARED_PTR) {
+    return "SHARED_PTR";
+  } else {
+    return "COPY";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::IntraQueueTransfer & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::StreamSocket e)
+{
+  if (e == ExperimentConfiguration::StreamSocket::TCP) {
+    return "TCP";
+  } else {
+    return "UDS";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::StreamSocket & e)
+{
+  return stream << to_string(e);
+}
+
+std::string to_string(const ExperimentConfiguration::StreamBackend e)
+{
+  if (e == ExperimentConfiguration::StreamBackend::EPOLL) {
+    return "EPOLL";
+  } else if (e == ExperimentConfiguration::StreamBackend::IO_URING) {
+    return "IO_URING";
+  } else {
+    return "BLOCKING";
+  }
+}
+
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::StreamBackend & e)
+{
+  return stream << to_string(e);
+}
+
 std::ostream & operator<<(std::ostream & stream, const ExperimentConfiguration & e)
 {
   if (e.is_setup()) {
@@ -78,6 +237,33 @@ std::ostream & operator<<(std::ostream & stream, const ExperimentConfiguration &
            "\nZero copy transfer: " << e.is_zero_copy_transfer() <<
            "\nUnbounded message size: " << e.unbounded_msg_size() <<
            "\nRoundtrip Mode: " << e.roundtrip_mode() <<
+           "\nIntra-process ownership: " << e.intra_process_ownership() <<
+           "\nExecutor threads: " << e.executor_threads() <<
+           "\nCallback groups: " << e.callback_group_mode() <<
+           "\nFast DDS transport: " << e.fastdds_transport() <<
+           "\nOpenDDS transport: " << e.opendds_transport() <<
+           "\nSHM history depth: " << e.shm_history_depth() <<
+           "\nMax samples per take: " << e.max_samples_per_take() <<
+           "\nDelivery mode: " << e.delivery_mode() <<
+           "\niceoryx introspection: " << e.iceoryx_introspection() <<
+           "\nConnext Micro SHMEM message count: " << e.connext_micro_shmem_message_count() <<
+           "\nConnext Micro SHMEM buffer size: " << e.connext_micro_shmem_buffer_size() <<
+           "\nSHM ring slots: " << e.shm_ring_slots() <<
+           "\nSHM ring payload size: " << e.shm_ring_payload_size() <<
+           "\nSHM ring wakeup: " << e.shm_ring_wakeup() <<
+           "\nIntra queue depth: " << e.intra_queue_depth() <<
+           "\nIntra queue transfer: " << e.intra_queue_transfer() <<
+           "\nUDP raw port: " << e.udp_raw_port() <<
+           "\nUDP raw datagram size: " << e.udp_raw_datagram_size() <<
+           "\nUDP raw send buffer: " << e.udp_raw_sndbuf() <<
+           "\nUDP raw receive buffer: " << e.udp_raw_rcvbuf() <<
+           "\nUDP raw offload: " << e.udp_raw_offload() <<
+           "\nStream socket: " << e.stream_socket() <<
+           "\nStream backend: " << e.stream_backend() <<
+           "\nStream port: " << e.stream_port() <<
+           "\nThread rules: " << e.thread_rules() <<
+           "\nSample run delay: " << e.sample_run_delay() <<
+           "\nHarness floor (main thread): " << e.harness_floor() <<
            "\nIgnore seconds from beginning: " << e.rows_to_ignore();
   } else {
     return stream << "ERROR: Experiment is not yet setup!";
@@ -99,7 +285,33 @@ ExperimentConfiguration::ExperimentConfiguration()
   m_check_memory(false),
   m_is_rt_init_required(false),
   m_is_zero_copy_transfer(false),
-  m_roundtrip_mode(RoundTripMode::NONE)
+  m_roundtrip_mode(RoundTripMode::NONE),
+  m_intra_process_ownership(IntraProcessOwnership::UNIQUE),
+  m_executor_threads(),
+  m_callback_group_mode(CallbackGroupMode::PER_SUBSCRIPTION),
+  m_fastdds_transport(FastDDSTransport::DEFAULT),
+  m_opendds_transport(OpenDDSTransport::RTPS_UDP),
+  m_shm_history_depth(),
+  m_max_samples_per_take(),
+  m_delivery_mode(DeliveryMode::WAITSET),
+  m_iceoryx_introspection(false),
+  m_connext_micro_shmem_message_count(),
+  m_connext_micro_shmem_buffer_size(),
+  m_shm_ring_slots(),
+  m_shm_ring_payload_size(),
+  m_shm_ring_wakeup(ShmRingWakeup::FUTEX),
+  m_intra_queue_depth(),
+  m_intra_queue_transfer(IntraQueueTransfer::COPY),
+  m_udp_raw_port(),
+  m_udp_raw_datagram_size(),
+  m_udp_raw_sndbuf(),
+  m_udp_raw_rcvbuf(),
+  m_udp_raw_offload(true),
+  m_stream_socket(StreamSocket::UDS),
+  m_stream_backend(StreamBackend::BLOCKING),
+  m_stream_port(),
+  m_sample_run_delay(false),
+  m_measure_harness_floor(false)
 {}
 
 void ExperimentConfiguration::setup(int argc, char ** argv)
@@ -114,6 +326,16 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
   int32_t prio = 0;
   uint32_t cpus = 0;
   std::string roundtrip_mode_str;
+  std::string intra_process_ownership_str;
+  std::string callback_group_mode_str;
+  std::string fastdds_transport_str;
+  std::string opendds_transport_str;
+  std::string delivery_mode_str;
+  std::string shm_ring_wakeup_str;
+  std::string intra_queue_transfer_str;
+  std::string stream_socket_str;
+  std::string stream_backend_str;
+  std::vector<std::string> thread_rule_strs;
   try {
     TCLAP::CmdLine cmd("Apex.AI performance_test");
 
@@ -138,9 +360,19 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
     allowedCommunications.push_back("rclcpp-single-threaded-executor");
     allowedCommunications.push_back("rclcpp-static-single-threaded-executor");
     allowedCommunications.push_back("rclcpp-waitset");
+    allowedCommunications.push_back("rclcpp-intra-process");
+    allowedCommunications.push_back("rclcpp-intra-process-static-single-threaded-executor");
+    allowedCommunications.push_back("rclcpp-intra-process-events-executor");
+    allowedCommunications.push_back("rclcpp-intra-process-multi-threaded-executor");
+    allowedCommunications.push_back("rclcpp-serialized");
+    allowedCommunications.push_back("rclcpp-generic");
+    allowedCommunications.push_back("rclcpp-events-executor");
+    allowedCommunications.push_back("rclcpp-multi-threaded-executor");
+    allowedCommunications.push_back("rclcpp-type-adapter");
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
     allowedCommunications.push_back("FastRTPS");
+    allowedCommunications.push_back("FastDDS");
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
     allowedCommunications.push_back("ConnextDDSMicro");
@@ -159,6 +391,21 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
 #endif
 #ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
     allowedCommunications.push_back("OpenDDS");
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    allowedCommunications.push_back("shm-ring");
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+    allowedCommunications.push_back("intra-queue");
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    allowedCommunications.push_back("udp-raw");
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    allowedCommunications.push_back("stream");
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+    allowedCommunications.push_back("null");
 #endif
     TCLAP::ValuesConstraint<std::string> allowedCommunicationVals(allowedCommunications);
     TCLAP::ValueArg<std::string> communicationArg("c", "communication",
@@ -215,6 +462,22 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
       "Only certain platforms (i.e. Drive PX) have the right configuration to support this.",
       false, 0, "N", cmd);
 
+    TCLAP::MultiArg<std::string> threadRuleArg("", "thread-rule",
+      "Place the threads whose name matches PATTERN, including the threads of the middleware, "
+      "on the comma separated CPUS and at the SCHED_FIFO priority PRIO, for example "
+      "'dq\\.recvUniq=3:80'. Applied after the entities are created and to every thread which "
+      "appears later. Repeat the argument for several rules, the first matching rule applies.",
+      false, "PATTERN=CPUS[:PRIO]", cmd);
+
+    TCLAP::SwitchArg sampleRunDelayArg("", "sample-run-delay",
+      "Sample the time the subscriber threads wait in the run queue for a CPU after every wakeup. "
+      "Adds a read of /proc to every wakeup. Only supported on Linux.", cmd, false);
+
+    TCLAP::SwitchArg measureHarnessFloorArg("", "measure-harness-floor",
+      "Measure the latency and CPU time perf_test itself adds to every sample with the null "
+      "plugin before the experiment. Takes 0.2 s on the main thread, which does not follow the "
+      "thread rules.", cmd, false);
+
     TCLAP::SwitchArg withSecurityArg("", "with-security",
       "Make nodes with deterministic names for use with security.", cmd, false);
 
@@ -243,6 +506,139 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
       "The number of bytes to use for an unbounded message type. Ignored for other messages.",
       false, 0, "N", cmd);
 
+    std::vector<std::string> allowedIntraProcessOwnerships{{"Unique", "Shared"}};
+    TCLAP::ValuesConstraint<std::string> allowedIntraProcessOwnershipVals(
+      allowedIntraProcessOwnerships);
+    TCLAP::ValueArg<std::string> intraProcessOwnershipArg("", "intra-process-ownership",
+      "Select whether rclcpp intra-process subscriptions take unique or shared ownership of the "
+      "received messages. Ignored for other communication means.", false, "Unique",
+      &allowedIntraProcessOwnershipVals, cmd);
+
+    TCLAP::ValueArg<uint32_t> executorThreadsArg("", "executor-threads",
+      "The number of threads of the rclcpp multi-threaded executor. 0 means one thread per CPU "
+      "core. Ignored for other communication means.", false, 0, "N", cmd);
+
+    std::vector<std::string> allowedCallbackGroupModes{{"PerSubscription", "Shared"}};
+    TCLAP::ValuesConstraint<std::string> allowedCallbackGroupModeVals(allowedCallbackGroupModes);
+    TCLAP::ValueArg<std::string> callbackGroupsArg("", "callback-groups",
+      "Select whether the subscriptions on the rclcpp events or multi-threaded executor get one "
+      "callback group each or share a single callback group. Ignored for other communication "
+      "means.", false, "PerSubscription", &allowedCallbackGroupModeVals, cmd);
+
+    std::vector<std::string> allowedFastDDSTransports{{"Default", "UDP", "SHM"}};
+    TCLAP::ValuesConstraint<std::string> allowedFastDDSTransportVals(allowedFastDDSTransports);
+    TCLAP::ValueArg<std::string> fastddsTransportArg("", "fastdds-transport",
+      "Select the transport of the Fast DDS participant. Default uses the builtin transports. "
+      "Ignored for other communication means.", false, "Default",
+      &allowedFastDDSTransportVals, cmd);
+
+    std::vector<std::string> allowedOpenDDSTransports{{"rtps_udp", "shmem", "tcp"}};
+    TCLAP::ValuesConstraint<std::string> allowedOpenDDSTransportVals(allowedOpenDDSTransports);
+    TCLAP::ValueArg<std::string> openddsTransportArg("", "opendds-transport",
+      "Select the transport of the OpenDDS participant. Ignored for other communication means.",
+      false, "rtps_udp", &allowedOpenDDSTransportVals, cmd);
+
+    TCLAP::ValueArg<uint32_t> shmHistoryDepthArg("", "shm-history-depth",
+      "The KEEP_LAST history depth used by Cyclone DDS with zero copy transfer over shared "
+      "memory. This is also the maximum number of samples taken at once. Ignored for other "
+      "communication means.", false, 16, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> maxSamplesPerTakeArg("", "max-samples-per-take",
+      "The maximum number of samples a subscriber takes after a single wakeup. The remaining "
+      "samples are taken after the next wakeup, or in further batches with the Listener "
+      "delivery mode. 0 means unlimited. Not applied by the "
+      "callback based rclcpp communication means.", false, 0, "N", cmd);
+
+    std::vector<std::string> allowedDeliveryModes{{"WaitSet", "Listener"}};
+    TCLAP::ValuesConstraint<std::string> allowedDeliveryModeVals(allowedDeliveryModes);
+    TCLAP::ValueArg<std::string> deliveryModeArg("", "delivery-mode",
+      "Select whether the subscriber of a native plugin waits in a waitset or receives the "
+      "samples in a listener on a middleware thread.", false, "WaitSet",
+      &allowedDeliveryModeVals, cmd);
+
+    TCLAP::SwitchArg iceoryxIntrospectionArg("", "iceoryx-introspection",
+      "Collect the mempool usage and the subscriber queue fill from the RouDi introspection "
+      "and count subscriber queue overflows. Only supported by the iceoryx communication mean.",
+      cmd, false);
+
+    TCLAP::ValueArg<uint32_t> connextMicroShmemMessageCountArg("",
+      "connext-micro-shmem-message-count",
+      "The maximum number of messages the Connext DDS Micro SHMEM transport queues for a "
+      "receiver. Ignored for other communication means.", false, 1024 * 16, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> connextMicroShmemBufferSizeArg("",
+      "connext-micro-shmem-buffer-size",
+      "The size in bytes of the Connext DDS Micro SHMEM receive buffer. Ignored for other "
+      "communication means.", false, 1024 * 1024 * 256, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> shmRingSlotsArg("", "shm-ring-slots",
+      "The number of slots of the shm ring. A subscriber which falls behind by more samples "
+      "loses them. Ignored for other communication means.", false, 64, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> shmRingPayloadSizeArg("", "shm-ring-payload-size",
+      "The payload capacity in bytes of a shm ring slot. 0 means the size of the message. "
+      "Ignored for other communication means.", false, 0, "N", cmd);
+
+    std::vector<std::string> allowedShmRingWakeups{
+      {"BusyPoll", "Futex", "Eventfd", "Semaphore", "CondVar", "Pipe"}};
+    TCLAP::ValuesConstraint<std::string> allowedShmRingWakeupVals(allowedShmRingWakeups);
+    TCLAP::ValueArg<std::string> shmRingWakeupArg("", "shm-ring-wakeup",
+      "Select whether the subscribers of the shm ring busy poll for samples or how the "
+      "publisher wakes them. Ignored for other communication means.", false, "Futex",
+      &allowedShmRingWakeupVals, cmd);
+
+    TCLAP::ValueArg<uint32_t> intraQueueDepthArg("", "intra-queue-depth",
+      "The capacity of the queue of each intra queue subscriber. A sample which finds the queue "
+      "full is lost for this subscriber. Ignored for other communication means.", false, 64, "N",
+      cmd);
+
+    std::vector<std::string> allowedIntraQueueTransfers{{"Copy", "SharedPtr"}};
+    TCLAP::ValuesConstraint<std::string> allowedIntraQueueTransferVals(
+      allowedIntraQueueTransfers);
+    TCLAP::ValueArg<std::string> intraQueueTransferArg("", "intra-queue-transfer",
+      "Select whether the intra queue copies a sample into the queue of every subscriber or "
+      "passes a shared pointer to it. Ignored for other communication means.", false, "Copy",
+      &allowedIntraQueueTransferVals, cmd);
+
+    TCLAP::ValueArg<uint32_t> udpRawPortArg("", "udp-raw-port",
+      "The loopback port the udp-raw subscriber binds. The relay direction of a roundtrip uses "
+      "the next port. Ignored for other communication means.", false, 17000, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> udpRawDatagramSizeArg("", "udp-raw-datagram-size",
+      "The size in bytes of the datagrams udp-raw fragments the samples into, including a "
+      "16 byte fragment header. Ignored for other communication means.", false, 1472, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> udpRawSndbufArg("", "udp-raw-sndbuf",
+      "The SO_SNDBUF size in bytes of the udp-raw publisher socket. 0 keeps the system default. "
+      "Ignored for other communication means.", false, 0, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> udpRawRcvbufArg("", "udp-raw-rcvbuf",
+      "The SO_RCVBUF size in bytes of the udp-raw subscriber socket. 0 keeps the system "
+      "default. Ignored for other communication means.", false, 0, "N", cmd);
+
+    TCLAP::SwitchArg udpRawDisableOffloadArg("", "udp-raw-disable-offload",
+      "Disable UDP segmentation and receive offload for udp-raw, so every datagram passes the "
+      "socket interface on its own. Ignored for other communication means.", cmd, false);
+
+    std::vector<std::string> allowedStreamSockets{{"Uds", "Tcp"}};
+    TCLAP::ValuesConstraint<std::string> allowedStreamSocketVals(allowedStreamSockets);
+    TCLAP::ValueArg<std::string> streamSocketArg("", "stream-socket",
+      "Select whether the stream plugin uses a Unix domain socket or TCP over the loopback "
+      "interface. Ignored for other communication means.", false, "Uds",
+      &allowedStreamSocketVals, cmd);
+
+    std::vector<std::string> allowedStreamBackends{{"Blocking", "Epoll", "IoUring"}};
+    TCLAP::ValuesConstraint<std::string> allowedStreamBackendVals(allowedStreamBackends);
+    TCLAP::ValueArg<std::string> streamBackendArg("", "stream-backend",
+      "Select whether the stream plugin uses blocking calls, epoll or io_uring for the socket "
+      "I/O. Ignored for other communication means.", false, "Blocking",
+      &allowedStreamBackendVals, cmd);
+
+    TCLAP::ValueArg<uint32_t> streamPortArg("", "stream-port",
+      "The loopback port the stream publisher listens on for TCP. The relay direction of a "
+      "roundtrip uses the next port. Ignored for other communication means.", false, 17100, "N",
+      cmd);
+
     cmd.parse(argc, argv);
 
     // default to only stdout output
@@ -289,6 +685,9 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
     m_check_memory = checkMemoryArg.getValue();
     prio = useRtPrioArg.getValue();
     cpus = useRtCpusArg.getValue();
+    thread_rule_strs = threadRuleArg.getValue();
+    m_sample_run_delay = sampleRunDelayArg.getValue();
+    m_measure_harness_floor = measureHarnessFloorArg.getValue();
     m_with_security = withSecurityArg.getValue();
     roundtrip_mode_str = relayModeArg.getValue();
     m_rows_to_ignore = ignoreArg.getValue();
@@ -297,6 +696,30 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
     m_wait_for_matched_timeout = waitForMatchedTimeoutArg.getValue();
     m_is_zero_copy_transfer = zeroCopyArg.getValue();
     m_unbounded_msg_size = unboundedMsgSizeArg.getValue();
+    intra_process_ownership_str = intraProcessOwnershipArg.getValue();
+    m_executor_threads = executorThreadsArg.getValue();
+    callback_group_mode_str = callbackGroupsArg.getValue();
+    fastdds_transport_str = fastddsTransportArg.getValue();
+    opendds_transport_str = openddsTransportArg.getValue();
+    m_shm_history_depth = shmHistoryDepthArg.getValue();
+    m_max_samples_per_take = maxSamplesPerTakeArg.getValue();
+    delivery_mode_str = deliveryModeArg.getValue();
+    m_iceoryx_introspection = iceoryxIntrospectionArg.getValue();
+    m_connext_micro_shmem_message_count = connextMicroShmemMessageCountArg.getValue();
+    m_connext_micro_shmem_buffer_size = connextMicroShmemBufferSizeArg.getValue();
+    m_shm_ring_slots = shmRingSlotsArg.getValue();
+    m_shm_ring_payload_size = shmRingPayloadSizeArg.getValue();
+    shm_ring_wakeup_str = shmRingWakeupArg.getValue();
+    m_intra_queue_depth = intraQueueDepthArg.getValue();
+    intra_queue_transfer_str = intraQueueTransferArg.getValue();
+    m_udp_raw_port = udpRawPortArg.getValue();
+    m_udp_raw_datagram_size = udpRawDatagramSizeArg.getValue();
+    m_udp_raw_sndbuf = udpRawSndbufArg.getValue();
+    m_udp_raw_rcvbuf = udpRawRcvbufArg.getValue();
+    m_udp_raw_offload = !udpRawDisableOffloadArg.getValue();
+    stream_socket_str = streamSocketArg.getValue();
+    stream_backend_str = streamBackendArg.getValue();
+    m_stream_port = streamPortArg.getValue();
   } catch (TCLAP::ArgException & e) {
     std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
   }
@@ -323,11 +746,41 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
     if (comm_str == "rclcpp-waitset") {
       m_com_mean = CommunicationMean::RCLCPP_WAITSET;
     }
+    if (comm_str == "rclcpp-intra-process") {
+      m_com_mean = CommunicationMean::RCLCPP_INTRA_PROCESS;
+    }
+    if (comm_str == "rclcpp-intra-process-static-single-threaded-executor") {
+      m_com_mean = CommunicationMean::RCLCPP_INTRA_PROCESS_STATIC_SINGLE_THREADED_EXECUTOR;
+    }
+    if (comm_str == "rclcpp-intra-process-events-executor") {
+      m_com_mean = CommunicationMean::RCLCPP_INTRA_PROCESS_EVENTS_EXECUTOR;
+    }
+    if (comm_str == "rclcpp-intra-process-multi-threaded-executor") {
+      m_com_mean = CommunicationMean::RCLCPP_INTRA_PROCESS_MULTI_THREADED_EXECUTOR;
+    }
+    if (comm_str == "rclcpp-serialized") {
+      m_com_mean = CommunicationMean::RCLCPP_SERIALIZED;
+    }
+    if (comm_str == "rclcpp-generic") {
+      m_com_mean = CommunicationMean::RCLCPP_GENERIC;
+    }
+    if (comm_str == "rclcpp-events-executor") {
+      m_com_mean = CommunicationMean::RCLCPP_EVENTS_EXECUTOR;
+    }
+    if (comm_str == "rclcpp-multi-threaded-executor") {
+      m_com_mean = CommunicationMean::RCLCPP_MULTI_THREADED_EXECUTOR;
+    }
+    if (comm_str == "rclcpp-type-adapter") {
+      m_com_mean = CommunicationMean::RCLCPP_TYPE_ADAPTER;
+    }
 #endif
 #ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
     if (comm_str == "FastRTPS") {
       m_com_mean = CommunicationMean::FASTRTPS;
     }
+    if (comm_str == "FastDDS") {
+      m_com_mean = CommunicationMean::FASTDDS;
+    }
 #endif
 #ifdef PERFORMANCE_TEST_CONNEXTDDSMICRO_ENABLED
     if (comm_str == "ConnextDDSMicro") {
@@ -359,6 +812,31 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
       m_com_mean = CommunicationMean::OPENDDS;
     }
 #endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    if (comm_str == "shm-ring") {
+      m_com_mean = CommunicationMean::SHM_RING;
+    }
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+    if (comm_str == "intra-queue") {
+      m_com_mean = CommunicationMean::INTRA_QUEUE;
+    }
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    if (comm_str == "udp-raw") {
+      m_com_mean = CommunicationMean::UDP_RAW;
+    }
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    if (comm_str == "stream") {
+      m_com_mean = CommunicationMean::STREAM;
+    }
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+    if (comm_str == "null") {
+      m_com_mean = CommunicationMean::NULL_MAILBOX;
+    }
+#endif
 
     if (reliable_qos) {
       m_qos.reliability = QOSAbstraction::Reliability::RELIABLE;
@@ -400,6 +878,18 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
 #endif
     }
 
+    for (const auto & thread_rule_str : thread_rule_strs) {
+      m_thread_rules.push_back(ThreadRule::parse(thread_rule_str));
+    }
+#if !defined(PERFORMANCE_TEST_LINUX)
+    if (!m_thread_rules.empty()) {
+      throw std::invalid_argument("Thread rules are only supported on Linux");
+    }
+    if (m_sample_run_delay) {
+      throw std::invalid_argument("Sampling the run delay is only supported on Linux");
+    }
+#endif
+
     if (m_with_security) {
       if (!use_ros2_layers()) {
         throw std::invalid_argument("Only ROS2 supports security!");
@@ -425,7 +915,216 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
       throw std::invalid_argument("Invalid roundtrip mode: " + mode);
     }
 
+    if (intra_process_ownership_str == "Unique") {
+      m_intra_process_ownership = IntraProcessOwnership::UNIQUE;
+    } else if (intra_process_ownership_str == "Shared") {
+      m_intra_process_ownership = IntraProcessOwnership::SHARED;
+    } else {
+      throw std::invalid_argument(
+              "Invalid intra-process ownership: " + intra_process_ownership_str);
+    }
+
+    if (callback_group_mode_str == "PerSubscription") {
+      m_callback_group_mode = CallbackGroupMode::PER_SUBSCRIPTION;
+    } else if (callback_group_mode_str == "Shared") {
+      m_callback_group_mode = CallbackGroupMode::SHARED;
+    } else {
+      throw std::invalid_argument("Invalid callback group mode: " + callback_group_mode_str);
+    }
+
+    if (fastdds_transport_str == "Default") {
+      m_fastdds_transport = FastDDSTransport::DEFAULT;
+    } else if (fastdds_transport_str == "UDP") {
+      m_fastdds_transport = FastDDSTransport::UDP;
+    } else if (fastdds_transport_str == "SHM") {
+      m_fastdds_transport = FastDDSTransport::SHM;
+    } else {
+      throw std::invalid_argument("Invalid Fast DDS transport: " + fastdds_transport_str);
+    }
+
+    if (opendds_transport_str == "rtps_udp") {
+      m_opendds_transport = OpenDDSTransport::RTPS_UDP;
+    } else if (opendds_transport_str == "shmem") {
+      m_opendds_transport = OpenDDSTransport::SHMEM;
+    } else if (opendds_transport_str == "tcp") {
+      m_opendds_transport = OpenDDSTransport::TCP;
+    } else {
+      throw std::invalid_argument("Invalid OpenDDS transport: " + opendds_transport_str);
+    }
+
+    if (m_shm_history_depth == 0) {
+      throw std::invalid_argument("The SHM history depth must be greater than 0!");
+    }
+
+    if (delivery_mode_str == "WaitSet") {
+      m_delivery_mode = DeliveryMode::WAITSET;
+    } else if (delivery_mode_str == "Listener") {
+      m_delivery_mode = DeliveryMode::LISTENER;
+    } else {
+      throw std::invalid_argument("Invalid delivery mode: " + delivery_mode_str);
+    }
+    if (m_delivery_mode == DeliveryMode::LISTENER) {
+      if (use_ros2_layers()) {
+        throw std::invalid_argument("Listener delivery is only supported by the native plugins!");
+      }
+#ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
+      if (m_com_mean == CommunicationMean::FASTRTPS) {
+        throw std::invalid_argument("Listener delivery requires the FastDDS plugin!");
+      }
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+      if (m_com_mean == CommunicationMean::SHM_RING) {
+        throw std::invalid_argument("Listener delivery is not supported by the shm ring!");
+      }
+#endif
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+      if (m_com_mean == CommunicationMean::INTRA_QUEUE) {
+        throw std::invalid_argument("Listener delivery is not supported by the intra queue!");
+      }
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+      if (m_com_mean == CommunicationMean::UDP_RAW) {
+        throw std::invalid_argument("Listener delivery is not supported by udp-raw!");
+      }
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+      if (m_com_mean == CommunicationMean::STREAM) {
+        throw std::invalid_argument("Listener delivery is not supported by the stream plugin!");
+      }
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+      if (m_com_mean == CommunicationMean::NULL_MAILBOX) {
+        throw std::invalid_argument("Listener delivery is not supported by the null plugin!");
+      }
+#endif
+    }
+
+    if (m_iceoryx_introspection) {
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+      if (m_com_mean != CommunicationMean::ICEORYX) {
+        throw std::invalid_argument("iceoryx introspection requires the iceoryx plugin!");
+      }
+#else
+      throw std::invalid_argument("Built with the iceoryx plugin disabled");
+#endif
+    }
+
+    const uint32_t max_connext_micro_shmem_limit = std::numeric_limits<int32_t>::max();
+    if (m_connext_micro_shmem_message_count == 0 || m_connext_micro_shmem_buffer_size == 0 ||
+      m_connext_micro_shmem_message_count > max_connext_micro_shmem_limit ||
+      m_connext_micro_shmem_buffer_size > max_connext_micro_shmem_limit)
+    {
+      throw std::invalid_argument(
+              "The Connext DDS Micro SHMEM limits must be between 1 and " +
+              std::to_string(max_connext_micro_shmem_limit) + "!");
+    }
+
+    if (m_shm_ring_slots == 0) {
+      throw std::invalid_argument("The shm ring requires at least one slot!");
+    }
+    if (shm_ring_wakeup_str == "BusyPoll") {
+      m_shm_ring_wakeup = ShmRingWakeup::BUSY_POLL;
+    } else if (shm_ring_wakeup_str == "Futex") {
+      m_shm_ring_wakeup = ShmRingWakeup::FUTEX;
+    } else if (shm_ring_wakeup_str == "Eventfd") {
+      m_shm_ring_wakeup = ShmRingWakeup::EVENTFD;
+    } else if (shm_ring_wakeup_str == "Semaphore") {
+      m_shm_ring_wakeup = ShmRingWakeup::SEMAPHORE;
+    } else if (shm_ring_wakeup_str == "CondVar") {
+      m_shm_ring_wakeup = ShmRingWakeup::COND_VAR;
+    } else if (shm_ring_wakeup_str == "Pipe") {
+      m_shm_ring_wakeup = ShmRingWakeup::PIPE;
+    } else {
+      throw std::invalid_argument("Invalid shm ring wakeup: " + shm_ring_wakeup_str);
+    }
+
+    if (m_intra_queue_depth == 0) {
+      throw std::invalid_argument("The intra queue depth must be greater than 0!");
+    }
+    if (intra_queue_transfer_str == "Copy") {
+      m_intra_queue_transfer = IntraQueueTransfer::COPY;
+    } else if (intra_queue_transfer_str == "SharedPtr") {
+      m_intra_queue_transfer = IntraQueueTransfer::SHARED_PTR;
+    } else {
+      throw std::invalid_argument("Invalid intra queue transfer: " + intra_queue_transfer_str);
+    }
+#ifdef PERFORMANCE_TEST_INTRA_QUEUE_ENABLED
+    if (m_com_mean == CommunicationMean::INTRA_QUEUE) {
+      if (m_number_of_publishers == 0 || m_number_of_subscribers == 0) {
+        throw std::invalid_argument(
+                "The intra queue requires publishers and subscribers in the same process!");
+      }
+      if (m_roundtrip_mode != RoundTripMode::NONE) {
+        throw std::invalid_argument("The intra queue does not support a roundtrip!");
+      }
+    }
+#endif
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+    if (m_com_mean == CommunicationMean::NULL_MAILBOX) {
+      if (m_number_of_publishers != 1 || m_number_of_subscribers != 1) {
+        throw std::invalid_argument(
+                "The null plugin requires one publisher and one subscriber in the same process!");
+      }
+      if (m_roundtrip_mode != RoundTripMode::NONE) {
+        throw std::invalid_argument("The null plugin does not support a roundtrip!");
+      }
+    }
+#endif
+
+    if (m_udp_raw_port == 0 || m_udp_raw_port >= std::numeric_limits<uint16_t>::max()) {
+      throw std::invalid_argument(
+              "The udp-raw port must be between 1 and " +
+              std::to_string(std::numeric_limits<uint16_t>::max() - 1) + "!");
+    }
+    if (m_udp_raw_datagram_size < 64 || m_udp_raw_datagram_size > 65507) {
+      throw std::invalid_argument("The udp-raw datagram size must be between 64 and 65507!");
+    }
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    if (m_com_mean == CommunicationMean::UDP_RAW && m_number_of_subscribers > 1) {
+      throw std::invalid_argument("udp-raw supports only a single subscriber per topic!");
+    }
+#endif
+
+    if (stream_socket_str == "Uds") {
+      m_stream_socket = StreamSocket::UDS;
+    } else if (stream_socket_str == "Tcp") {
+      m_stream_socket = StreamSocket::TCP;
+    } else {
+      throw std::invalid_argument("Invalid stream socket: " + stream_socket_str);
+    }
+    if (stream_backend_str == "Blocking") {
+      m_stream_backend = StreamBackend::BLOCKING;
+    } else if (stream_backend_str == "Epoll") {
+      m_stream_backend = StreamBackend::EPOLL;
+    } else if (stream_backend_str == "IoUring") {
+      m_stream_backend = StreamBackend::IO_URING;
+    } else {
+      throw std::invalid_argument("Invalid stream backend: " + stream_backend_str);
+    }
+    if (m_stream_port == 0 || m_stream_port >= std::numeric_limits<uint16_t>::max()) {
+      throw std::invalid_argument(
+              "The stream port must be between 1 and " +
+              std::to_string(std::numeric_limits<uint16_t>::max() - 1) + "!");
+    }
+
 #ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+    if (is_rclcpp_intra_process(m_com_mean)) {
+      if (m_number_of_publishers == 0 || m_number_of_subscribers == 0) {
+        throw std::invalid_argument(
+                "Intra-process communication requires publishers and subscribers "
+                "in the same process!");
+      }
+      if (m_qos.history_kind != QOSAbstraction::HistoryKind::KEEP_LAST) {
+        throw std::invalid_argument("Intra-process communication requires keep last QOS!");
+      }
+    }
+    if (m_com_mean == CommunicationMean::RCLCPP_TYPE_ADAPTER && use_rclcpp_intra_process_comms() &&
+      m_qos.history_kind != QOSAbstraction::HistoryKind::KEEP_LAST)
+    {
+      throw std::invalid_argument(
+              "Type adaptation with publishers and subscribers in the same process uses "
+              "intra-process communication, which requires keep last QOS!");
+    }
     m_rmw_implementation = rmw_get_implementation_identifier();
 #else
     m_rmw_implementation = "N/A";
@@ -448,6 +1147,11 @@ void ExperimentConfiguration::setup(int argc, char ** argv)
     }
 
     m_is_setup = true;
+
+    // The communicators used for the measurement require the configuration to be set up.
+    if (m_measure_harness_floor) {
+      m_harness_floor = HarnessFloor::measure();
+    }
   } catch (const std::exception & e) {
     std::cerr << "ERROR: ";
     std::cerr << e.what() << std::endl;
@@ -469,13 +1173,32 @@ bool ExperimentConfiguration::use_ros2_layers() const
 #ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
   if (m_com_mean == CommunicationMean::RCLCPP_SINGLE_THREADED_EXECUTOR ||
     m_com_mean == CommunicationMean::RCLCPP_STATIC_SINGLE_THREADED_EXECUTOR ||
-    m_com_mean == CommunicationMean::RCLCPP_WAITSET)
+    m_com_mean == CommunicationMean::RCLCPP_WAITSET ||
+    is_rclcpp_intra_process(m_com_mean) ||
+    m_com_mean == CommunicationMean::RCLCPP_SERIALIZED ||
+    m_com_mean == CommunicationMean::RCLCPP_GENERIC ||
+    m_com_mean == CommunicationMean::RCLCPP_EVENTS_EXECUTOR ||
+    m_com_mean == CommunicationMean::RCLCPP_MULTI_THREADED_EXECUTOR ||
+    m_com_mean == CommunicationMean::RCLCPP_TYPE_ADAPTER)
   {
     return true;
   }
 #endif
   return false;
 }
+bool ExperimentConfiguration::use_rclcpp_intra_process_comms() const
+{
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  if (is_rclcpp_intra_process(m_com_mean)) {
+    return true;
+  }
+  if (m_com_mean == CommunicationMean::RCLCPP_TYPE_ADAPTER) {
+    return m_number_of_publishers > 0 && m_number_of_subscribers > 0 &&
+           m_roundtrip_mode == RoundTripMode::NONE;
+  }
+#endif
+  return false;
+}
 uint32_t ExperimentConfiguration::dds_domain_id() const
 {
   check_setup();
@@ -569,6 +1292,163 @@ ExperimentConfiguration::RoundTripMode ExperimentConfiguration::roundtrip_mode()
   return m_roundtrip_mode;
 }
 
+ExperimentConfiguration::IntraProcessOwnership
+ExperimentConfiguration::intra_process_ownership() const
+{
+  check_setup();
+  return m_intra_process_ownership;
+}
+
+uint32_t ExperimentConfiguration::executor_threads() const
+{
+  check_setup();
+  return m_executor_threads;
+}
+
+ExperimentConfiguration::CallbackGroupMode ExperimentConfiguration::callback_group_mode() const
+{
+  check_setup();
+  return m_callback_group_mode;
+}
+
+ExperimentConfiguration::FastDDSTransport ExperimentConfiguration::fastdds_transport() const
+{
+  check_setup();
+  return m_fastdds_transport;
+}
+
+ExperimentConfiguration::OpenDDSTransport ExperimentConfiguration::opendds_transport() const
+{
+  check_setup();
+  return m_opendds_transport;
+}
+
+uint32_t ExperimentConfiguration::shm_history_depth() const
+{
+  check_setup();
+  return m_shm_history_depth;
+}
+
+uint32_t ExperimentConfiguration::max_samples_per_take() const
+{
+  check_setup();
+  return m_max_samples_per_take;
+}
+
+ExperimentConfiguration::DeliveryMode ExperimentConfiguration::delivery_mode() const
+{
+  check_setup();
+  return m_delivery_mode;
+}
+
+bool ExperimentConfiguration::iceoryx_introspection() const
+{
+  check_setup();
+  return m_iceoryx_introspection;
+}
+
+uint32_t ExperimentConfiguration::connext_micro_shmem_message_count() const
+{
+  check_setup();
+  return m_connext_micro_shmem_message_count;
+}
+
+uint32_t ExperimentConfiguration::connext_micro_shmem_buffer_size() const
+{
+  check_setup();
+  return m_connext_micro_shmem_buffer_size;
+}
+
+uint32_t ExperimentConfiguration::shm_ring_slots() const
+{
+  check_setup();
+  return m_shm_ring_slots;
+}
+
+uint32_t ExperimentConfiguration::shm_ring_payload_size() const
+{
+  check_setup();
+  return m_shm_ring_payload_size;
+}
+
+ExperimentConfiguration::ShmRingWakeup ExperimentConfiguration::shm_ring_wakeup() const
+{
+  check_setup();
+  return m_shm_ring_wakeup;
+}
+
+uint32_t ExperimentConfiguration::intra_queue_depth() const
+{
+  check_setup();
+  return m_intra_queue_depth;
+}
+
+ExperimentConfiguration::IntraQueueTransfer ExperimentConfiguration::intra_queue_transfer() const
+{
+  check_setup();
+  return m_intra_queue_transfer;
+}
+
+uint32_t ExperimentConfiguration::udp_raw_port() const
+{
+  check_setup();
+  return m_udp_raw_port;
+}
+
+uint32_t ExperimentConfiguration::udp_raw_datagram_size() const
+{
+  check_setup();
+  return m_udp_raw_datagram_size;
+}
+
+uint32_t ExperimentConfiguration::udp_raw_sndbuf() const
+{
+  check_setup();
+  return m_udp_raw_sndbuf;
+}
+
+uint32_t ExperimentConfiguration::udp_raw_rcvbuf() const
+{
+  check_setup();
+  return m_udp_raw_rcvbuf;
+}
+
+bool ExperimentConfiguration::udp_raw_offload() const
+{
+  check_setup();
+  return m_udp_raw_offload;
+}
+
+ExperimentConfiguration::StreamSocket ExperimentConfiguration::stream_socket() const
+{
+  check_setup();
+  return m_stream_socket;
+}
+
+ExperimentConfiguration::StreamBackend ExperimentConfiguration::stream_backend() const
+{
+  check_setup();
+  return m_stream_backend;
+}
+
+uint32_t ExperimentConfiguration::stream_port() const
+{
+  check_setup();
+  return m_stream_port;
+}
+
+std::vector<ThreadRule> ExperimentConfiguration::thread_rules() const
+{
+  check_setup();
+  return m_thread_rules;
+}
+
+bool ExperimentConfiguration::sample_run_delay() const
+{
+  check_setup();
+  return m_sample_run_delay;
+}
+
 std::string ExperimentConfiguration::rmw_implementation() const
 {
   check_setup();
@@ -580,6 +1460,12 @@ std::string ExperimentConfiguration::perf_test_version() const
   return m_perf_test_version;
 }
 
+HarnessFloor ExperimentConfiguration::harness_floor() const
+{
+  check_setup();
+  return m_harness_floor;
+}
+
 std::string ExperimentConfiguration::pub_topic_postfix() const
 {
   check_setup();
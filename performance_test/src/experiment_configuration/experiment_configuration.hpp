@@ -24,6 +24,8 @@
 #include "qos_abstraction.hpp"
 #include "communication_mean.hpp"
 #include "../outputs/output.hpp"
+#include "../experiment_execution/harness_floor.hpp"
+#include "../utilities/thread_rules.hpp"
 
 #if PERFORMANCE_TEST_RT_ENABLED
 #include "../utilities/rt_enabler.hpp"
@@ -66,6 +68,76 @@ public:
     RELAY  /// Relays packages from MAIN back to MAIN.
   };
 
+  /// Specifies how rclcpp intra-process subscriptions take ownership of the received messages.
+  enum class IntraProcessOwnership
+  {
+    UNIQUE,  /// The subscription callback takes a std::unique_ptr.
+    SHARED   /// The subscription callback takes a std::shared_ptr to a const message.
+  };
+
+  /// Specifies how subscriptions on a shared rclcpp executor are assigned to callback groups.
+  enum class CallbackGroupMode
+  {
+    PER_SUBSCRIPTION,  /// Every subscription gets its own mutually exclusive callback group.
+    SHARED             /// All subscriptions share one mutually exclusive callback group.
+  };
+
+  /// Specifies the transport of the Fast DDS participant.
+  enum class FastDDSTransport
+  {
+    DEFAULT,  /// The builtin transports of Fast DDS.
+    UDP,      /// Only the UDPv4 transport.
+    SHM       /// Only the shared memory transport.
+  };
+
+  /// Specifies the transport of the OpenDDS participant.
+  enum class OpenDDSTransport
+  {
+    RTPS_UDP,  /// RTPS over UDP on the loopback interface.
+    SHMEM,     /// Shared memory, only between processes on the same host.
+    TCP        /// TCP on the loopback interface.
+  };
+
+  /// Specifies how the native plugins are notified about received samples.
+  enum class DeliveryMode
+  {
+    WAITSET,  /// The subscriber thread blocks in a waitset and takes the samples.
+    LISTENER  /// A listener takes the samples on a thread of the middleware.
+  };
+
+  /// Specifies how the subscribers of the shm ring wait for samples.
+  enum class ShmRingWakeup
+  {
+    BUSY_POLL,  /// The subscriber spins on the sequence number of the next slot.
+    FUTEX,      /// The subscriber sleeps on a futex which the publisher wakes.
+    EVENTFD,    /// The subscriber polls its eventfd which the publisher writes.
+    SEMAPHORE,  /// The subscriber waits on its POSIX semaphore which the publisher posts.
+    COND_VAR,   /// The subscriber waits on a condition variable which the publisher signals.
+    PIPE        /// The subscriber polls its pipe which the publisher writes.
+  };
+
+  /// Specifies how the intra queue passes a sample to the subscribers.
+  enum class IntraQueueTransfer
+  {
+    COPY,       /// The sample is copied into the queue of every subscriber.
+    SHARED_PTR  /// A std::shared_ptr to the sample is passed to every subscriber.
+  };
+
+  /// Specifies the socket type of the stream plugin.
+  enum class StreamSocket
+  {
+    UDS,  /// A Unix domain socket.
+    TCP   /// A TCP connection over the loopback interface.
+  };
+
+  /// Specifies how the stream plugin does the socket I/O.
+  enum class StreamBackend
+  {
+    BLOCKING,  /// Blocking send and read calls.
+    EPOLL,     /// Non-blocking sockets which wait in epoll_wait.
+    IO_URING   /// io_uring with a registered send buffer and a multishot receive.
+  };
+
   /// Specfies the supported output implementations.
   enum class SupportedOutput
   {
@@ -88,6 +160,10 @@ public:
   CommunicationMean com_mean() const;
   /// \returns Returns whether the ROS 2 layers are used by the communication mean.
   bool use_ros2_layers() const;
+  /// \returns Returns whether the ROS 2 node is created with intra-process communication enabled.
+  /// This is the case for rclcpp-intra-process, and for rclcpp-type-adapter when the publishers
+  /// and subscribers run in the same process without a roundtrip.
+  bool use_rclcpp_intra_process_comms() const;
   /// \returns Returns the configured DDS domain ID. This will throw if the experiment
   /// configuration is not set up.
   uint32_t dds_domain_id() const;
@@ -138,12 +214,93 @@ public:
   bool is_zero_copy_transfer() const;
   /// \returns Returns the roundtrip mode.
   RoundTripMode roundtrip_mode() const;
+  /// \returns Returns the message ownership of rclcpp intra-process subscriptions. This will
+  /// throw if the experiment configuration is not set up.
+  IntraProcessOwnership intra_process_ownership() const;
+  /// \returns Returns the number of threads of the rclcpp multi-threaded executor, where 0 means
+  /// one thread per CPU core. This will throw if the experiment configuration is not set up.
+  uint32_t executor_threads() const;
+  /// \returns Returns how subscriptions on a shared rclcpp executor are assigned to callback
+  /// groups. This will throw if the experiment configuration is not set up.
+  CallbackGroupMode callback_group_mode() const;
+  /// \returns Returns the transport of the Fast DDS participant. This will throw if the
+  /// experiment configuration is not set up.
+  FastDDSTransport fastdds_transport() const;
+  /// \returns Returns the transport of the OpenDDS participant. This will throw if the
+  /// experiment configuration is not set up.
+  OpenDDSTransport opendds_transport() const;
+  /// \returns Returns the KEEP_LAST history depth used for shared memory delivery in Cyclone DDS.
+  /// This will throw if the experiment configuration is not set up.
+  uint32_t shm_history_depth() const;
+  /// \returns Returns the maximum number of samples taken after a single wakeup, 0 meaning
+  /// unlimited. This will throw if the experiment configuration is not set up.
+  uint32_t max_samples_per_take() const;
+  /// \returns Returns how the native plugins are notified about received samples. This will
+  /// throw if the experiment configuration is not set up.
+  DeliveryMode delivery_mode() const;
+  /// \returns Returns if the RouDi mempool and port introspection is collected. This will throw
+  /// if the experiment configuration is not set up.
+  bool iceoryx_introspection() const;
+  /// \returns Returns the maximum number of messages the Connext DDS Micro SHMEM transport
+  /// queues for a receiver. This will throw if the experiment configuration is not set up.
+  uint32_t connext_micro_shmem_message_count() const;
+  /// \returns Returns the size in bytes of the Connext DDS Micro SHMEM receive buffer. This will
+  /// throw if the experiment configuration is not set up.
+  uint32_t connext_micro_shmem_buffer_size() const;
+  /// \returns Returns the number of slots of the shm ring. This will throw if the experiment
+  /// configuration is not set up.
+  uint32_t shm_ring_slots() const;
+  /// \returns Returns the payload capacity in bytes of a shm ring slot, 0 meaning the size of the
+  /// message. This will throw if the experiment configuration is not set up.
+  uint32_t shm_ring_payload_size() const;
+  /// \returns Returns how the subscribers of the shm ring wait for samples. This will throw if
+  /// the experiment configuration is not set up.
+  ShmRingWakeup shm_ring_wakeup() const;
+  /// \returns Returns the capacity of the queue of each intra queue subscriber. This will throw
+  /// if the experiment configuration is not set up.
+  uint32_t intra_queue_depth() const;
+  /// \returns Returns how the intra queue passes a sample to the subscribers. This will throw if
+  /// the experiment configuration is not set up.
+  IntraQueueTransfer intra_queue_transfer() const;
+  /// \returns Returns the loopback port the udp-raw subscriber binds. This will throw if the
+  /// experiment configuration is not set up.
+  uint32_t udp_raw_port() const;
+  /// \returns Returns the size in bytes of the datagrams udp-raw sends, including the fragment
+  /// header. This will throw if the experiment configuration is not set up.
+  uint32_t udp_raw_datagram_size() const;
+  /// \returns Returns the SO_SNDBUF size of the udp-raw publisher socket, 0 meaning the system
+  /// default. This will throw if the experiment configuration is not set up.
+  uint32_t udp_raw_sndbuf() const;
+  /// \returns Returns the SO_RCVBUF size of the udp-raw subscriber socket, 0 meaning the system
+  /// default. This will throw if the experiment configuration is not set up.
+  uint32_t udp_raw_rcvbuf() const;
+  /// \returns Returns whether udp-raw uses UDP segmentation and receive offload if the kernel
+  /// supports it. This will throw if the experiment configuration is not set up.
+  bool udp_raw_offload() const;
+  /// \returns Returns the socket type of the stream plugin. This will throw if the experiment
+  /// configuration is not set up.
+  StreamSocket stream_socket() const;
+  /// \returns Returns how the stream plugin does the socket I/O. This will throw if the
+  /// experiment configuration is not set up.
+  StreamBackend stream_backend() const;
+  /// \returns Returns the loopback port the stream publisher listens on for TCP. This will throw
+  /// if the experiment configuration is not set up.
+  uint32_t stream_port() const;
+  /// \returns Returns the rules which place threads on CPUs and at a priority by their name.
+  /// This will throw if the experiment configuration is not set up.
+  std::vector<ThreadRule> thread_rules() const;
+  /// \returns Returns if the run queue delay of the subscriber threads is sampled after every
+  /// wakeup. This will throw if the experiment configuration is not set up.
+  bool sample_run_delay() const;
   /// \returns Returns current rmw_implementation. This will throw if the experiment configuration
   /// is not set up.
   std::string rmw_implementation() const;
   /// \returns Returns current performance test version. This will throw if the experiment
   /// configuration is not set up.
   std::string perf_test_version() const;
+  /// \returns Returns the overhead of perf_test itself, measured during the setup if requested.
+  /// This will throw if the experiment configuration is not set up.
+  HarnessFloor harness_floor() const;
   /// \returns Returns the publishing topic postfix.
   std::string pub_topic_postfix() const;
   /// \returns Returns the subscribing topic postfix.
@@ -204,9 +361,37 @@ private:
   bool m_is_zero_copy_transfer;
 
   RoundTripMode m_roundtrip_mode;
+  IntraProcessOwnership m_intra_process_ownership;
+  uint32_t m_executor_threads;
+  CallbackGroupMode m_callback_group_mode;
+  FastDDSTransport m_fastdds_transport;
+  OpenDDSTransport m_opendds_transport;
+  uint32_t m_shm_history_depth;
+  uint32_t m_max_samples_per_take;
+  DeliveryMode m_delivery_mode;
+  bool m_iceoryx_introspection;
+  uint32_t m_connext_micro_shmem_message_count;
+  uint32_t m_connext_micro_shmem_buffer_size;
+  uint32_t m_shm_ring_slots;
+  uint32_t m_shm_ring_payload_size;
+  ShmRingWakeup m_shm_ring_wakeup;
+  uint32_t m_intra_queue_depth;
+  IntraQueueTransfer m_intra_queue_transfer;
+  uint32_t m_udp_raw_port;
+  uint32_t m_udp_raw_datagram_size;
+  uint32_t m_udp_raw_sndbuf;
+  uint32_t m_udp_raw_rcvbuf;
+  bool m_udp_raw_offload;
+  StreamSocket m_stream_socket;
+  StreamBackend m_stream_backend;
+  uint32_t m_stream_port;
+  std::vector<ThreadRule> m_thread_rules;
+  bool m_sample_run_delay;
+  bool m_measure_harness_floor;
 
   std::string m_rmw_implementation;
   std::string m_perf_test_version;
+  HarnessFloor m_harness_floor;
 
   ExternalInfoStorage m_external_info;
 };
@@ -215,6 +400,61 @@ std::string to_string(const ExperimentConfiguration::RoundTripMode e);
 /// Outstream operator for RoundTripMode.
 std::ostream & operator<<(std::ostream & stream, const ExperimentConfiguration::RoundTripMode & e);
 
+std::string to_string(const ExperimentConfiguration::IntraProcessOwnership e);
+/// Outstream operator for IntraProcessOwnership.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::IntraProcessOwnership & e);
+
+std::string to_string(const ExperimentConfiguration::CallbackGroupMode e);
+/// Outstream operator for CallbackGroupMode.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::CallbackGroupMode & e);
+
+std::string to_string(const ExperimentConfiguration::FastDDSTransport e);
+/// Outstream operator for FastDDSTransport.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::FastDDSTransport & e);
+
+/// Returns the OpenDDS name of the transport type.
+std::string to_string(const ExperimentConfiguration::OpenDDSTransport e);
+/// Outstream operator for OpenDDSTransport.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::OpenDDSTransport & e);
+
+std::string to_string(const ExperimentConfiguration::DeliveryMode e);
+/// Outstream operator for DeliveryMode.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::DeliveryMode & e);
+
+std::string to_string(const ExperimentConfiguration::ShmRingWakeup e);
+/// Outstream operator for ShmRingWakeup.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::ShmRingWakeup & e);
+
+std::string to_string(const ExperimentConfiguration::IntraQueueTransfer e);
+/// Outstream operator for IntraQueueTransfer.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::IntraQueueTransfer & e);
+
+std::string to_string(const ExperimentConfiguration::StreamSocket e);
+/// Outstream operator for StreamSocket.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::StreamSocket & e);
+
+std::string to_string(const ExperimentConfiguration::StreamBackend e);
+/// Outstream operator for StreamBackend.
+std::ostream & operator<<(
+  std::ostream & stream,
+  const ExperimentConfiguration::StreamBackend & e);
+
 /// Outstream operator for ExperimentConfiguration.
 std::ostream & operator<<(std::ostream & stream, const ExperimentConfiguration & e);
 }  // namespace performance_test
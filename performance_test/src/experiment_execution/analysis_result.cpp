@@ -37,24 +37,68 @@ AnalysisResult::AnalysisResult(
   const std::chrono::nanoseconds experiment_start,
   const std::chrono::nanoseconds loop_start,
   const uint64_t num_samples_received,
+  const uint64_t num_samples_received_shm,
   const uint64_t num_samples_sent,
   const uint64_t num_samples_lost,
   const std::size_t total_data_received,
   StatisticsTracker latency,
   StatisticsTracker pub_loop_time_reserve,
   StatisticsTracker sub_loop_time_reserve,
-  const CpuInfo cpu_info
+  StatisticsTracker serialization,
+  StatisticsTracker deserialization,
+  StatisticsTracker samples_per_wakeup,
+  StatisticsTracker run_delay,
+  const CpuInfo cpu_info,
+  const std::vector<PerfCounterInfo> pub_perf_counters,
+  const std::vector<PerfCounterInfo> sub_perf_counters,
+  const std::vector<ThreadUsageInfo> thread_usage,
+  const std::vector<SchedInfo> pub_sched_info,
+  const std::vector<SchedInfo> sub_sched_info
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  , const IceoryxIntrospectionInfo iceoryx_info
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  , const ShmRingWakeupInfo shm_ring_wakeup_info
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  , const UdpDropInfo udp_drop_info
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  , const StreamSyscallInfo stream_syscall_info
+#endif
 )
 : m_experiment_start(experiment_start),
   m_loop_start(loop_start),
   m_num_samples_received(num_samples_received),
+  m_num_samples_received_shm(num_samples_received_shm),
   m_num_samples_sent(num_samples_sent),
   m_num_samples_lost(num_samples_lost),
   m_total_data_received(total_data_received),
   m_latency(latency),
   m_pub_loop_time_reserve(pub_loop_time_reserve),
   m_sub_loop_time_reserve(sub_loop_time_reserve),
-  m_cpu_info(cpu_info)
+  m_serialization(serialization),
+  m_deserialization(deserialization),
+  m_samples_per_wakeup(samples_per_wakeup),
+  m_run_delay(run_delay),
+  m_cpu_info(cpu_info),
+  m_pub_perf_counters(pub_perf_counters),
+  m_sub_perf_counters(sub_perf_counters),
+  m_thread_usage(thread_usage),
+  m_pub_sched_info(pub_sched_info),
+  m_sub_sched_info(sub_sched_info)
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  , m_iceoryx_info(iceoryx_info)
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  , m_shm_ring_wakeup_info(shm_ring_wakeup_info)
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  , m_udp_drop_info(udp_drop_info)
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  , m_stream_syscall_info(stream_syscall_info)
+#endif
 {
 #if !defined(WIN32)
   const auto ret = getrusage(RUSAGE_SELF, &m_sys_usage);
@@ -127,6 +171,79 @@ std::string AnalysisResult::csv_header(const bool pretty_print, std::string st)
   ss << "ru_nivcsw" << st;
 #endif
 
+  // The columns above are read by position, e.g. by ApexComparison.py, so new columns go below.
+  ss << "serialization_min (ms)" << st;
+  ss << "serialization_max (ms)" << st;
+  ss << "serialization_mean (ms)" << st;
+  ss << "serialization_variance (ms)" << st;
+
+  ss << "deserialization_min (ms)" << st;
+  ss << "deserialization_max (ms)" << st;
+  ss << "deserialization_mean (ms)" << st;
+  ss << "deserialization_variance (ms)" << st;
+
+  ss << "received_shm" << st;
+
+  ss << "samples_per_wakeup_min" << st;
+  ss << "samples_per_wakeup_max" << st;
+  ss << "samples_per_wakeup_mean" << st;
+  ss << "samples_per_wakeup_variance" << st;
+
+  ss << "run_delay_min (ms)" << st;
+  ss << "run_delay_max (ms)" << st;
+  ss << "run_delay_mean (ms)" << st;
+  ss << "run_delay_variance (ms)" << st;
+
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  ss << "iox_mempool_max_usage (%)" << st;
+  ss << "iox_mempool_min_free_chunks" << st;
+  ss << "iox_queue_max_fill" << st;
+  ss << "iox_queue_capacity" << st;
+  ss << "iox_queue_overflows" << st;
+  ss << "iox_chunk_size" << st;
+  ss << "iox_chunk_unused" << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  ss << "shm_ring_wakeups" << st;
+  ss << "shm_ring_wakeup_p50 (ms)" << st;
+  ss << "shm_ring_wakeup_p90 (ms)" << st;
+  ss << "shm_ring_wakeup_p99 (ms)" << st;
+  ss << "shm_ring_wakeup_p99.9 (ms)" << st;
+  ss << "shm_ring_wakeup_max (ms)" << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  ss << "udp_socket_drops" << st;
+  ss << "udp_rcvbuf_errors" << st;
+  ss << "udp_sndbuf_errors" << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  ss << "stream_pub_syscalls_per_sample" << st;
+  ss << "stream_sub_syscalls_per_sample" << st;
+#endif
+
+  for (const std::string role : {"pub", "sub"}) {
+    ss << role << "_cycles" << st;
+    ss << role << "_instructions" << st;
+    ss << role << "_ipc" << st;
+    ss << role << "_llc_misses" << st;
+    ss << role << "_branch_misses" << st;
+    ss << role << "_context_switches" << st;
+  }
+
+  for (const std::string role : {"pub", "sub"}) {
+    ss << role << "_run_delay (ns)" << st;
+    ss << role << "_timeslices" << st;
+    ss << role << "_run_delay_per_timeslice (ns)" << st;
+    ss << role << "_migrations" << st;
+  }
+
+  ss << "threads_cpu_time (ns)" << st;
+  ss << "cpu_per_sample (ns)" << st;
+  ss << "cpu_per_byte (ns)" << st;
+
   ss << "cpu_usage (%)";
 
   return ss.str();
@@ -193,9 +310,103 @@ std::string AnalysisResult::to_csv_string(const bool pretty_print, std::string s
   ss << std::to_string(m_sys_usage.ru_nivcsw) << st;
 #endif
 
+  ss << m_serialization.min() * 1000.0 << st;
+  ss << m_serialization.max() * 1000.0 << st;
+  ss << m_serialization.mean() * 1000.0 << st;
+  ss << m_serialization.variance() * 1000.0 << st;
+
+  ss << m_deserialization.min() * 1000.0 << st;
+  ss << m_deserialization.max() * 1000.0 << st;
+  ss << m_deserialization.mean() * 1000.0 << st;
+  ss << m_deserialization.variance() * 1000.0 << st;
+
+  ss << m_num_samples_received_shm << st;
+
+  ss << m_samples_per_wakeup.min() << st;
+  ss << m_samples_per_wakeup.max() << st;
+  ss << m_samples_per_wakeup.mean() << st;
+  ss << m_samples_per_wakeup.variance() << st;
+
+  ss << m_run_delay.min() * 1000.0 << st;
+  ss << m_run_delay.max() * 1000.0 << st;
+  ss << m_run_delay.mean() * 1000.0 << st;
+  ss << m_run_delay.variance() * 1000.0 << st;
+
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  ss << m_iceoryx_info.mempool_max_usage << st;
+  ss << m_iceoryx_info.mempool_min_free_chunks << st;
+  ss << m_iceoryx_info.queue_max_fill << st;
+  ss << m_iceoryx_info.queue_capacity << st;
+  ss << m_iceoryx_info.queue_overflows << st;
+  ss << m_iceoryx_info.chunk_size << st;
+  ss << m_iceoryx_info.chunk_unused << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  ss << m_shm_ring_wakeup_info.wakeups << st;
+  ss << m_shm_ring_wakeup_info.latency_p50 << st;
+  ss << m_shm_ring_wakeup_info.latency_p90 << st;
+  ss << m_shm_ring_wakeup_info.latency_p99 << st;
+  ss << m_shm_ring_wakeup_info.latency_p999 << st;
+  ss << m_shm_ring_wakeup_info.latency_max << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  ss << m_udp_drop_info.socket_drops << st;
+  ss << m_udp_drop_info.rcvbuf_errors << st;
+  ss << m_udp_drop_info.sndbuf_errors << st;
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  ss << StreamSyscallInfo::per_sample(
+    m_stream_syscall_info.publisher_syscalls, m_num_samples_sent) << st;
+  ss << StreamSyscallInfo::per_sample(
+    m_stream_syscall_info.subscriber_syscalls, m_num_samples_received) << st;
+#endif
+
+  for (const auto & perf_counters : {m_pub_perf_counters, m_sub_perf_counters}) {
+    const auto total = PerfCounterInfo::sum(perf_counters);
+    ss << total.cycles << st;
+    ss << total.instructions << st;
+    ss << total.ipc() << st;
+    ss << total.llc_misses << st;
+    ss << total.branch_misses << st;
+    ss << total.context_switches << st;
+  }
+
+  for (const auto & sched_info : {m_pub_sched_info, m_sub_sched_info}) {
+    const auto total = SchedInfo::sum(sched_info);
+    ss << total.run_delay << st;
+    ss << total.timeslices << st;
+    ss << total.run_delay_per_timeslice() << st;
+    ss << total.migrations << st;
+  }
+
+  ss << ThreadUsageInfo::total_cpu_time(m_thread_usage) << st;
+  ss << cpu_per_sample() << st;
+  ss << cpu_per_byte() << st;
+
   ss << m_cpu_info.cpu_usage();
 
   return ss.str();
 }
 
+double AnalysisResult::cpu_per_sample() const
+{
+  // The received samples are a rate per second, while the CPU time is that of the whole
+  // interval, so the samples of the interval are counted from the latency statistics.
+  return ThreadUsageInfo::per_unit(
+    ThreadUsageInfo::total_cpu_time(m_thread_usage), static_cast<uint64_t>(m_latency.n()));
+}
+
+double AnalysisResult::cpu_per_byte() const
+{
+  if (m_total_data_received == 0) {
+    return 0.0;
+  }
+  // Both rates are per second, so their ratio is the mean size of a received sample.
+  return cpu_per_sample() * static_cast<double>(m_num_samples_received) /
+         static_cast<double>(m_total_data_received);
+}
+
 }  // namespace performance_test
@@ -23,9 +23,29 @@
 #include <chrono>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "../utilities/statistics_tracker.hpp"
 #include "../utilities/cpu_usage_tracker.hpp"
+#include "../utilities/perf_counters.hpp"
+#include "../utilities/sched_stats.hpp"
+#include "../utilities/thread_usage_tracker.hpp"
+
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  #include "../communication_abstractions/iceoryx_introspection.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  #include "../communication_abstractions/shm_ring.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  #include "../communication_abstractions/udp_raw.hpp"
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  #include "../communication_abstractions/stream.hpp"
+#endif
 
 namespace performance_test
 {
@@ -43,24 +63,71 @@ public:
    * \param experiment_start Time the experiment started.
    * \param loop_start  Time the loop iteration started.
    * \param num_samples_received Number of samples received during the experiment iteration.
+   * \param num_samples_received_shm Number of those samples which were delivered through shared
+   *        memory.
    * \param num_samples_sent Number of samples sent during the experiment iteration.
    * \param num_samples_lost Number of samples lost during the experiment iteration.
    * \param total_data_received Total data received during the experiment iteration in bytes.
    * \param latency Latency statistics of samples received.
    * \param pub_loop_time_reserve Loop time statistics of the publisher threads.
    * \param sub_loop_time_reserve Loop time statistics of the subscriber threads.
+   * \param serialization Serialization time statistics of the publisher threads.
+   * \param deserialization Deserialization time statistics of the subscriber threads.
+   * \param samples_per_wakeup Statistics of the number of samples the subscriber threads took
+   *        per wakeup.
+   * \param run_delay Statistics of the time the subscriber threads waited in the run queue for
+   *        a CPU per wakeup.
+   * \param cpu_info CPU usage during the experiment iteration.
+   * \param pub_perf_counters The hardware performance counters of each publisher thread during
+   *        the experiment iteration.
+   * \param sub_perf_counters The hardware performance counters of each subscriber thread during
+   *        the experiment iteration.
+   * \param thread_usage The CPU usage of each thread of the process, including the threads of
+   *        the middleware, during the experiment iteration.
+   * \param pub_sched_info The scheduler statistics of each publisher thread during the
+   *        experiment iteration.
+   * \param sub_sched_info The scheduler statistics of each subscriber thread during the
+   *        experiment iteration.
+   * \param iceoryx_info The iceoryx introspection values of the experiment iteration.
+   * \param shm_ring_wakeup_info The wakeups of the shm ring subscribers during the experiment
+   *        iteration.
+   * \param udp_drop_info The UDP datagrams the kernel dropped during the experiment iteration.
+   * \param stream_syscall_info The system calls of the stream plugin during the experiment
+   *        iteration.
    */
   AnalysisResult(
     const std::chrono::nanoseconds experiment_start,
     const std::chrono::nanoseconds loop_start,
     const uint64_t num_samples_received,
+    const uint64_t num_samples_received_shm,
     const uint64_t num_samples_sent,
     const uint64_t num_samples_lost,
     const std::size_t total_data_received,
     StatisticsTracker latency,
     StatisticsTracker pub_loop_time_reserve,
     StatisticsTracker sub_loop_time_reserve,
-    const CpuInfo cpu_info
+    StatisticsTracker serialization,
+    StatisticsTracker deserialization,
+    StatisticsTracker samples_per_wakeup,
+    StatisticsTracker run_delay,
+    const CpuInfo cpu_info,
+    const std::vector<PerfCounterInfo> pub_perf_counters,
+    const std::vector<PerfCounterInfo> sub_perf_counters,
+    const std::vector<ThreadUsageInfo> thread_usage,
+    const std::vector<SchedInfo> pub_sched_info,
+    const std::vector<SchedInfo> sub_sched_info
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+    , const IceoryxIntrospectionInfo iceoryx_info
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    , const ShmRingWakeupInfo shm_ring_wakeup_info
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    , const UdpDropInfo udp_drop_info
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    , const StreamSyscallInfo stream_syscall_info
+#endif
   );
   /**
    * \brief Returns a header for a CVS file containing the analysis result data
@@ -78,9 +145,16 @@ public:
    */
   std::string to_csv_string(const bool pretty_print = false, std::string st = ",") const;
 
+  /// Returns the CPU time in ns of all threads per sample received during the interval.
+  double cpu_per_sample() const;
+
+  /// Returns the CPU time in ns of all threads per byte received during the interval.
+  double cpu_per_byte() const;
+
   const std::chrono::nanoseconds m_experiment_start = {};
   const std::chrono::nanoseconds m_loop_start = {};
   const uint64_t m_num_samples_received = {};
+  const uint64_t m_num_samples_received_shm = {};
   const uint64_t m_num_samples_sent = {};
   const uint64_t m_num_samples_lost = {};
   const std::size_t m_total_data_received = {};
@@ -88,10 +162,31 @@ public:
   StatisticsTracker m_latency;
   StatisticsTracker m_pub_loop_time_reserve;
   StatisticsTracker m_sub_loop_time_reserve;
+  StatisticsTracker m_serialization;
+  StatisticsTracker m_deserialization;
+  StatisticsTracker m_samples_per_wakeup;
+  StatisticsTracker m_run_delay;
 #if !defined(WIN32)
   rusage m_sys_usage;
 #endif  // !defined(WIN32)
   const CpuInfo m_cpu_info;
+  const std::vector<PerfCounterInfo> m_pub_perf_counters;
+  const std::vector<PerfCounterInfo> m_sub_perf_counters;
+  const std::vector<ThreadUsageInfo> m_thread_usage;
+  const std::vector<SchedInfo> m_pub_sched_info;
+  const std::vector<SchedInfo> m_sub_sched_info;
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+  const IceoryxIntrospectionInfo m_iceoryx_info;
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+  const ShmRingWakeupInfo m_shm_ring_wakeup_info;
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+  const UdpDropInfo m_udp_drop_info;
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+  const StreamSyscallInfo m_stream_syscall_info;
+#endif
 };
 
 }  // namespace performance_test
@@ -17,11 +17,13 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 
 #include "analyze_runner.hpp"
 #include "analysis_result.hpp"
+#include "../communication_abstractions/resource_manager.hpp"
 
 #ifdef QNX710
 using perf_clock = std::chrono::system_clock;
@@ -34,7 +36,8 @@ namespace performance_test
 
 AnalyzeRunner::AnalyzeRunner()
 : m_ec(ExperimentConfiguration::get()),
-  m_is_first_entry(true)
+  m_is_first_entry(true),
+  m_thread_rule_applier(m_ec.thread_rules())
 {
   for (uint32_t i = 0; i < m_ec.number_of_publishers(); ++i) {
     m_pub_runners.push_back(
@@ -47,6 +50,23 @@ AnalyzeRunner::AnalyzeRunner()
   for (const auto & output : m_ec.configured_outputs()) {
     bind_output(output);
   }
+  // The middleware spawns most of its threads when the runners create the entities on their
+  // first publish or take, so the rules are applied more often until then.
+  if (!m_ec.thread_rules().empty()) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!entities_created() && std::chrono::steady_clock::now() < deadline) {
+      apply_thread_rules();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    apply_thread_rules();
+  }
+}
+
+AnalyzeRunner::~AnalyzeRunner()
+{
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  ResourceManager::get().stop_rclcpp_executor();
+#endif
 }
 
 void AnalyzeRunner::bind_output(std::shared_ptr<Output> output)
@@ -69,6 +89,9 @@ void AnalyzeRunner::run()
 
     std::for_each(m_pub_runners.begin(), m_pub_runners.end(), [](auto & a) {a->sync_reset();});
     std::for_each(m_sub_runners.begin(), m_sub_runners.end(), [](auto & a) {a->sync_reset();});
+    apply_thread_rules();
+    // Sampled every interval, so that ignored rows do not add to the next reported one.
+    const auto thread_usage = m_thread_usage_tracker.get_thread_usage();
 
 #if PERFORMANCE_TEST_RT_ENABLED
     /// If there are custom RT settings and this is the first loop, set the post
@@ -84,7 +107,7 @@ void AnalyzeRunner::run()
     auto experiment_diff_start = now - experiment_start;
     auto seconds = std::chrono::duration_cast<std::chrono::seconds>(experiment_diff_start).count();
     if (seconds > m_ec.rows_to_ignore()) {
-      auto result = analyze(loop_diff_start, experiment_diff_start);
+      auto result = analyze(loop_diff_start, experiment_diff_start, thread_usage);
       for (const auto & output : m_outputs) {
         output->update(result);
       }
@@ -98,7 +121,8 @@ void AnalyzeRunner::run()
 
 std::shared_ptr<const AnalysisResult> AnalyzeRunner::analyze(
   const std::chrono::nanoseconds loop_diff_start,
-  const std::chrono::nanoseconds experiment_diff_start)
+  const std::chrono::nanoseconds experiment_diff_start,
+  const std::vector<ThreadUsageInfo> & thread_usage)
 {
   std::vector<StatisticsTracker> latency_vec(m_sub_runners.size());
   std::transform(
@@ -115,11 +139,56 @@ std::shared_ptr<const AnalysisResult> AnalyzeRunner::analyze(
     m_sub_runners.begin(), m_sub_runners.end(), ltr_sub_vec.begin(),
     [](const auto & a) {return a->loop_time_reserve_statistics();});
 
+  std::vector<StatisticsTracker> serialization_vec(m_pub_runners.size());
+  std::transform(
+    m_pub_runners.begin(), m_pub_runners.end(), serialization_vec.begin(),
+    [](const auto & a) {return a->serialization_statistics();});
+
+  std::vector<StatisticsTracker> deserialization_vec(m_sub_runners.size());
+  std::transform(
+    m_sub_runners.begin(), m_sub_runners.end(), deserialization_vec.begin(),
+    [](const auto & a) {return a->serialization_statistics();});
+
+  std::vector<StatisticsTracker> samples_per_wakeup_vec(m_sub_runners.size());
+  std::transform(
+    m_sub_runners.begin(), m_sub_runners.end(), samples_per_wakeup_vec.begin(),
+    [](const auto & a) {return a->samples_per_wakeup_statistics();});
+
+  std::vector<StatisticsTracker> run_delay_vec(m_sub_runners.size());
+  std::transform(
+    m_sub_runners.begin(), m_sub_runners.end(), run_delay_vec.begin(),
+    [](const auto & a) {return a->run_delay_statistics();});
+
+  std::vector<PerfCounterInfo> pub_perf_counters_vec(m_pub_runners.size());
+  std::transform(
+    m_pub_runners.begin(), m_pub_runners.end(), pub_perf_counters_vec.begin(),
+    [](const auto & a) {return a->perf_counters();});
+
+  std::vector<PerfCounterInfo> sub_perf_counters_vec(m_sub_runners.size());
+  std::transform(
+    m_sub_runners.begin(), m_sub_runners.end(), sub_perf_counters_vec.begin(),
+    [](const auto & a) {return a->perf_counters();});
+
+  std::vector<SchedInfo> pub_sched_info_vec(m_pub_runners.size());
+  std::transform(
+    m_pub_runners.begin(), m_pub_runners.end(), pub_sched_info_vec.begin(),
+    [](const auto & a) {return a->sched_info();});
+
+  std::vector<SchedInfo> sub_sched_info_vec(m_sub_runners.size());
+  std::transform(
+    m_sub_runners.begin(), m_sub_runners.end(), sub_sched_info_vec.begin(),
+    [](const auto & a) {return a->sched_info();});
+
   uint64_t sum_received_samples = 0;
   for (auto e : m_sub_runners) {
     sum_received_samples += e->sum_received_samples();
   }
 
+  uint64_t sum_received_shm_samples = 0;
+  for (auto e : m_sub_runners) {
+    sum_received_shm_samples += e->sum_received_shm_samples();
+  }
+
   uint64_t sum_sent_samples = 0;
   for (auto e : m_pub_runners) {
     sum_sent_samples += e->sum_sent_samples();
@@ -139,17 +208,61 @@ std::shared_ptr<const AnalysisResult> AnalyzeRunner::analyze(
     experiment_diff_start,
     loop_diff_start,
     sum_received_samples,
+    sum_received_shm_samples,
     sum_sent_samples,
     sum_lost_samples,
     sum_data_received,
     StatisticsTracker(latency_vec),
     StatisticsTracker(ltr_pub_vec),
     StatisticsTracker(ltr_sub_vec),
-    cpu_usage_tracker.get_cpu_usage()
+    StatisticsTracker(serialization_vec),
+    StatisticsTracker(deserialization_vec),
+    StatisticsTracker(samples_per_wakeup_vec),
+    StatisticsTracker(run_delay_vec),
+    cpu_usage_tracker.get_cpu_usage(),
+    pub_perf_counters_vec,
+    sub_perf_counters_vec,
+    thread_usage,
+    pub_sched_info_vec,
+    sub_sched_info_vec
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+    , ResourceManager::get().iceoryx_introspection_info()
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    , ResourceManager::get().shm_ring_wakeup_info()
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    , ResourceManager::get().udp_drop_info()
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    , ResourceManager::get().stream_syscall_info()
+#endif
   );
   return result;
 }
 
+void AnalyzeRunner::apply_thread_rules()
+{
+  if (m_ec.thread_rules().empty()) {
+    return;
+  }
+  const auto placements = m_thread_rule_applier.apply();
+  if (placements.empty()) {
+    return;
+  }
+  std::cout << "Thread placement:" << std::endl;
+  for (const auto & placement : placements) {
+    std::cout << "  " << placement << std::endl;
+  }
+}
+
+bool AnalyzeRunner::entities_created() const
+{
+  const auto created = [](const auto & a) {return a->entities_created();};
+  return std::all_of(m_pub_runners.begin(), m_pub_runners.end(), created) &&
+         std::all_of(m_sub_runners.begin(), m_sub_runners.end(), created);
+}
+
 bool AnalyzeRunner::check_exit(std::chrono::steady_clock::time_point experiment_start) const
 {
   if (m_ec.exit_requested()) {
@@ -25,6 +25,8 @@
 #include "../experiment_configuration/experiment_configuration.hpp"
 #include "../outputs/output.hpp"
 #include "../utilities/cpu_usage_tracker.hpp"
+#include "../utilities/thread_rules.hpp"
+#include "../utilities/thread_usage_tracker.hpp"
 
 namespace performance_test
 {
@@ -39,6 +41,12 @@ public:
    */
   AnalyzeRunner();
 
+  /**
+   * \brief Stops the process-wide ROS 2 executor before the runners are destroyed, as it runs
+   * the callbacks of their subscribers.
+   */
+  ~AnalyzeRunner();
+
   /**
    * \brief Bind outputs to receive the experiment results.
    */
@@ -54,12 +62,14 @@ private:
    * \brief Analyzes and logs the state of the experiment.
    * \param loop_diff_start
    * \param experiment_diff_start
+   * \param thread_usage The CPU usage of each thread during the experiment iteration.
    * \return The analysis result
    */
 
   std::shared_ptr<const AnalysisResult> analyze(
     const std::chrono::nanoseconds loop_diff_start,
-    const std::chrono::nanoseconds experiment_diff_start);
+    const std::chrono::nanoseconds experiment_diff_start,
+    const std::vector<ThreadUsageInfo> & thread_usage);
 
   /**
    * \brief Checks if the experiment is finished.
@@ -68,12 +78,23 @@ private:
    */
   bool check_exit(std::chrono::steady_clock::time_point experiment_start) const;
 
+  /**
+   * \brief Applies the thread rules to the threads which appeared since the previous call, and
+   * prints where they ended up.
+   */
+  void apply_thread_rules();
+
+  /// Returns whether all runners created their entities.
+  bool entities_created() const;
+
   const ExperimentConfiguration & m_ec;
   std::vector<std::shared_ptr<Output>> m_outputs;
   std::vector<std::shared_ptr<DataRunnerBase>> m_pub_runners;
   std::vector<std::shared_ptr<DataRunnerBase>> m_sub_runners;
   mutable bool m_is_first_entry;
   CPUsageTracker cpu_usage_tracker;
+  ThreadUsageTracker m_thread_usage_tracker;
+  ThreadRuleApplier m_thread_rule_applier;
 };
 
 }  // namespace performance_test
@@ -0,0 +1,136 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "harness_floor.hpp"
+
+#include <time.h>
+
+#include <performance_test/generated_messages/messages.hpp>
+#include <performance_test/for_each.hpp>
+
+#if defined(QNX)
+#include <sys/neutrino.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  #include "../communication_abstractions/null_communicator.hpp"
+#endif
+#include "../experiment_configuration/experiment_configuration.hpp"
+#include "../utilities/spin_lock.hpp"
+
+namespace performance_test
+{
+
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+namespace
+{
+
+std::chrono::nanoseconds thread_cpu_time()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+std::int64_t sample_time()
+{
+#if defined(QNX)
+  return static_cast<std::int64_t>(ClockCycles());
+#else
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+/// Publishes and takes samples for the given \param duration.
+template<class Msg>
+void publish_and_take(
+  NullCommunicator<Msg> & publisher,
+  NullCommunicator<Msg> & subscriber,
+  const std::chrono::nanoseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+    publisher.publish(sample_time());
+    subscriber.update_subscription();
+  }
+}
+
+template<class Msg>
+HarnessFloor measure_null_communicator()
+{
+  constexpr std::chrono::milliseconds warmup(20);
+  constexpr std::chrono::milliseconds duration(200);
+
+  SpinLock publisher_lock;
+  SpinLock subscriber_lock;
+  NullCommunicator<Msg> publisher(publisher_lock);
+  NullCommunicator<Msg> subscriber(subscriber_lock);
+
+  publish_and_take(publisher, subscriber, warmup);
+  publisher.reset();
+  subscriber.reset();
+
+  const auto cpu_start = thread_cpu_time();
+  publish_and_take(publisher, subscriber, duration);
+  const auto cpu_time = thread_cpu_time() - cpu_start;
+
+  HarnessFloor floor;
+  const auto latency = subscriber.latency_statistics();
+  floor.samples = subscriber.num_received_samples();
+  if (floor.samples > 0) {
+    floor.measured = true;
+    floor.latency_min = latency.min() * 1000.0;
+    floor.latency_mean = latency.mean() * 1000.0;
+    floor.latency_max = latency.max() * 1000.0;
+    floor.cpu_per_sample =
+      static_cast<double>(cpu_time.count()) / static_cast<double>(floor.samples);
+  }
+  return floor;
+}
+
+}  // namespace
+#endif
+
+HarnessFloor HarnessFloor::measure()
+{
+  HarnessFloor floor;
+#ifdef PERFORMANCE_TEST_NULL_ENABLED
+  const std::string msg_name = ExperimentConfiguration::get().msg_name();
+  performance_test::for_each(
+    messages::MessageTypeList(),
+    [&floor, &msg_name](const auto & msg_type) {
+      using T = std::remove_cv_t<std::remove_reference_t<decltype(msg_type)>>;
+      if (T::msg_name() == msg_name) {
+        floor = measure_null_communicator<T>();
+      }
+    });
+#endif
+  return floor;
+}
+
+std::ostream & operator<<(std::ostream & stream, const HarnessFloor & floor)
+{
+  if (!floor.measured) {
+    return stream << "N/A";
+  }
+  return stream <<
+         "latency min " << floor.latency_min << " ms, mean " << floor.latency_mean <<
+         " ms, max " << floor.latency_max << " ms, CPU per sample " << floor.cpu_per_sample <<
+         " ns, " << floor.samples << " samples";
+}
+
+}  // namespace performance_test
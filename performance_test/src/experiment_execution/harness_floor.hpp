@@ -0,0 +1,54 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef EXPERIMENT_EXECUTION__HARNESS_FLOOR_HPP_
+#define EXPERIMENT_EXECUTION__HARNESS_FLOOR_HPP_
+
+#include <cstdint>
+#include <ostream>
+
+namespace performance_test
+{
+
+/**
+ * \brief The latency and CPU time perf_test itself adds to every sample.
+ *
+ * It is measured by publishing and taking samples of the configured message type through the
+ * null plugin on a single thread, so there is no transport and no wakeup. Results can be
+ * corrected by subtracting the floor, and a change of the floor between perf_test versions
+ * shows a regression of the harness.
+ */
+struct HarnessFloor
+{
+  /// Whether the floor was measured. Requires the null plugin.
+  bool measured = false;
+  /// The number of samples the floor was measured with.
+  std::uint64_t samples = 0;
+  /// The latency from publishing a sample to taking it in ms.
+  double latency_min = 0.0;
+  double latency_mean = 0.0;
+  double latency_max = 0.0;
+  /// The CPU time to publish and take a sample in ns.
+  double cpu_per_sample = 0.0;
+
+  /// Measures the floor for the message type of the experiment configuration.
+  static HarnessFloor measure();
+};
+
+/// Outstream operator for HarnessFloor.
+std::ostream & operator<<(std::ostream & stream, const HarnessFloor & floor);
+
+}  // namespace performance_test
+
+#endif  // EXPERIMENT_EXECUTION__HARNESS_FLOOR_HPP_
@@ -15,6 +15,7 @@
 
 #include <tabulate/table.hpp>
 
+#include <algorithm>
 #include <string>
 #include <chrono>
 #include <iostream>
@@ -44,7 +45,7 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
   if (result) {
     // clear old table
     if (m_refresh) {
-      for (int i = 0; i < 37; i++) {
+      for (std::size_t i = 0; i < m_num_printed_lines; i++) {
         std::cout << "\033[F";
       }
     }
@@ -52,9 +53,10 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
     // construct tables with current results
     tabulate::Table sample_table;
     sample_table.add_row(
-      {"recv", "sent", "lost", "data_recv", "relative_loss"});
+      {"recv", "recv_shm", "sent", "lost", "data_recv", "relative_loss"});
     sample_table.add_row(
       {std::to_string(result->m_num_samples_received),
+        std::to_string(result->m_num_samples_received_shm),
         std::to_string(result->m_num_samples_sent),
         std::to_string(result->m_num_samples_lost),
         std::to_string(result->m_total_data_received),
@@ -75,6 +77,32 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
       latency_table.add_row({"-", "-", "-", "-"});
     }
 
+    tabulate::Table run_delay_table;
+    run_delay_table.add_row({"min", "max", "mean", "variance"});
+    if (result->m_run_delay.n() > 0) {
+      run_delay_table.add_row(
+        {std::to_string(result->m_run_delay.min()),
+          std::to_string(result->m_run_delay.max()),
+          std::to_string(result->m_run_delay.mean()),
+          std::to_string(result->m_run_delay.variance())});
+    } else {
+      run_delay_table.add_row({"-", "-", "-", "-"});
+    }
+
+    tabulate::Table sched_table;
+    sched_table.add_row({"", "run delay", "timeslices", "delay per slice", "migrations"});
+    for (const auto & row : {std::make_pair("pub", &result->m_pub_sched_info),
+        std::make_pair("sub", &result->m_sub_sched_info)})
+    {
+      const auto total = SchedInfo::sum(*row.second);
+      sched_table.add_row(
+        {row.first,
+          std::to_string(total.run_delay),
+          std::to_string(total.timeslices),
+          std::to_string(total.run_delay_per_timeslice()),
+          std::to_string(total.migrations)});
+    }
+
     tabulate::Table publisher_loop_table;
     publisher_loop_table.add_row({"min", "max", "mean", "variance"});
     if (result->m_pub_loop_time_reserve.n() > 0) {
@@ -99,6 +127,127 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
       subscriber_loop_table.add_row({"-", "-", "-", "-"});
     }
 
+    tabulate::Table serialization_table;
+    serialization_table.add_row({"min", "max", "mean", "variance"});
+    if (result->m_serialization.n() > 0) {
+      serialization_table.add_row(
+        {std::to_string(result->m_serialization.min()),
+          std::to_string(result->m_serialization.max()),
+          std::to_string(result->m_serialization.mean()),
+          std::to_string(result->m_serialization.variance())});
+    } else {
+      serialization_table.add_row({"-", "-", "-", "-"});
+    }
+
+    tabulate::Table deserialization_table;
+    deserialization_table.add_row({"min", "max", "mean", "variance"});
+    if (result->m_deserialization.n() > 0) {
+      deserialization_table.add_row(
+        {std::to_string(result->m_deserialization.min()),
+          std::to_string(result->m_deserialization.max()),
+          std::to_string(result->m_deserialization.mean()),
+          std::to_string(result->m_deserialization.variance())});
+    } else {
+      deserialization_table.add_row({"-", "-", "-", "-"});
+    }
+
+    tabulate::Table samples_per_wakeup_table;
+    samples_per_wakeup_table.add_row({"min", "max", "mean", "variance"});
+    if (result->m_samples_per_wakeup.n() > 0) {
+      samples_per_wakeup_table.add_row(
+        {std::to_string(result->m_samples_per_wakeup.min()),
+          std::to_string(result->m_samples_per_wakeup.max()),
+          std::to_string(result->m_samples_per_wakeup.mean()),
+          std::to_string(result->m_samples_per_wakeup.variance())});
+    } else {
+      samples_per_wakeup_table.add_row({"-", "-", "-", "-"});
+    }
+
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+    tabulate::Table iceoryx_table;
+    iceoryx_table.add_row(
+      {"mempool usage", "min free chunks", "queue fill", "overflows", "chunk size", "unused"});
+    iceoryx_table.add_row(
+      {std::to_string(result->m_iceoryx_info.mempool_max_usage),
+        std::to_string(result->m_iceoryx_info.mempool_min_free_chunks),
+        std::to_string(result->m_iceoryx_info.queue_max_fill) + "/" +
+        std::to_string(result->m_iceoryx_info.queue_capacity),
+        std::to_string(result->m_iceoryx_info.queue_overflows),
+        std::to_string(result->m_iceoryx_info.chunk_size),
+        std::to_string(result->m_iceoryx_info.chunk_unused)});
+#endif
+
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    tabulate::Table shm_ring_table;
+    shm_ring_table.add_row({"wakeups", "p50", "p90", "p99", "p99.9", "max"});
+    shm_ring_table.add_row(
+      {std::to_string(result->m_shm_ring_wakeup_info.wakeups),
+        std::to_string(result->m_shm_ring_wakeup_info.latency_p50),
+        std::to_string(result->m_shm_ring_wakeup_info.latency_p90),
+        std::to_string(result->m_shm_ring_wakeup_info.latency_p99),
+        std::to_string(result->m_shm_ring_wakeup_info.latency_p999),
+        std::to_string(result->m_shm_ring_wakeup_info.latency_max)});
+#endif
+
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    tabulate::Table udp_table;
+    udp_table.add_row({"socket drops", "rcvbuf errors", "sndbuf errors"});
+    udp_table.add_row(
+      {std::to_string(result->m_udp_drop_info.socket_drops),
+        std::to_string(result->m_udp_drop_info.rcvbuf_errors),
+        std::to_string(result->m_udp_drop_info.sndbuf_errors)});
+#endif
+
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    tabulate::Table stream_table;
+    stream_table.add_row({"publisher", "subscriber"});
+    stream_table.add_row(
+      {std::to_string(
+          StreamSyscallInfo::per_sample(
+            result->m_stream_syscall_info.publisher_syscalls, result->m_num_samples_sent)),
+        std::to_string(
+          StreamSyscallInfo::per_sample(
+            result->m_stream_syscall_info.subscriber_syscalls,
+            result->m_num_samples_received))});
+#endif
+
+    tabulate::Table perf_counters_table;
+    perf_counters_table.add_row(
+      {"", "cycles", "instructions", "IPC", "LLC misses", "branch misses", "ctx switches"});
+    for (const auto & row : {std::make_pair("pub", &result->m_pub_perf_counters),
+        std::make_pair("sub", &result->m_sub_perf_counters)})
+    {
+      const auto total = PerfCounterInfo::sum(*row.second);
+      perf_counters_table.add_row(
+        {row.first,
+          std::to_string(total.cycles),
+          std::to_string(total.instructions),
+          std::to_string(total.ipc()),
+          std::to_string(total.llc_misses),
+          std::to_string(total.branch_misses),
+          std::to_string(total.context_switches)});
+    }
+
+    tabulate::Table threads_table;
+    threads_table.add_row(
+      {"tid", "name", "utime", "stime", "nvcsw", "nivcsw", "last CPU"});
+    for (const auto & thread : result->m_thread_usage) {
+      threads_table.add_row(
+        {std::to_string(thread.tid),
+          thread.name,
+          std::to_string(thread.utime),
+          std::to_string(thread.stime),
+          std::to_string(thread.voluntary_switches),
+          std::to_string(thread.involuntary_switches),
+          std::to_string(thread.last_cpu)});
+    }
+    tabulate::Table cpu_efficiency_table;
+    cpu_efficiency_table.add_row({"CPU time", "CPU per sample", "CPU per byte"});
+    cpu_efficiency_table.add_row(
+      {std::to_string(ThreadUsageInfo::total_cpu_time(result->m_thread_usage)),
+        std::to_string(result->cpu_per_sample()),
+        std::to_string(result->cpu_per_byte())});
+
     tabulate::Table system_statistics_table;
 #if !defined(WIN32)
     std::chrono::nanoseconds utime_ns =
@@ -161,8 +310,41 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
     tabulate::Table packets_table;
     packets_table.add_row({"samples", "latency"});
     packets_table.add_row({sample_table, latency_table});
+    packets_table.add_row({"scheduler (ns)", "run-queue delay per wakeup"});
+    packets_table.add_row({sched_table, run_delay_table});
     packets_table.add_row({"publisher loop", "subscriber loop"});
     packets_table.add_row({publisher_loop_table, subscriber_loop_table});
+    packets_table.add_row({"serialization", "deserialization"});
+    packets_table.add_row({serialization_table, deserialization_table});
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+    packets_table.add_row({"samples per wakeup", "iceoryx"});
+    packets_table.add_row({samples_per_wakeup_table, iceoryx_table});
+#else
+    packets_table.add_row({"samples per wakeup", ""});
+    packets_table.add_row({samples_per_wakeup_table, ""});
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+    if (m_ec.com_mean() == CommunicationMean::SHM_RING) {
+      packets_table.add_row({"shm ring wakeup latency", ""});
+      packets_table.add_row({shm_ring_table, ""});
+    }
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+    if (m_ec.com_mean() == CommunicationMean::UDP_RAW) {
+      packets_table.add_row({"udp drops", ""});
+      packets_table.add_row({udp_table, ""});
+    }
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+    if (m_ec.com_mean() == CommunicationMean::STREAM) {
+      packets_table.add_row({"syscalls per sample", ""});
+      packets_table.add_row({stream_table, ""});
+    }
+#endif
+    packets_table.add_row({"perf counters", ""});
+    packets_table.add_row({perf_counters_table, ""});
+    packets_table.add_row({"threads", "CPU efficiency (ns)"});
+    packets_table.add_row({threads_table, cpu_efficiency_table});
 
     packets_table.format()
     .border_top(" ")
@@ -182,10 +364,15 @@ void StdoutOutput::update(std::shared_ptr<const AnalysisResult> result)
     .border_right(" ")
     .corner(" ");
 
-    // print table
-    std::cout << timing_table << std::endl;
-    std::cout << packets_table << std::endl;
-    std::cout << system_usage_table << std::endl;
+    // print table, remembering its height so the next update can overwrite it
+    std::stringstream ss;
+    ss << timing_table << std::endl;
+    ss << packets_table << std::endl;
+    ss << system_usage_table << std::endl;
+    const auto tables = ss.str();
+    m_num_printed_lines = static_cast<std::size_t>(
+      std::count(tables.begin(), tables.end(), '\n'));
+    std::cout << tables;
 
     // flag to refresh table on next update
     if (!m_refresh) {
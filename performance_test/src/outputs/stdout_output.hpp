@@ -37,6 +37,7 @@ public:
 private:
   const ExperimentConfiguration & m_ec;
   bool m_refresh = false;
+  std::size_t m_num_printed_lines = 0;
 };
 
 }  // namespace performance_test
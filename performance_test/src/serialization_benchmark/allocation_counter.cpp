@@ -0,0 +1,77 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace
+{
+// Initial-exec TLS of the executable, so reading it never allocates.
+thread_local std::uint64_t g_allocations = 0;
+}  // namespace
+
+#if defined(__GLIBC__)
+// glibc allows to replace malloc in the executable. The replacements forward to the glibc
+// implementation, so memory from other allocation functions can be freed as usual.
+extern "C" {
+void * __libc_malloc(std::size_t size) noexcept;
+void * __libc_calloc(std::size_t count, std::size_t size) noexcept;
+void * __libc_realloc(void * pointer, std::size_t size) noexcept;
+void __libc_free(void * pointer) noexcept;
+
+void * malloc(std::size_t size) noexcept
+{
+  ++g_allocations;
+  return __libc_malloc(size);
+}
+
+void * calloc(std::size_t count, std::size_t size) noexcept
+{
+  ++g_allocations;
+  return __libc_calloc(count, size);
+}
+
+void * realloc(void * pointer, std::size_t size) noexcept
+{
+  ++g_allocations;
+  return __libc_realloc(pointer, size);
+}
+
+void free(void * pointer) noexcept
+{
+  __libc_free(pointer);
+}
+}
+#endif
+
+namespace performance_test
+{
+
+bool AllocationCounter::is_supported()
+{
+#if defined(__GLIBC__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::uint64_t AllocationCounter::allocations()
+{
+  return g_allocations;
+}
+
+}  // namespace performance_test
@@ -0,0 +1,41 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERIALIZATION_BENCHMARK__ALLOCATION_COUNTER_HPP_
+#define SERIALIZATION_BENCHMARK__ALLOCATION_COUNTER_HPP_
+
+#include <cstdint>
+
+namespace performance_test
+{
+
+/**
+ * \brief Counts the heap allocations of the calling thread.
+ *
+ * The executable replaces malloc, calloc and realloc with versions which count the calls and
+ * forward them to the C library, so the allocations of C and C++ code are counted alike.
+ */
+class AllocationCounter
+{
+public:
+  /// Returns whether allocations are counted on this platform.
+  static bool is_supported();
+
+  /// Returns the number of allocations the calling thread made so far.
+  static std::uint64_t allocations();
+};
+
+}  // namespace performance_test
+
+#endif  // SERIALIZATION_BENCHMARK__ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,256 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <tclap/CmdLine.h>
+
+#include <performance_test/generated_messages/messages.hpp>
+#include <performance_test/for_each.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "serialization_benchmark.hpp"
+#include "serializers.hpp"
+
+namespace
+{
+
+using performance_test::SerializationBenchmark;
+using performance_test::SerializationResult;
+using performance_test::SerializerConfig;
+
+struct BenchmarkOptions
+{
+  SerializerConfig serializer_config;
+  std::vector<std::string> msg_names;
+  std::vector<std::string> plugins;
+  std::vector<unsigned> threads;
+  std::chrono::nanoseconds duration{0};
+};
+
+bool contains(const std::vector<std::string> & names, const std::string & name)
+{
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+/// Benchmarks all selected messages with the serializer of one plugin.
+template<template<class> class Serializer>
+void run_plugin(const BenchmarkOptions & options, std::vector<SerializationResult> & results)
+{
+  performance_test::for_each(
+    performance_test::messages::MessageTypeList(),
+    [&options, &results](const auto & msg_type) {
+      using T = std::remove_cv_t<std::remove_reference_t<decltype(msg_type)>>;
+      using S = Serializer<T>;
+      if (!contains(options.plugins, S::plugin_name()) ||
+      !contains(options.msg_names, T::msg_name()))
+      {
+        return;
+      }
+      if (!S::supports_message()) {
+        std::cerr << S::plugin_name() << " does not support " << T::msg_name() <<
+          ", skipping it" << std::endl;
+        return;
+      }
+      SerializationBenchmark<S> benchmark(options.serializer_config, options.duration);
+      for (const auto threads : options.threads) {
+        results.push_back(benchmark.run(T::msg_name(), threads));
+      }
+    });
+}
+
+std::vector<std::string> available_plugins()
+{
+  std::vector<std::string> plugins;
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  plugins.push_back("rclcpp");
+#endif
+#ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
+  plugins.push_back("FastDDS");
+#endif
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_ENABLED
+  plugins.push_back("CycloneDDS");
+#endif
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_CXX_ENABLED
+  plugins.push_back("CycloneDDS-CXX");
+#endif
+#ifdef PERFORMANCE_TEST_CONNEXTDDS_ENABLED
+  plugins.push_back("ConnextDDS");
+#endif
+#ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
+  plugins.push_back("OpenDDS");
+#endif
+  return plugins;
+}
+
+void print_results(const std::vector<SerializationResult> & results)
+{
+  // The throughput of a single thread, as the base for the scaling of more threads.
+  std::map<std::pair<std::string, std::string>, std::pair<double, double>> single_thread;
+  for (const auto & r : results) {
+    if (r.threads == 1) {
+      single_thread[{r.plugin, r.msg}] = {
+        r.serialize.calls_per_second(), r.deserialize.calls_per_second()};
+    }
+  }
+
+  const auto per_byte = [](const double ns, const std::size_t size) {
+      return size > 0 ? ns / static_cast<double>(size) : 0.0;
+    };
+  const auto scaling = [](const double value, const double base) {
+      return base > 0.0 ? value / base : 0.0;
+    };
+
+  std::cout <<
+    "plugin,msg,threads,serialized_size (B),"
+    "serialize (ns),serialize (ns/B),serialize_allocs,serialize_per_second,"
+    "serialize_scaling,"
+    "deserialize (ns),deserialize (ns/B),deserialize_allocs,deserialize_per_second,"
+    "deserialize_scaling" << std::endl;
+  for (const auto & r : results) {
+    const auto base = single_thread.find({r.plugin, r.msg});
+    const bool has_base = base != single_thread.end();
+    std::cout <<
+      r.plugin << "," <<
+      r.msg << "," <<
+      r.threads << "," <<
+      r.serialized_size << "," <<
+      r.serialize.ns_per_call() << "," <<
+      per_byte(r.serialize.ns_per_call(), r.serialized_size) << "," <<
+      r.serialize.allocations_per_call() << "," <<
+      r.serialize.calls_per_second() << "," <<
+      (has_base ? scaling(r.serialize.calls_per_second(), base->second.first) : 0.0) << "," <<
+      r.deserialize.ns_per_call() << "," <<
+      per_byte(r.deserialize.ns_per_call(), r.serialized_size) << "," <<
+      r.deserialize.allocations_per_call() << "," <<
+      r.deserialize.calls_per_second() << "," <<
+      (has_base ? scaling(r.deserialize.calls_per_second(), base->second.second) : 0.0) <<
+      std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  BenchmarkOptions options;
+  try {
+    TCLAP::CmdLine cmd("Apex.AI performance_test serialization benchmark");
+
+    auto plugins = available_plugins();
+    TCLAP::ValuesConstraint<std::string> allowedPluginVals(plugins);
+    TCLAP::MultiArg<std::string> pluginArg("c", "communication",
+      "The plugin whose serialization to benchmark. Can be repeated. Default is all plugins.",
+      false, &allowedPluginVals, cmd);
+
+    TCLAP::MultiArg<std::string> msgArg("m", "msg",
+      "The message type. Can be repeated. Default is all message types. "
+      "Use --msg-list to list the options.", false, "type", cmd);
+
+    TCLAP::SwitchArg msgListArg("", "msg-list",
+      "Print the list of available msg types and exit.", cmd, false);
+
+    TCLAP::MultiArg<unsigned> threadsArg("", "threads",
+      "The number of threads serializing concurrently. Can be repeated. Default is 1.",
+      false, "N", cmd);
+
+    TCLAP::ValueArg<double> durationArg("", "duration",
+      "How long to serialize, and then to deserialize, each message in seconds.",
+      false, 1.0, "sec", cmd);
+
+    TCLAP::ValueArg<uint32_t> unboundedMsgSizeArg("", "unbounded-msg-size",
+      "The number of bytes to use for an unbounded message type. Ignored for other messages.",
+      false, 0, "N", cmd);
+
+    TCLAP::ValueArg<uint32_t> ddsDomainIdArg("", "dds-domain_id",
+      "The DDS domain id of the entities some plugins need for their type support.",
+      false, 0, "id", cmd);
+
+    cmd.parse(argc, argv);
+
+    if (msgListArg.getValue()) {
+      for (const auto & s : performance_test::messages::supported_msg_names()) {
+        std::cout << s << std::endl;
+      }
+      return 0;
+    }
+
+    options.plugins = pluginArg.getValue().empty() ? plugins : pluginArg.getValue();
+    options.msg_names = msgArg.getValue().empty() ?
+      performance_test::messages::supported_msg_names() : msgArg.getValue();
+    for (const auto & msg_name : options.msg_names) {
+      if (!contains(performance_test::messages::supported_msg_names(), msg_name)) {
+        std::cerr << "error: Unsupported msg type: " << msg_name << std::endl;
+        return 1;
+      }
+    }
+    options.threads = threadsArg.getValue().empty() ?
+      std::vector<unsigned>{1} : threadsArg.getValue();
+    if (std::find(options.threads.begin(), options.threads.end(), 0U) != options.threads.end()) {
+      std::cerr << "error: The number of threads must be at least one" << std::endl;
+      return 1;
+    }
+    if (durationArg.getValue() <= 0.0) {
+      std::cerr << "error: The duration must be positive" << std::endl;
+      return 1;
+    }
+    options.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(durationArg.getValue()));
+    options.serializer_config.unbounded_msg_size = unboundedMsgSizeArg.getValue();
+    options.serializer_config.dds_domain_id = ddsDomainIdArg.getValue();
+  } catch (TCLAP::ArgException & e) {
+    std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    return 1;
+  }
+
+  if (!performance_test::AllocationCounter::is_supported()) {
+    std::cerr << "Allocations can not be counted on this platform, they are reported as 0" <<
+      std::endl;
+  }
+
+  std::vector<SerializationResult> results;
+  try {
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+    run_plugin<performance_test::RclcppSerializer>(options, results);
+#endif
+#ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
+    run_plugin<performance_test::FastDDSSerializer>(options, results);
+#endif
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_ENABLED
+    run_plugin<performance_test::CycloneDDSSerializer>(options, results);
+#endif
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_CXX_ENABLED
+    run_plugin<performance_test::CycloneDDSCXXSerializer>(options, results);
+#endif
+#ifdef PERFORMANCE_TEST_CONNEXTDDS_ENABLED
+    run_plugin<performance_test::ConnextDDSSerializer>(options, results);
+#endif
+#ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
+    run_plugin<performance_test::OpenDDSSerializer>(options, results);
+#endif
+  } catch (const std::exception & e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  print_results(results);
+}
@@ -0,0 +1,265 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERIALIZATION_BENCHMARK__SERIALIZATION_BENCHMARK_HPP_
+#define SERIALIZATION_BENCHMARK__SERIALIZATION_BENCHMARK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "serializers.hpp"
+
+namespace performance_test
+{
+
+/// The measurements of serializing or deserializing a message in a timed loop.
+struct SerializationPhaseResult
+{
+  /// The number of calls made by all threads.
+  std::uint64_t calls = 0;
+  /// The time the threads spent in the loop, summed over all threads.
+  std::chrono::nanoseconds busy{0};
+  /// The heap allocations the threads made in the loop.
+  std::uint64_t allocations = 0;
+  /// The wall-clock duration of the phase.
+  std::chrono::nanoseconds wall{0};
+
+  /// The mean time of a call in ns.
+  double ns_per_call() const
+  {
+    return calls > 0 ? static_cast<double>(busy.count()) / static_cast<double>(calls) : 0.0;
+  }
+
+  /// The mean number of heap allocations of a call.
+  double allocations_per_call() const
+  {
+    return calls > 0 ? static_cast<double>(allocations) / static_cast<double>(calls) : 0.0;
+  }
+
+  /// The calls per second of all threads together.
+  double calls_per_second() const
+  {
+    return wall.count() > 0 ?
+           static_cast<double>(calls) * 1e9 / static_cast<double>(wall.count()) : 0.0;
+  }
+};
+
+/// The result of benchmarking the serialization of one plugin, message type and thread count.
+struct SerializationResult
+{
+  std::string plugin;
+  std::string msg;
+  unsigned threads = 0;
+  /// The size of the serialized message in bytes.
+  std::size_t serialized_size = 0;
+  SerializationPhaseResult serialize;
+  SerializationPhaseResult deserialize;
+};
+
+/**
+ * \brief Measures how long a plugin takes to serialize and deserialize a message.
+ *
+ * Every thread creates its own serializer, so the threads share nothing but the plugin and the
+ * heap. All threads first serialize for the given duration, then all threads deserialize for
+ * the given duration. The clock is read once per batch of calls, to keep its cost out of the
+ * measurement for small messages.
+ */
+template<class Serializer>
+class SerializationBenchmark
+{
+public:
+  SerializationBenchmark(
+    const SerializerConfig & config, const std::chrono::nanoseconds duration)
+  : m_config(config), m_duration(duration) {}
+
+  /// Runs the benchmark on the given number of \param threads.
+  SerializationResult run(const std::string & msg_name, const unsigned threads)
+  {
+    if (threads == 0) {
+      throw std::invalid_argument("The number of threads must be at least one");
+    }
+
+    m_threads = threads;
+    m_ready = 0;
+    m_phase = Phase::INIT;
+    m_failed = false;
+    m_error = nullptr;
+    std::vector<ThreadResult> thread_results(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+      workers.emplace_back([this, &thread_results, i]() {run_thread(thread_results[i]);});
+    }
+
+    SerializationResult result;
+    result.plugin = Serializer::plugin_name();
+    result.msg = msg_name;
+    result.threads = threads;
+    wait_for_threads();
+    result.serialize.wall = run_phase(Phase::SERIALIZE);
+    result.deserialize.wall = run_phase(Phase::DESERIALIZE);
+    set_phase(Phase::DONE);
+    for (auto & worker : workers) {
+      worker.join();
+    }
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+
+    for (const auto & thread_result : thread_results) {
+      result.serialized_size = thread_result.serialized_size;
+      add(result.serialize, thread_result.serialize);
+      add(result.deserialize, thread_result.deserialize);
+    }
+    return result;
+  }
+
+private:
+  enum class Phase
+  {
+    INIT,
+    SERIALIZE,
+    DESERIALIZE,
+    DONE
+  };
+
+  struct ThreadResult
+  {
+    std::size_t serialized_size = 0;
+    SerializationPhaseResult serialize;
+    SerializationPhaseResult deserialize;
+  };
+
+  static constexpr unsigned s_batch_size = 8;
+
+  /// Starts the \param phase and waits for all threads to finish it.
+  std::chrono::nanoseconds run_phase(const Phase phase)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    set_phase(phase);
+    wait_for_threads();
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  void wait_for_threads()
+  {
+    while (m_ready.load(std::memory_order_acquire) < m_threads) {
+      std::this_thread::yield();
+    }
+    m_ready.store(0, std::memory_order_relaxed);
+  }
+
+  void set_phase(const Phase phase)
+  {
+    m_phase.store(phase, std::memory_order_release);
+  }
+
+  /// Signals that the thread finished the previous phase, and waits for the next one.
+  Phase next_phase(const Phase previous)
+  {
+    m_ready.fetch_add(1, std::memory_order_acq_rel);
+    Phase phase;
+    while ((phase = m_phase.load(std::memory_order_acquire)) == previous) {
+      std::this_thread::yield();
+    }
+    return phase;
+  }
+
+  void run_thread(ThreadResult & result)
+  {
+    std::unique_ptr<Serializer> serializer;
+    try {
+      serializer = std::make_unique<Serializer>(m_config);
+      result.serialized_size = serializer->serialize();
+      serializer->deserialize();
+    } catch (...) {
+      set_error(std::current_exception());
+    }
+
+    Phase phase = next_phase(Phase::INIT);
+    while (phase != Phase::DONE) {
+      if (serializer && !m_failed.load(std::memory_order_relaxed)) {
+        try {
+          if (phase == Phase::SERIALIZE) {
+            measure(result.serialize, [&serializer]() {serializer->serialize();});
+          } else {
+            measure(result.deserialize, [&serializer]() {serializer->deserialize();});
+          }
+        } catch (...) {
+          set_error(std::current_exception());
+        }
+      }
+      phase = next_phase(phase);
+    }
+  }
+
+  template<typename Call>
+  void measure(SerializationPhaseResult & result, Call call)
+  {
+    const std::uint64_t allocations = AllocationCounter::allocations();
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + m_duration;
+    auto now = start;
+    std::uint64_t calls = 0;
+    do {
+      for (unsigned i = 0; i < s_batch_size; ++i) {
+        call();
+      }
+      calls += s_batch_size;
+      now = std::chrono::steady_clock::now();
+    } while (now < end);
+    result.calls = calls;
+    result.busy = now - start;
+    result.allocations = AllocationCounter::allocations() - allocations;
+  }
+
+  void set_error(const std::exception_ptr error)
+  {
+    std::lock_guard<std::mutex> lock(m_error_mutex);
+    if (!m_error) {
+      m_error = error;
+    }
+    m_failed.store(true, std::memory_order_relaxed);
+  }
+
+  static void add(SerializationPhaseResult & total, const SerializationPhaseResult & thread)
+  {
+    total.calls += thread.calls;
+    total.busy += thread.busy;
+    total.allocations += thread.allocations;
+  }
+
+  const SerializerConfig m_config;
+  const std::chrono::nanoseconds m_duration;
+  unsigned m_threads = 0;
+  std::atomic<unsigned> m_ready{0};
+  std::atomic<Phase> m_phase{Phase::INIT};
+  std::atomic<bool> m_failed{false};
+  std::mutex m_error_mutex;
+  std::exception_ptr m_error;
+};
+
+}  // namespace performance_test
+
+#endif  // SERIALIZATION_BENCHMARK__SERIALIZATION_BENCHMARK_HPP_
@@ -0,0 +1,516 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERIALIZATION_BENCHMARK__SERIALIZERS_HPP_
+#define SERIALIZATION_BENCHMARK__SERIALIZERS_HPP_
+
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+  #include <rclcpp/serialization.hpp>
+  #include <rclcpp/serialized_message.hpp>
+#endif
+
+#ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
+  #include <fastdds/rtps/common/SerializedPayload.h>
+#endif
+
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_ENABLED
+  #include <dds/dds.h>
+  #include <dds/ddsi/ddsi_serdata.h>
+#endif
+
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_CXX_ENABLED
+  #include <dds/dds.hpp>
+  #include <dds/ddsi/ddsi_serdata.h>
+#endif
+
+#ifdef PERFORMANCE_TEST_CONNEXTDDS_ENABLED
+  #include <ndds/ndds_cpp.h>
+#endif
+
+#ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
+  #include <ace/Message_Block.h>
+  #include <dds/DCPS/Serializer.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../utilities/msg_traits.hpp"
+
+namespace performance_test
+{
+
+/// The settings every serializer is created with.
+struct SerializerConfig
+{
+  /// The number of bytes of an unbounded sequence or string.
+  std::size_t unbounded_msg_size = 0;
+  /// The DDS domain of the entities a plugin needs for its type support.
+  std::uint32_t dds_domain_id = 0;
+};
+
+/*
+ * Every serializer owns a sample and a buffer, and provides:
+ * * plugin_name(): The name of the plugin, as for the perf_test communication option.
+ * * supports_message(): Whether the plugin supports the message type.
+ * * serialize(): Serializes the sample into the buffer and returns the serialized size.
+ * * deserialize(): Deserializes the buffer into a second sample.
+ * A serializer is only used by a single thread.
+ */
+
+#ifdef PERFORMANCE_TEST_RCLCPP_ENABLED
+/// Serializes with the rosidl type support of the RMW implementation, through rclcpp.
+template<class Msg>
+class RclcppSerializer
+{
+  using DataType = typename Msg::RosType;
+
+public:
+  explicit RclcppSerializer(const SerializerConfig & config)
+  : m_data(std::make_unique<DataType>()),
+    m_received(std::make_unique<DataType>())
+  {
+    init_bounded_sequence(*m_data);
+    init_unbounded_sequence(*m_data, config.unbounded_msg_size);
+    init_unbounded_string(*m_data, config.unbounded_msg_size);
+  }
+
+  static std::string plugin_name()
+  {
+    return "rclcpp";
+  }
+
+  static bool supports_message()
+  {
+    return true;
+  }
+
+  std::size_t serialize()
+  {
+    m_serialization.serialize_message(m_data.get(), &m_serialized_msg);
+    return m_serialized_msg.size();
+  }
+
+  void deserialize()
+  {
+    m_serialization.deserialize_message(&m_serialized_msg, m_received.get());
+  }
+
+private:
+  template<typename T>
+  std::enable_if_t<msg_traits::has_bounded_sequence<T>::value>
+  init_bounded_sequence(T & msg)
+  {
+    msg.bounded_sequence.resize(msg.bounded_sequence.capacity());
+  }
+
+  template<typename T>
+  std::enable_if_t<!msg_traits::has_bounded_sequence<T>::value>
+  init_bounded_sequence(T &) {}
+
+  template<typename T>
+  std::enable_if_t<msg_traits::has_unbounded_sequence<T>::value>
+  init_unbounded_sequence(T & msg, const std::size_t size)
+  {
+    msg.unbounded_sequence.resize(size);
+  }
+
+  template<typename T>
+  std::enable_if_t<!msg_traits::has_unbounded_sequence<T>::value>
+  init_unbounded_sequence(T &, const std::size_t) {}
+
+  template<typename T>
+  std::enable_if_t<msg_traits::has_unbounded_string<T>::value>
+  init_unbounded_string(T & msg, const std::size_t size)
+  {
+    msg.unbounded_string.resize(size);
+  }
+
+  template<typename T>
+  std::enable_if_t<!msg_traits::has_unbounded_string<T>::value>
+  init_unbounded_string(T &, const std::size_t) {}
+
+  std::unique_ptr<DataType> m_data;
+  std::unique_ptr<DataType> m_received;
+  rclcpp::Serialization<DataType> m_serialization;
+  rclcpp::SerializedMessage m_serialized_msg;
+};
+#endif
+
+#ifdef PERFORMANCE_TEST_FASTRTPS_ENABLED
+/// Serializes with the Fast CDR code which Fast DDS generates for the topic type.
+template<class Msg>
+class FastDDSSerializer
+{
+  using DataType = typename Msg::EprosimaType;
+
+public:
+  explicit FastDDSSerializer(const SerializerConfig &)
+  : m_data(std::make_unique<DataType>()),
+    m_received(std::make_unique<DataType>()),
+    m_payload(m_type.getSerializedSizeProvider(m_data.get())())
+  {
+  }
+
+  static std::string plugin_name()
+  {
+    return "FastDDS";
+  }
+
+  static bool supports_message()
+  {
+    return msg_traits::is_fixed_size<DataType>::value;
+  }
+
+  std::size_t serialize()
+  {
+    if (!m_type.serialize(m_data.get(), &m_payload)) {
+      throw std::runtime_error("Fast DDS could not serialize the sample");
+    }
+    return m_payload.length;
+  }
+
+  void deserialize()
+  {
+    m_payload.pos = 0;
+    if (!m_type.deserialize(&m_payload, m_received.get())) {
+      throw std::runtime_error("Fast DDS could not deserialize the sample");
+    }
+  }
+
+private:
+  typename Msg::EprosimaTopicType m_type;
+  std::unique_ptr<DataType> m_data;
+  std::unique_ptr<DataType> m_received;
+  eprosima::fastrtps::rtps::SerializedPayload_t m_payload;
+};
+#endif
+
+#if defined(PERFORMANCE_TEST_CYCLONEDDS_ENABLED) || defined(PERFORMANCE_TEST_CYCLONEDDS_CXX_ENABLED)
+/**
+ * \brief Converts between samples and the serialized data of the sertype of a topic.
+ *
+ * These are the functions a Cyclone DDS writer and reader call, so the C and the C++ binding
+ * are measured the same way. The serialized data of the previous call is released when the
+ * next one is created, as a writer does after sending it.
+ */
+class CycloneDDSSerdata
+{
+public:
+  CycloneDDSSerdata() = default;
+  CycloneDDSSerdata & operator=(const CycloneDDSSerdata &) = delete;
+  CycloneDDSSerdata(const CycloneDDSSerdata &) = delete;
+
+  ~CycloneDDSSerdata()
+  {
+    if (m_serdata != nullptr) {
+      ddsi_serdata_unref(m_serdata);
+    }
+  }
+
+  /// Looks up the sertype of the \param topic.
+  void init(const dds_entity_t topic)
+  {
+    if (dds_get_entity_sertype(topic, &m_sertype) < 0) {
+      throw std::runtime_error("Could not get the Cyclone DDS sertype of the topic");
+    }
+  }
+
+  std::size_t serialize(const void * sample)
+  {
+    if (m_serdata != nullptr) {
+      ddsi_serdata_unref(m_serdata);
+    }
+    m_serdata = ddsi_serdata_from_sample(m_sertype, SDK_DATA, sample);
+    if (m_serdata == nullptr) {
+      throw std::runtime_error("Cyclone DDS could not serialize the sample");
+    }
+    return ddsi_serdata_size(m_serdata);
+  }
+
+  void deserialize(void * sample)
+  {
+    if (!ddsi_serdata_to_sample(m_serdata, sample, nullptr, nullptr)) {
+      throw std::runtime_error("Cyclone DDS could not deserialize the sample");
+    }
+  }
+
+private:
+  const struct ddsi_sertype * m_sertype = nullptr;
+  struct ddsi_serdata * m_serdata = nullptr;
+};
+#endif
+
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_ENABLED
+/// Serializes with the sertype which Cyclone DDS creates from the generated topic descriptor.
+template<class Msg>
+class CycloneDDSSerializer
+{
+  using DataType = typename Msg::CycloneDDSType;
+
+public:
+  explicit CycloneDDSSerializer(const SerializerConfig & config)
+  : m_data(std::make_unique<DataType>()),
+    m_received(std::make_unique<DataType>()),
+    m_topic(dds_create_topic(
+        participant(config), Msg::CycloneDDSDesc(),
+        ("serialization_c_" + Msg::msg_name()).c_str(), nullptr, nullptr))
+  {
+    if (m_topic < 0) {
+      throw std::runtime_error("Could not create a Cyclone DDS topic");
+    }
+    m_serdata.init(m_topic);
+  }
+
+  CycloneDDSSerializer & operator=(const CycloneDDSSerializer &) = delete;
+  CycloneDDSSerializer(const CycloneDDSSerializer &) = delete;
+
+  ~CycloneDDSSerializer()
+  {
+    dds_delete(m_topic);
+  }
+
+  static std::string plugin_name()
+  {
+    return "CycloneDDS";
+  }
+
+  static bool supports_message()
+  {
+    return msg_traits::is_fixed_size<DataType>::value;
+  }
+
+  std::size_t serialize()
+  {
+    return m_serdata.serialize(m_data.get());
+  }
+
+  void deserialize()
+  {
+    m_serdata.deserialize(m_received.get());
+  }
+
+private:
+  /// The participant the topics are created on. It sends discovery data, but no samples.
+  static dds_entity_t participant(const SerializerConfig & config)
+  {
+    static const dds_entity_t participant =
+      dds_create_participant(config.dds_domain_id, nullptr, nullptr);
+    if (participant < 0) {
+      throw std::runtime_error("Could not create a Cyclone DDS participant");
+    }
+    return participant;
+  }
+
+  std::unique_ptr<DataType> m_data;
+  std::unique_ptr<DataType> m_received;
+  dds_entity_t m_topic;
+  CycloneDDSSerdata m_serdata;
+};
+#endif
+
+#ifdef PERFORMANCE_TEST_CYCLONEDDS_CXX_ENABLED
+/// Serializes with the sertype of the Cyclone DDS C++ binding for the generated type.
+template<class Msg>
+class CycloneDDSCXXSerializer
+{
+  using DataType = typename Msg::CycloneDDSCXXType;
+
+public:
+  explicit CycloneDDSCXXSerializer(const SerializerConfig & config)
+  : m_data(std::make_unique<DataType>()),
+    m_received(std::make_unique<DataType>()),
+    m_topic(participant(config), "serialization_cxx_" + Msg::msg_name())
+  {
+    m_serdata.init(m_topic.delegate()->get_ddsc_entity());
+  }
+
+  static std::string plugin_name()
+  {
+    return "CycloneDDS-CXX";
+  }
+
+  static bool supports_message()
+  {
+    return msg_traits::is_fixed_size<DataType>::value;
+  }
+
+  std::size_t serialize()
+  {
+    return m_serdata.serialize(m_data.get());
+  }
+
+  void deserialize()
+  {
+    m_serdata.deserialize(m_received.get());
+  }
+
+private:
+  /// The participant the topics are created on. It sends discovery data, but no samples.
+  static dds::domain::DomainParticipant participant(const SerializerConfig & config)
+  {
+    static const dds::domain::DomainParticipant participant(config.dds_domain_id);
+    return participant;
+  }
+
+  std::unique_ptr<DataType> m_data;
+  std::unique_ptr<DataType> m_received;
+  dds::topic::Topic<DataType> m_topic;
+  CycloneDDSSerdata m_serdata;
+};
+#endif
+
+#ifdef PERFORMANCE_TEST_CONNEXTDDS_ENABLED
+/// Serializes with the type plugin which rtiddsgen generates for the type.
+template<class Msg>
+class ConnextDDSSerializer
+{
+  using DataType = typename Msg::ConnextDDSType;
+  using TypeSupport = typename DataType::TypeSupport;
+
+public:
+  explicit ConnextDDSSerializer(const SerializerConfig &)
+  : m_data(TypeSupport::create_data()),
+    m_received(TypeSupport::create_data())
+  {
+    if (m_data == nullptr || m_received == nullptr) {
+      throw std::runtime_error("Could not create a Connext DDS sample");
+    }
+    // Without a buffer, only the serialized size is returned.
+    unsigned int length = 0;
+    if (TypeSupport::serialize_data_to_cdr_buffer(nullptr, length, m_data) != DDS_RETCODE_OK) {
+      throw std::runtime_error("Could not get the Connext DDS serialized size");
+    }
+    m_buffer.resize(length);
+  }
+
+  ConnextDDSSerializer & operator=(const ConnextDDSSerializer &) = delete;
+  ConnextDDSSerializer(const ConnextDDSSerializer &) = delete;
+
+  ~ConnextDDSSerializer()
+  {
+    TypeSupport::delete_data(m_received);
+    TypeSupport::delete_data(m_data);
+  }
+
+  static std::string plugin_name()
+  {
+    return "ConnextDDS";
+  }
+
+  static bool supports_message()
+  {
+    return msg_traits::is_fixed_size<DataType>::value;
+  }
+
+  std::size_t serialize()
+  {
+    m_length = static_cast<unsigned int>(m_buffer.size());
+    if (TypeSupport::serialize_data_to_cdr_buffer(m_buffer.data(), m_length, m_data) !=
+      DDS_RETCODE_OK)
+    {
+      throw std::runtime_error("Connext DDS could not serialize the sample");
+    }
+    return m_length;
+  }
+
+  void deserialize()
+  {
+    if (TypeSupport::deserialize_data_from_cdr_buffer(m_received, m_buffer.data(), m_length) !=
+      DDS_RETCODE_OK)
+    {
+      throw std::runtime_error("Connext DDS could not deserialize the sample");
+    }
+  }
+
+private:
+  DataType * m_data;
+  DataType * m_received;
+  std::vector<char> m_buffer;
+  unsigned int m_length = 0;
+};
+#endif
+
+#ifdef PERFORMANCE_TEST_OPENDDS_ENABLED
+/// Serializes with the CDR operators which opendds_idl generates for the type.
+template<class Msg>
+class OpenDDSSerializer
+{
+  using DataType = typename Msg::OpenDDSTopicType;
+
+public:
+  explicit OpenDDSSerializer(const SerializerConfig &)
+  : m_data(std::make_unique<DataType>()),
+    m_received(std::make_unique<DataType>()),
+    m_block(serialized_size(*m_data))
+  {
+  }
+
+  static std::string plugin_name()
+  {
+    return "OpenDDS";
+  }
+
+  static bool supports_message()
+  {
+    return msg_traits::is_fixed_size<DataType>::value;
+  }
+
+  std::size_t serialize()
+  {
+    m_block.reset();
+    OpenDDS::DCPS::Serializer serializer(
+      &m_block, false, OpenDDS::DCPS::Serializer::ALIGN_CDR);
+    if (!(serializer << *m_data)) {
+      throw std::runtime_error("OpenDDS could not serialize the sample");
+    }
+    return m_block.length();
+  }
+
+  void deserialize()
+  {
+    char * const start = m_block.rd_ptr();
+    OpenDDS::DCPS::Serializer serializer(
+      &m_block, false, OpenDDS::DCPS::Serializer::ALIGN_CDR);
+    const bool deserialized = serializer >> *m_received;
+    m_block.rd_ptr(start);
+    if (!deserialized) {
+      throw std::runtime_error("OpenDDS could not deserialize the sample");
+    }
+  }
+
+private:
+  static std::size_t serialized_size(const DataType & sample)
+  {
+    std::size_t size = 0;
+    std::size_t padding = 0;
+    OpenDDS::DCPS::gen_find_size(sample, size, padding);
+    return size + padding;
+  }
+
+  std::unique_ptr<DataType> m_data;
+  std::unique_ptr<DataType> m_received;
+  ACE_Message_Block m_block;
+};
+#endif
+
+}  // namespace performance_test
+
+#endif  // SERIALIZATION_BENCHMARK__SERIALIZERS_HPP_
@@ -68,7 +68,41 @@ public:
     write(writer, "with_security", ec.is_with_security());
     write(writer, "is_zero_copy_transfer", ec.is_zero_copy_transfer());
     write(writer, "roundtrip_mode", to_string(ec.roundtrip_mode()));
+    write(writer, "intra_process_ownership", to_string(ec.intra_process_ownership()));
+    write(writer, "executor_threads", ec.executor_threads());
+    write(writer, "callback_group_mode", to_string(ec.callback_group_mode()));
+    write(writer, "fastdds_transport", to_string(ec.fastdds_transport()));
+    write(writer, "opendds_transport", to_string(ec.opendds_transport()));
+    write(writer, "shm_history_depth", ec.shm_history_depth());
+    write(writer, "max_samples_per_take", ec.max_samples_per_take());
+    write(writer, "delivery_mode", to_string(ec.delivery_mode()));
+    write(writer, "iceoryx_introspection", ec.iceoryx_introspection());
+    write(writer, "connext_micro_shmem_message_count", ec.connext_micro_shmem_message_count());
+    write(writer, "connext_micro_shmem_buffer_size", ec.connext_micro_shmem_buffer_size());
+    write(writer, "shm_ring_slots", ec.shm_ring_slots());
+    write(writer, "shm_ring_payload_size", ec.shm_ring_payload_size());
+    write(writer, "shm_ring_wakeup", to_string(ec.shm_ring_wakeup()));
+    write(writer, "intra_queue_depth", ec.intra_queue_depth());
+    write(writer, "intra_queue_transfer", to_string(ec.intra_queue_transfer()));
+    write(writer, "udp_raw_port", ec.udp_raw_port());
+    write(writer, "udp_raw_datagram_size", ec.udp_raw_datagram_size());
+    write(writer, "udp_raw_sndbuf", ec.udp_raw_sndbuf());
+    write(writer, "udp_raw_rcvbuf", ec.udp_raw_rcvbuf());
+    write(writer, "udp_raw_offload", ec.udp_raw_offload());
+    write(writer, "stream_socket", to_string(ec.stream_socket()));
+    write(writer, "stream_backend", to_string(ec.stream_backend()));
+    write(writer, "stream_port", ec.stream_port());
+    write(writer, "harness_floor_measured", ec.harness_floor().measured);
+    write(writer, "harness_floor_samples", ec.harness_floor().samples);
+    write(writer, "harness_floor_latency_min", ec.harness_floor().latency_min);
+    write(writer, "harness_floor_latency_mean", ec.harness_floor().latency_mean);
+    write(writer, "harness_floor_latency_max", ec.harness_floor().latency_max);
+    write(writer, "harness_floor_cpu_per_sample", ec.harness_floor().cpu_per_sample);
     write(writer, "is_rt_init_required", ec.is_rt_init_required());
+    std::ostringstream thread_rules;
+    thread_rules << ec.thread_rules();
+    write(writer, "thread_rules", thread_rules.str());
+    write(writer, "sample_run_delay", ec.sample_run_delay());
     write(writer, "external_info_githash", ec.get_external_info().m_githash);
     write(writer, "external_info_platform", ec.get_external_info().m_platform);
     write(writer, "external_info_branch", ec.get_external_info().m_branch);
@@ -82,6 +116,7 @@ public:
       write(writer, "experiment_start", ar->m_experiment_start);
       write(writer, "loop_start", ar->m_loop_start);
       write(writer, "num_samples_received", ar->m_num_samples_received);
+      write(writer, "num_samples_received_shm", ar->m_num_samples_received_shm);
       write(writer, "num_samples_sent", ar->m_num_samples_sent);
       write(writer, "num_samples_lost", ar->m_num_samples_lost);
       write(writer, "total_data_received", ar->m_total_data_received);
@@ -91,6 +126,12 @@ public:
       write(writer, "latency_mean", ar->m_latency.mean());
       write(writer, "latency_M2", ar->m_latency.m2());
       write(writer, "latency_variance", ar->m_latency.variance());
+      write(writer, "run_delay_min", ar->m_run_delay.min());
+      write(writer, "run_delay_max", ar->m_run_delay.max());
+      write(writer, "run_delay_n", ar->m_run_delay.n());
+      write(writer, "run_delay_mean", ar->m_run_delay.mean());
+      write(writer, "run_delay_M2", ar->m_run_delay.m2());
+      write(writer, "run_delay_variance", ar->m_run_delay.variance());
       write(writer, "pub_loop_time_reserve_min", ar->m_pub_loop_time_reserve.min());
       write(writer, "pub_loop_time_reserve_max", ar->m_pub_loop_time_reserve.max());
       write(writer, "pub_loop_time_reserve_n", ar->m_pub_loop_time_reserve.n());
@@ -103,6 +144,24 @@ public:
       write(writer, "sub_loop_time_reserve_mean", ar->m_sub_loop_time_reserve.mean());
       write(writer, "sub_loop_time_reserve_M2", ar->m_sub_loop_time_reserve.m2());
       write(writer, "sub_loop_time_reserve_variance", ar->m_sub_loop_time_reserve.variance());
+      write(writer, "serialization_min", ar->m_serialization.min());
+      write(writer, "serialization_max", ar->m_serialization.max());
+      write(writer, "serialization_n", ar->m_serialization.n());
+      write(writer, "serialization_mean", ar->m_serialization.mean());
+      write(writer, "serialization_M2", ar->m_serialization.m2());
+      write(writer, "serialization_variance", ar->m_serialization.variance());
+      write(writer, "deserialization_min", ar->m_deserialization.min());
+      write(writer, "deserialization_max", ar->m_deserialization.max());
+      write(writer, "deserialization_n", ar->m_deserialization.n());
+      write(writer, "deserialization_mean", ar->m_deserialization.mean());
+      write(writer, "deserialization_M2", ar->m_deserialization.m2());
+      write(writer, "deserialization_variance", ar->m_deserialization.variance());
+      write(writer, "samples_per_wakeup_min", ar->m_samples_per_wakeup.min());
+      write(writer, "samples_per_wakeup_max", ar->m_samples_per_wakeup.max());
+      write(writer, "samples_per_wakeup_n", ar->m_samples_per_wakeup.n());
+      write(writer, "samples_per_wakeup_mean", ar->m_samples_per_wakeup.mean());
+      write(writer, "samples_per_wakeup_M2", ar->m_samples_per_wakeup.m2());
+      write(writer, "samples_per_wakeup_variance", ar->m_samples_per_wakeup.variance());
 #if !defined(WIN32)
       write(writer, "sys_tracker_ru_utime", ar->m_sys_usage.ru_utime);
       write(writer, "sys_tracker_ru_stime", ar->m_sys_usage.ru_stime);
@@ -123,6 +182,57 @@ public:
 #endif
       write(writer, "cpu_info_cpu_cores", ar->m_cpu_info.cpu_cores());
       write(writer, "cpu_info_cpu_usage", ar->m_cpu_info.cpu_usage());
+#ifdef PERFORMANCE_TEST_ICEORYX_ENABLED
+      write(writer, "iox_mempool_max_usage", ar->m_iceoryx_info.mempool_max_usage);
+      write(writer, "iox_mempool_min_free_chunks", ar->m_iceoryx_info.mempool_min_free_chunks);
+      write(writer, "iox_queue_max_fill", ar->m_iceoryx_info.queue_max_fill);
+      write(writer, "iox_queue_capacity", ar->m_iceoryx_info.queue_capacity);
+      write(writer, "iox_queue_overflows", ar->m_iceoryx_info.queue_overflows);
+      write(writer, "iox_chunk_size", ar->m_iceoryx_info.chunk_size);
+      write(writer, "iox_chunk_unused", ar->m_iceoryx_info.chunk_unused);
+#endif
+#ifdef PERFORMANCE_TEST_SHM_RING_ENABLED
+      write(writer, "shm_ring_wakeups", ar->m_shm_ring_wakeup_info.wakeups);
+      write(writer, "shm_ring_wakeup_p50", ar->m_shm_ring_wakeup_info.latency_p50);
+      write(writer, "shm_ring_wakeup_p90", ar->m_shm_ring_wakeup_info.latency_p90);
+      write(writer, "shm_ring_wakeup_p99", ar->m_shm_ring_wakeup_info.latency_p99);
+      write(writer, "shm_ring_wakeup_p999", ar->m_shm_ring_wakeup_info.latency_p999);
+      write(writer, "shm_ring_wakeup_max", ar->m_shm_ring_wakeup_info.latency_max);
+#endif
+#ifdef PERFORMANCE_TEST_UDP_RAW_ENABLED
+      write(writer, "udp_socket_drops", ar->m_udp_drop_info.socket_drops);
+      write(writer, "udp_rcvbuf_errors", ar->m_udp_drop_info.rcvbuf_errors);
+      write(writer, "udp_sndbuf_errors", ar->m_udp_drop_info.sndbuf_errors);
+#endif
+#ifdef PERFORMANCE_TEST_STREAM_ENABLED
+      write(
+        writer, "stream_pub_syscalls_per_sample", StreamSyscallInfo::per_sample(
+          ar->m_stream_syscall_info.publisher_syscalls, ar->m_num_samples_sent));
+      write(
+        writer, "stream_sub_syscalls_per_sample", StreamSyscallInfo::per_sample(
+          ar->m_stream_syscall_info.subscriber_syscalls, ar->m_num_samples_received));
+#endif
+      write_perf_counters(writer, "pub", ar->m_pub_perf_counters);
+      write_perf_counters(writer, "sub", ar->m_sub_perf_counters);
+      write_sched_info(writer, "pub", ar->m_pub_sched_info);
+      write_sched_info(writer, "sub", ar->m_sub_sched_info);
+      write(writer, "threads_cpu_time", ThreadUsageInfo::total_cpu_time(ar->m_thread_usage));
+      write(writer, "cpu_per_sample", ar->cpu_per_sample());
+      write(writer, "cpu_per_byte", ar->cpu_per_byte());
+      writer.String("threads");
+      writer.StartArray();
+      for (const auto & thread : ar->m_thread_usage) {
+        writer.StartObject();
+        write(writer, "tid", thread.tid);
+        write(writer, "name", thread.name);
+        write(writer, "utime", thread.utime);
+        write(writer, "stime", thread.stime);
+        write(writer, "voluntary_switches", thread.voluntary_switches);
+        write(writer, "involuntary_switches", thread.involuntary_switches);
+        write(writer, "last_cpu", thread.last_cpu);
+        writer.EndObject();
+      }
+      writer.EndArray();
       writer.EndObject();
     }
     writer.EndArray();
@@ -145,6 +255,35 @@ private:
     return oss.str();
   }
 
+  /// Writes the summed perf counters of the threads with the \param role "pub" or "sub".
+  template<typename Writer>
+  static void write_perf_counters(
+    Writer & writer, const std::string & role, const std::vector<PerfCounterInfo> & infos)
+  {
+    const auto total = PerfCounterInfo::sum(infos);
+    write(writer, (role + "_perf_counters_available").c_str(), total.available);
+    write(writer, (role + "_cycles").c_str(), total.cycles);
+    write(writer, (role + "_instructions").c_str(), total.instructions);
+    write(writer, (role + "_ipc").c_str(), total.ipc());
+    write(writer, (role + "_llc_misses").c_str(), total.llc_misses);
+    write(writer, (role + "_branch_misses").c_str(), total.branch_misses);
+    write(writer, (role + "_context_switches").c_str(), total.context_switches);
+  }
+
+  /// Writes the summed scheduler statistics of the threads with the \param role "pub" or "sub".
+  template<typename Writer>
+  static void write_sched_info(
+    Writer & writer, const std::string & role, const std::vector<SchedInfo> & infos)
+  {
+    const auto total = SchedInfo::sum(infos);
+    write(writer, (role + "_sched_stats_available").c_str(), total.available);
+    write(writer, (role + "_run_delay").c_str(), total.run_delay);
+    write(writer, (role + "_timeslices").c_str(), total.timeslices);
+    write(
+      writer, (role + "_run_delay_per_timeslice").c_str(), total.run_delay_per_timeslice());
+    write(writer, (role + "_migrations").c_str(), total.migrations);
+  }
+
   template<typename Writer>
   static void write(Writer & writer, const char * key, const std::string & val)
   {
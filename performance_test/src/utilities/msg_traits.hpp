@@ -0,0 +1,63 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILITIES__MSG_TRAITS_HPP_
+#define UTILITIES__MSG_TRAITS_HPP_
+
+#include <type_traits>
+#include <utility>
+
+namespace performance_test
+{
+
+/// Detects the variable-size fields of the message types.
+namespace msg_traits
+{
+// TODO(erik.snider) switch to std::void_t when upgrading to C++17
+template<class ...>
+using void_t = void;
+
+// The plugins generate either data members or accessor functions for the fields.
+#define PERFORMANCE_TEST_HAS_FIELD(field) \
+  template<typename T, typename = void> \
+  struct has_ ## field ## _member : std::false_type {}; \
+  template<typename T> \
+  struct has_ ## field ## _member<T, void_t<decltype(std::declval<T &>().field)>> \
+    : std::true_type {}; \
+  template<typename T, typename = void> \
+  struct has_ ## field ## _accessor : std::false_type {}; \
+  template<typename T> \
+  struct has_ ## field ## _accessor<T, void_t<decltype(std::declval<T &>().field())>> \
+    : std::true_type {}; \
+  template<typename T> \
+  struct has_ ## field : std::integral_constant<bool, \
+      has_ ## field ## _member<T>::value || has_ ## field ## _accessor<T>::value> {};
+
+PERFORMANCE_TEST_HAS_FIELD(bounded_sequence)
+PERFORMANCE_TEST_HAS_FIELD(unbounded_sequence)
+PERFORMANCE_TEST_HAS_FIELD(unbounded_string)
+
+#undef PERFORMANCE_TEST_HAS_FIELD
+
+/// Whether the message has a fixed size, which most plugins of perf_test require.
+template<typename T>
+struct is_fixed_size : std::integral_constant<bool,
+    !has_bounded_sequence<T>::value &&
+    !has_unbounded_sequence<T>::value &&
+    !has_unbounded_string<T>::value> {};
+}  // namespace msg_traits
+
+}  // namespace performance_test
+
+#endif  // UTILITIES__MSG_TRAITS_HPP_
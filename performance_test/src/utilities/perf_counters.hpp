@@ -0,0 +1,235 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILITIES__PERF_COUNTERS_HPP_
+#define UTILITIES__PERF_COUNTERS_HPP_
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace performance_test
+{
+
+/// The hardware performance counters of one or more threads during one experiment interval.
+struct PerfCounterInfo
+{
+  /// Whether at least one counter could be opened.
+  bool available = false;
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  /// The last level cache misses.
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+  uint64_t context_switches = 0;
+
+  /// Returns the instructions per cycle.
+  double ipc() const
+  {
+    return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+  }
+
+  PerfCounterInfo & operator+=(const PerfCounterInfo & other)
+  {
+    available = available || other.available;
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llc_misses += other.llc_misses;
+    branch_misses += other.branch_misses;
+    context_switches += other.context_switches;
+    return *this;
+  }
+
+  /// Returns the sum of the counters of several threads.
+  static PerfCounterInfo sum(const std::vector<PerfCounterInfo> & infos)
+  {
+    PerfCounterInfo total;
+    for (const auto & info : infos) {
+      total += info;
+    }
+    return total;
+  }
+};
+
+/**
+ * \brief A group of hardware performance counters for a single thread.
+ *
+ * The counters are opened with perf_event_open as one group, so they are scheduled onto the
+ * PMU together and their ratios are consistent. If the kernel has to multiplex the group, the
+ * counts are scaled to the time it was enabled. Counters which can not be opened, for example
+ * because of /proc/sys/kernel/perf_event_paranoid or a virtual machine without a PMU, are
+ * reported as 0, and a warning is printed once per process.
+ */
+class PerfCounterGroup
+{
+public:
+  PerfCounterGroup() = default;
+  PerfCounterGroup & operator=(const PerfCounterGroup &) = delete;
+  PerfCounterGroup(const PerfCounterGroup &) = delete;
+
+  ~PerfCounterGroup()
+  {
+#if defined(__linux__)
+    for (const auto & counter : m_counters) {
+      ::close(counter.fd);
+    }
+#endif  // defined(__linux__)
+  }
+
+  /// Opens and starts the counters for the calling thread.
+  void open()
+  {
+#if defined(__linux__)
+    std::string failed;
+    int error = 0;
+    for (const auto & event : events()) {
+      const int fd = open_event(event);
+      if (fd < 0) {
+        error = errno;
+        failed += failed.empty() ? event.name : std::string(", ") + event.name;
+        continue;
+      }
+      m_counters.push_back({event.field, fd});
+    }
+    if (!m_counters.empty()) {
+      ::ioctl(m_counters.front().fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(m_counters.front().fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      m_previous.assign(m_counters.size(), 0);
+    }
+    if (!failed.empty()) {
+      warn("Could not open the perf counters " + failed + ": " + std::strerror(error));
+    }
+#else
+    warn("The perf counters are only supported on Linux");
+#endif  // defined(__linux__)
+  }
+
+  /// Returns the counts since the previous call, or since open() for the first call.
+  PerfCounterInfo sample()
+  {
+    PerfCounterInfo info;
+#if defined(__linux__)
+    if (m_counters.empty()) {
+      return info;
+    }
+    // The layout of a group read with PERF_FORMAT_TOTAL_TIME_ENABLED and _RUNNING.
+    std::vector<uint64_t> values(3 + m_counters.size());
+    const auto size = static_cast<ssize_t>(values.size() * sizeof(uint64_t));
+    if (::read(m_counters.front().fd, values.data(), values.size() * sizeof(uint64_t)) != size) {
+      return info;
+    }
+    const uint64_t time_enabled = values[1];
+    const uint64_t time_running = values[2];
+    info.available = true;
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+      uint64_t total = values[3 + i];
+      if (time_running > 0 && time_running < time_enabled) {
+        total = static_cast<uint64_t>(
+          static_cast<double>(total) * static_cast<double>(time_enabled) /
+          static_cast<double>(time_running));
+      }
+      info.*m_counters[i].field = total > m_previous[i] ? total - m_previous[i] : 0;
+      m_previous[i] = total;
+    }
+#endif  // defined(__linux__)
+    return info;
+  }
+
+private:
+#if defined(__linux__)
+  struct Event
+  {
+    const char * name;
+    uint32_t type;
+    uint64_t config;
+    uint64_t PerfCounterInfo::* field;
+  };
+
+  struct Counter
+  {
+    uint64_t PerfCounterInfo::* field;
+    int fd;
+  };
+
+  static const std::vector<Event> & events()
+  {
+    static const std::vector<Event> events = {
+      {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounterInfo::cycles},
+      {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,
+        &PerfCounterInfo::instructions},
+      {"LLC misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,
+        &PerfCounterInfo::llc_misses},
+      {"branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,
+        &PerfCounterInfo::branch_misses},
+      {"context switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES,
+        &PerfCounterInfo::context_switches},
+    };
+    return events;
+  }
+
+  /// Opens the \param event in the group, falling back to user space only counting.
+  int open_event(const Event & event) const
+  {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.read_format =
+      PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_hv = 1;
+    const bool leader = m_counters.empty();
+    attr.disabled = leader ? 1 : 0;
+    const int group_fd = leader ? -1 : m_counters.front().fd;
+
+    int fd = perf_event_open(attr, group_fd);
+    if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+      attr.exclude_kernel = 1;
+      fd = perf_event_open(attr, group_fd);
+    }
+    return fd;
+  }
+
+  static int perf_event_open(perf_event_attr & attr, const int group_fd)
+  {
+    // The calling thread, on any CPU.
+    return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+  }
+
+  std::vector<Counter> m_counters;
+  std::vector<uint64_t> m_previous;
+#endif  // defined(__linux__)
+
+  static void warn(const std::string & message)
+  {
+    static std::atomic<bool> warned{false};
+    if (!warned.exchange(true)) {
+      std::cerr << "WARNING: " << message << ". They are reported as 0." << std::endl;
+    }
+  }
+};
+
+}  // namespace performance_test
+
+#endif  // UTILITIES__PERF_COUNTERS_HPP_
@@ -0,0 +1,259 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILITIES__SCHED_STATS_HPP_
+#define UTILITIES__SCHED_STATS_HPP_
+
+#if defined(PERFORMANCE_TEST_LINUX)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace performance_test
+{
+
+/// The scheduler statistics of one or more threads during one experiment interval.
+struct SchedInfo
+{
+  /// Whether the statistics could be read.
+  bool available = false;
+  /// The time the threads were runnable, but waited in the run queue for a CPU, in ns.
+  uint64_t run_delay = 0;
+  /// The number of times the threads got a CPU.
+  uint64_t timeslices = 0;
+  /// The number of times the threads moved to another CPU.
+  uint64_t migrations = 0;
+
+  /// Returns the mean run queue delay in ns before the threads got a CPU.
+  double run_delay_per_timeslice() const
+  {
+    return timeslices > 0 ?
+           static_cast<double>(run_delay) / static_cast<double>(timeslices) : 0.0;
+  }
+
+  SchedInfo & operator+=(const SchedInfo & other)
+  {
+    available = available || other.available;
+    run_delay += other.run_delay;
+    timeslices += other.timeslices;
+    migrations += other.migrations;
+    return *this;
+  }
+
+  /// Returns the sum of the statistics of several threads.
+  static SchedInfo sum(const std::vector<SchedInfo> & infos)
+  {
+    SchedInfo total;
+    for (const auto & info : infos) {
+      total += info;
+    }
+    return total;
+  }
+};
+
+/**
+ * \brief Reads the scheduler statistics of a single thread from /proc/self/task/<tid>/schedstat
+ * and /proc/self/task/<tid>/sched.
+ *
+ * The files are opened once, and then only read with pread(), so sample() can be called from
+ * another thread than the one the statistics are read for.
+ * If the kernel does not provide them, they are reported as 0, and a warning is printed once
+ * per process. Only supported on Linux.
+ */
+class SchedStatReader
+{
+public:
+  SchedStatReader() = default;
+  SchedStatReader & operator=(const SchedStatReader &) = delete;
+  SchedStatReader(const SchedStatReader &) = delete;
+
+  ~SchedStatReader()
+  {
+#if defined(PERFORMANCE_TEST_LINUX)
+    for (const int fd : {m_schedstat_fd.load(), m_sched_fd}) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+  }
+
+  /// Starts reading the statistics of the calling thread.
+  void open()
+  {
+#if defined(PERFORMANCE_TEST_LINUX)
+    const std::string path = "/proc/self/task/" + std::to_string(::syscall(SYS_gettid));
+    const int schedstat_fd = ::open((path + "/schedstat").c_str(), O_RDONLY | O_CLOEXEC);
+    if (schedstat_fd < 0) {
+      warn(std::string("Could not read the scheduler statistics: ") + std::strerror(errno));
+      return;
+    }
+    // Only present if the kernel is built with CONFIG_SCHED_DEBUG.
+    m_sched_fd = ::open((path + "/sched").c_str(), O_RDONLY | O_CLOEXEC);
+    m_sched_buffer.resize(8192);
+    // Publishes the members above to sample().
+    m_schedstat_fd.store(schedstat_fd, std::memory_order_release);
+    read_run_delay(m_last_run_delay);
+#else
+    warn("The scheduler statistics are only supported on Linux");
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+  }
+
+  /**
+   * \brief Returns in \param run_delay the time in ns the thread waited in the run queue since
+   * the previous call, or since open() for the first call.
+   *
+   * Only a single read of the already opened file, so it can be called after every wakeup.
+   * Must be called from the thread which called open().
+   */
+  bool run_delay_since_last(uint64_t & run_delay)
+  {
+    uint64_t total = 0;
+    if (!read_run_delay(total)) {
+      return false;
+    }
+    run_delay = total > m_last_run_delay ? total - m_last_run_delay : 0;
+    m_last_run_delay = total;
+    return true;
+  }
+
+  /**
+   * \brief Returns the statistics since the previous call, or since the thread started for the
+   * first call.
+   *
+   * Must always be called from the same thread.
+   */
+  SchedInfo sample()
+  {
+    SchedInfo info;
+#if defined(PERFORMANCE_TEST_LINUX)
+    const int schedstat_fd = m_schedstat_fd.load(std::memory_order_acquire);
+    if (schedstat_fd < 0) {
+      return info;
+    }
+    SchedInfo total;
+    char schedstat[96];
+    if (!read_file(schedstat_fd, schedstat, sizeof(schedstat))) {
+      return info;
+    }
+    parse_schedstat(schedstat, total);
+    total.available = true;
+    if (m_sched_fd >= 0 && read_file(m_sched_fd, &m_sched_buffer[0], m_sched_buffer.size())) {
+      total.migrations = parse_migrations(m_sched_buffer.data());
+    }
+
+    info.available = true;
+    info.run_delay = delta(total.run_delay, m_previous.run_delay);
+    info.timeslices = delta(total.timeslices, m_previous.timeslices);
+    info.migrations = delta(total.migrations, m_previous.migrations);
+    m_previous = total;
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+    return info;
+  }
+
+  /// Parses the run delay and the timeslices of the zero terminated content of a schedstat file
+  /// into \param info.
+  static void parse_schedstat(const char * schedstat, SchedInfo & info)
+  {
+    // The format is "<cpu time> <run delay> <timeslices>\n".
+    char * end = nullptr;
+    std::strtoull(schedstat, &end, 10);
+    info.run_delay = std::strtoull(end, &end, 10);
+    info.timeslices = std::strtoull(end, nullptr, 10);
+  }
+
+  /// Returns the se.nr_migrations value of the zero terminated content of a sched file.
+  static uint64_t parse_migrations(const char * sched)
+  {
+    // The lines look like "se.nr_migrations                             :                   42".
+    for (const char * line = sched; line != nullptr && *line != '\0'; ) {
+      if (std::strncmp(line, "se.nr_migrations", 16) == 0) {
+        const char * separator = std::strchr(line, ':');
+        return separator == nullptr ? 0 : std::strtoull(separator + 1, nullptr, 10);
+      }
+      line = std::strchr(line, '\n');
+      if (line != nullptr) {
+        ++line;
+      }
+    }
+    return 0;
+  }
+
+private:
+  static uint64_t delta(const uint64_t current, const uint64_t previous)
+  {
+    return current > previous ? current - previous : 0;
+  }
+
+  /// Reads the file \param fd from the start into the \param buffer of \param size bytes, and
+  /// terminates it with a zero.
+  static bool read_file(const int fd, char * const buffer, const std::size_t size)
+  {
+#if defined(PERFORMANCE_TEST_LINUX)
+    const auto length = ::pread(fd, buffer, size - 1, 0);
+    if (length <= 0) {
+      return false;
+    }
+    buffer[static_cast<std::size_t>(length)] = '\0';
+    return true;
+#else
+    (void)fd;
+    (void)buffer;
+    (void)size;
+    return false;
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+  }
+
+  /// Reads the run delay in ns since the start of the thread into \param run_delay.
+  bool read_run_delay(uint64_t & run_delay) const
+  {
+    const int schedstat_fd = m_schedstat_fd.load(std::memory_order_relaxed);
+    char buffer[96];
+    if (schedstat_fd < 0 || !read_file(schedstat_fd, buffer, sizeof(buffer))) {
+      return false;
+    }
+    SchedInfo info;
+    parse_schedstat(buffer, info);
+    run_delay = info.run_delay;
+    return true;
+  }
+
+  static void warn(const std::string & message)
+  {
+    static std::atomic<bool> warned{false};
+    if (!warned.exchange(true)) {
+      std::cerr << "WARNING: " << message << ". They are reported as 0." << std::endl;
+    }
+  }
+
+  std::atomic<int> m_schedstat_fd{-1};
+  int m_sched_fd = -1;
+  std::vector<char> m_sched_buffer;
+  uint64_t m_last_run_delay = 0;
+  SchedInfo m_previous;
+};
+
+}  // namespace performance_test
+
+#endif  // UTILITIES__SCHED_STATS_HPP_
@@ -0,0 +1,316 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILITIES__THREAD_RULES_HPP_
+#define UTILITIES__THREAD_RULES_HPP_
+
+#if defined(PERFORMANCE_TEST_LINUX)
+#include <sched.h>
+#include <sys/types.h>
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "thread_usage_tracker.hpp"
+
+namespace performance_test
+{
+
+/**
+ * \brief Places the threads whose name matches a pattern on CPUs and at a SCHED_FIFO priority.
+ *
+ * A rule is written as `PATTERN=CPUS[:PRIO]`, for example `dq\.recvUniq=3:80`. PATTERN is a
+ * regular expression which is searched in the thread name, CPUS is a comma separated list of
+ * CPUs and CPU ranges like `2-3`, and PRIO is the SCHED_FIFO priority. An empty CPUS keeps the
+ * affinity, and a missing PRIO keeps the scheduling policy.
+ */
+struct ThreadRule
+{
+  std::string pattern;
+  std::vector<uint32_t> cpus;
+  int32_t prio = 0;
+
+  /// Parses the \param rule, and throws std::invalid_argument if it is malformed.
+  static ThreadRule parse(const std::string & rule)
+  {
+    const auto separator = rule.rfind('=');
+    if (separator == std::string::npos || separator == 0) {
+      throw std::invalid_argument("Invalid thread rule, expected PATTERN=CPUS[:PRIO]: " + rule);
+    }
+    ThreadRule result;
+    result.pattern = rule.substr(0, separator);
+    try {
+      std::regex{result.pattern};
+    } catch (const std::regex_error & e) {
+      throw std::invalid_argument(
+              "Invalid thread rule pattern " + result.pattern + ": " + e.what());
+    }
+
+    std::string placement = rule.substr(separator + 1);
+    const auto prio_separator = placement.find(':');
+    if (prio_separator != std::string::npos) {
+      result.prio = parse_number(placement.substr(prio_separator + 1), rule);
+      if (result.prio < 1 || result.prio > 99) {
+        throw std::invalid_argument("Invalid thread rule priority, expected 1 to 99: " + rule);
+      }
+      placement = placement.substr(0, prio_separator);
+    }
+    std::istringstream cpus(placement);
+    for (std::string cpu; std::getline(cpus, cpu, ','); ) {
+      const auto range = cpu.find('-');
+      const auto first = parse_number(cpu.substr(0, range), rule);
+      const auto last = range == std::string::npos ?
+        first : parse_number(cpu.substr(range + 1), rule);
+      if (first > last) {
+        throw std::invalid_argument("Invalid CPU range " + cpu + " in thread rule: " + rule);
+      }
+      if (last >= CPU_SETSIZE) {
+        throw std::invalid_argument(
+                "CPU " + std::to_string(last) + " out of range in thread rule: " + rule);
+      }
+      for (auto i = first; i <= last; ++i) {
+        result.cpus.push_back(static_cast<uint32_t>(i));
+      }
+    }
+    std::sort(result.cpus.begin(), result.cpus.end());
+    result.cpus.erase(std::unique(result.cpus.begin(), result.cpus.end()), result.cpus.end());
+    if (result.cpus.empty() && result.prio == 0) {
+      throw std::invalid_argument("Thread rule sets neither CPUs nor a priority: " + rule);
+    }
+    return result;
+  }
+
+private:
+  static int32_t parse_number(const std::string & number, const std::string & rule)
+  {
+    // More than 9 digits may not fit into the result.
+    if (number.empty() || number.size() > 9 ||
+      number.find_first_not_of("0123456789") != std::string::npos)
+    {
+      throw std::invalid_argument("Invalid number " + number + " in thread rule: " + rule);
+    }
+    return static_cast<int32_t>(std::stol(number));
+  }
+};
+
+/// Writes the sorted \param cpus as a list of CPUs and CPU ranges, for example `0-3,6`.
+inline std::ostream & write_cpu_list(std::ostream & stream, const std::vector<uint32_t> & cpus)
+{
+  for (std::size_t i = 0; i < cpus.size(); ) {
+    std::size_t last = i;
+    while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1) {
+      ++last;
+    }
+    stream << (i > 0 ? "," : "") << cpus[i];
+    if (last > i) {
+      stream << "-" << cpus[last];
+    }
+    i = last + 1;
+  }
+  return stream;
+}
+
+/// Outstream operator for ThreadRule.
+inline std::ostream & operator<<(std::ostream & stream, const ThreadRule & rule)
+{
+  stream << rule.pattern << "=";
+  write_cpu_list(stream, rule.cpus);
+  if (rule.prio > 0) {
+    stream << ":" << rule.prio;
+  }
+  return stream;
+}
+
+/// Outstream operator for a list of ThreadRule.
+inline std::ostream & operator<<(std::ostream & stream, const std::vector<ThreadRule> & rules)
+{
+  if (rules.empty()) {
+    return stream << "None";
+  }
+  for (std::size_t i = 0; i < rules.size(); ++i) {
+    stream << (i > 0 ? " " : "") << rules[i];
+  }
+  return stream;
+}
+
+/// Where a thread ended up after the thread rules were applied.
+struct ThreadPlacement
+{
+  int64_t tid = 0;
+  std::string name;
+  /// The rule the thread matched, or empty if it matched none.
+  std::string rule;
+  /// Why the rule could not be applied, or empty on success.
+  std::string error;
+  /// The CPUs the thread may run on.
+  std::vector<uint32_t> cpus;
+  /// The scheduling policy, for example SCHED_FIFO.
+  int policy = 0;
+  int32_t prio = 0;
+};
+
+/// Outstream operator for ThreadPlacement.
+inline std::ostream & operator<<(std::ostream & stream, const ThreadPlacement & placement)
+{
+  stream << placement.tid << " " << placement.name << ": CPUs ";
+  write_cpu_list(stream, placement.cpus);
+#if defined(PERFORMANCE_TEST_LINUX)
+  if (placement.policy == SCHED_FIFO) {
+    stream << ", FIFO " << placement.prio;
+  } else if (placement.policy == SCHED_RR) {
+    stream << ", RR " << placement.prio;
+  } else {
+    stream << ", OTHER";
+  }
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+  if (!placement.rule.empty()) {
+    stream << " (rule " << placement.rule;
+    if (!placement.error.empty()) {
+      stream << " failed: " << placement.error;
+    }
+    stream << ")";
+  }
+  return stream;
+}
+
+/**
+ * \brief Applies the thread rules to the threads of the process, including the threads the
+ * middleware spawns.
+ *
+ * Each thread is handled by the first rule matching its name, the first time apply() sees it,
+ * and again whenever its name changed since, because the middleware often names its threads
+ * only after they started. Only supported on Linux.
+ */
+class ThreadRuleApplier
+{
+public:
+  explicit ThreadRuleApplier(const std::vector<ThreadRule> & rules)
+  : m_rules(rules)
+  {
+    for (const auto & rule : m_rules) {
+      m_patterns.emplace_back(rule.pattern);
+    }
+  }
+
+  /// Applies the rules to the threads which appeared or were renamed since the previous call,
+  /// and returns where they ended up.
+  std::vector<ThreadPlacement> apply()
+  {
+    std::vector<ThreadPlacement> placements;
+#if defined(PERFORMANCE_TEST_LINUX)
+    // Only the threads which still exist are kept, so a reused thread id is handled again.
+    std::map<int64_t, std::string> handled;
+    for (const auto tid : process_thread_ids()) {
+      ThreadPlacement placement;
+      placement.tid = tid;
+      if (!read_name(tid, placement.name)) {
+        // The thread exited in the meantime.
+        continue;
+      }
+      handled.emplace(tid, placement.name);
+      const auto previous = m_handled.find(tid);
+      if (previous != m_handled.end() && previous->second == placement.name) {
+        continue;
+      }
+      for (std::size_t i = 0; i < m_rules.size(); ++i) {
+        if (std::regex_search(placement.name, m_patterns[i])) {
+          std::ostringstream rule;
+          rule << m_rules[i];
+          placement.rule = rule.str();
+          placement.error = apply_rule(static_cast<pid_t>(tid), m_rules[i]);
+          break;
+        }
+      }
+      read_placement(static_cast<pid_t>(tid), placement);
+      placements.push_back(placement);
+    }
+    m_handled = std::move(handled);
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+    return placements;
+  }
+
+private:
+#if defined(PERFORMANCE_TEST_LINUX)
+  static bool read_name(const int64_t tid, std::string & name)
+  {
+    std::ifstream comm("/proc/self/task/" + std::to_string(tid) + "/comm");
+    return static_cast<bool>(std::getline(comm, name));
+  }
+
+  /// Applies the \param rule to the thread \param tid, and returns the error, if any.
+  static std::string apply_rule(const pid_t tid, const ThreadRule & rule)
+  {
+    if (!rule.cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (const auto cpu : rule.cpus) {
+        if (cpu >= CPU_SETSIZE) {
+          return "affinity: CPU " + std::to_string(cpu) + " out of range";
+        }
+        CPU_SET(cpu, &set);
+      }
+      if (sched_setaffinity(tid, sizeof(set), &set) < 0) {
+        return std::string("affinity: ") + std::strerror(errno);
+      }
+    }
+    if (rule.prio > 0) {
+      sched_param param{};
+      param.sched_priority = rule.prio;
+      if (sched_setscheduler(tid, SCHED_FIFO, &param) < 0) {
+        return std::string("priority: ") + std::strerror(errno);
+      }
+    }
+    return "";
+  }
+
+  static void read_placement(const pid_t tid, ThreadPlacement & placement)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(tid, sizeof(set), &set) == 0) {
+      for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+          placement.cpus.push_back(cpu);
+        }
+      }
+    }
+    placement.policy = sched_getscheduler(tid);
+    sched_param param{};
+    if (sched_getparam(tid, &param) == 0) {
+      placement.prio = param.sched_priority;
+    }
+  }
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+
+  const std::vector<ThreadRule> m_rules;
+  std::vector<std::regex> m_patterns;
+  /// The name of each thread when the rules were last applied to it.
+  std::map<int64_t, std::string> m_handled;
+};
+
+}  // namespace performance_test
+
+#endif  // UTILITIES__THREAD_RULES_HPP_
@@ -0,0 +1,256 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILITIES__THREAD_USAGE_TRACKER_HPP_
+#define UTILITIES__THREAD_USAGE_TRACKER_HPP_
+
+#if defined(PERFORMANCE_TEST_LINUX)
+#include <dirent.h>
+#include <unistd.h>
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace performance_test
+{
+
+#if defined(PERFORMANCE_TEST_LINUX)
+/// Returns the ids of all threads of the process.
+inline std::vector<int64_t> process_thread_ids()
+{
+  std::vector<int64_t> tids;
+  DIR * dir = ::opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return tids;
+  }
+  while (const dirent * entry = ::readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      tids.push_back(std::strtoll(entry->d_name, nullptr, 10));
+    }
+  }
+  ::closedir(dir);
+  return tids;
+}
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+
+/// The CPU usage of one thread of the process during one experiment interval.
+struct ThreadUsageInfo
+{
+  /// The thread id.
+  int64_t tid = 0;
+  /// The thread name (comm), which identifies the threads the middleware spawns.
+  std::string name;
+  /// The CPU time spent in user space in ns.
+  uint64_t utime = 0;
+  /// The CPU time spent in the kernel in ns.
+  uint64_t stime = 0;
+  /// The CPU time in ns as accounted by the scheduler, if available.
+  uint64_t exec_time = 0;
+  /// Whether exec_time could be read.
+  bool has_exec_time = false;
+  uint64_t voluntary_switches = 0;
+  uint64_t involuntary_switches = 0;
+  /// The CPU the thread last ran on, or -1 if unknown.
+  int32_t last_cpu = -1;
+  /// The time the thread started in clock ticks after boot, which identifies a reused tid.
+  uint64_t start_time = 0;
+
+  /**
+   * \brief Returns the CPU time in ns.
+   *
+   * utime and stime only have the resolution of a clock tick, usually 10 ms, so the time
+   * accounted by the scheduler is preferred.
+   */
+  uint64_t cpu_time() const
+  {
+    return has_exec_time ? exec_time : utime + stime;
+  }
+
+  /// Returns the CPU time in ns of all \param threads.
+  static uint64_t total_cpu_time(const std::vector<ThreadUsageInfo> & threads)
+  {
+    uint64_t total = 0;
+    for (const auto & thread : threads) {
+      total += thread.cpu_time();
+    }
+    return total;
+  }
+
+  /// Returns the \param cpu_time in ns per unit for the given number of \param units.
+  static double per_unit(const uint64_t cpu_time, const uint64_t units)
+  {
+    return units == 0 ? 0.0 : static_cast<double>(cpu_time) / static_cast<double>(units);
+  }
+};
+
+/**
+ * \brief Tracks the CPU usage of every thread of the process, including the threads the
+ * middleware spawns, from /proc/self/task.
+ *
+ * Only supported on Linux. On other platforms no threads are reported.
+ */
+class ThreadUsageTracker
+{
+public:
+  ThreadUsageTracker()
+  {
+#if defined(PERFORMANCE_TEST_LINUX)
+    m_ticks_to_ns = static_cast<uint64_t>(1000000000LL / ::sysconf(_SC_CLK_TCK));
+    get_thread_usage();
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+  }
+
+  /**
+   * \brief Returns the usage of each thread since the previous call, with the busiest thread
+   * first.
+   *
+   * Threads which exited since the previous call are not reported. A thread which reuses the
+   * id of an exited one reports its usage since it started.
+   */
+  std::vector<ThreadUsageInfo> get_thread_usage()
+  {
+    std::vector<ThreadUsageInfo> threads;
+#if defined(PERFORMANCE_TEST_LINUX)
+    std::map<int64_t, ThreadUsageInfo> totals;
+    for (const auto tid : process_thread_ids()) {
+      ThreadUsageInfo total;
+      if (!read_thread(tid, total)) {
+        // The thread exited in the meantime.
+        continue;
+      }
+      ThreadUsageInfo info = total;
+      const auto previous = m_previous.find(tid);
+      // The name is not compared, because threads may rename themselves.
+      if (previous != m_previous.end() && previous->second.start_time == total.start_time) {
+        info.utime = delta(total.utime, previous->second.utime);
+        info.stime = delta(total.stime, previous->second.stime);
+        info.exec_time = delta(total.exec_time, previous->second.exec_time);
+        info.voluntary_switches =
+          delta(total.voluntary_switches, previous->second.voluntary_switches);
+        info.involuntary_switches =
+          delta(total.involuntary_switches, previous->second.involuntary_switches);
+      }
+      threads.push_back(info);
+      totals.emplace(tid, total);
+    }
+    m_previous = std::move(totals);
+
+    std::stable_sort(
+      threads.begin(), threads.end(),
+      [](const ThreadUsageInfo & a, const ThreadUsageInfo & b) {
+        return a.cpu_time() > b.cpu_time();
+      });
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+    return threads;
+  }
+
+  /**
+   * \brief Parses the name, the CPU times, the start time and the last CPU of a thread from the content of its
+   * stat file into \param info.
+   * \param stat The content of the stat file.
+   * \param ticks_to_ns The length of a clock tick in ns.
+   * \param info The usage to fill.
+   * \returns Returns whether the content could be parsed.
+   */
+  static bool parse_stat(
+    const std::string & stat, const uint64_t ticks_to_ns, ThreadUsageInfo & info)
+  {
+    // The name is in parentheses and may itself contain spaces and parentheses.
+    const auto name_begin = stat.find('(');
+    const auto name_end = stat.rfind(')');
+    if (name_begin == std::string::npos || name_end == std::string::npos ||
+      name_end + 2 > stat.size())
+    {
+      return false;
+    }
+    info.name = stat.substr(name_begin + 1, name_end - name_begin - 1);
+
+    // The fields after the name, starting with field 3 (state), see proc(5).
+    std::istringstream fields(stat.substr(name_end + 2));
+    std::vector<std::string> values;
+    for (std::string value; fields >> value; ) {
+      values.push_back(value);
+    }
+    if (values.size() < 37) {
+      return false;
+    }
+    info.utime = std::strtoull(values[11].c_str(), nullptr, 10) * ticks_to_ns;
+    info.stime = std::strtoull(values[12].c_str(), nullptr, 10) * ticks_to_ns;
+    info.start_time = std::strtoull(values[19].c_str(), nullptr, 10);
+    info.last_cpu = static_cast<int32_t>(std::strtol(values[36].c_str(), nullptr, 10));
+    return true;
+  }
+
+  /// Parses the context switches from a \param line of the status file of a thread into
+  /// \param info.
+  static void parse_status_line(const std::string & line, ThreadUsageInfo & info)
+  {
+    const auto separator = line.find(':');
+    if (separator == std::string::npos) {
+      return;
+    }
+    const auto key = line.substr(0, separator);
+    const auto value = std::strtoull(line.c_str() + separator + 1, nullptr, 10);
+    if (key == "voluntary_ctxt_switches") {
+      info.voluntary_switches = value;
+    } else if (key == "nonvoluntary_ctxt_switches") {
+      info.involuntary_switches = value;
+    }
+  }
+
+private:
+#if defined(PERFORMANCE_TEST_LINUX)
+  static uint64_t delta(const uint64_t current, const uint64_t previous)
+  {
+    return current > previous ? current - previous : 0;
+  }
+
+  /// Reads the accumulated usage of the thread \param tid into \param info.
+  bool read_thread(const int64_t tid, ThreadUsageInfo & info) const
+  {
+    const std::string path = "/proc/self/task/" + std::to_string(tid);
+
+    std::ifstream stat_file(path + "/stat");
+    std::string stat;
+    if (!std::getline(stat_file, stat) || !parse_stat(stat, m_ticks_to_ns, info)) {
+      return false;
+    }
+    info.tid = tid;
+
+    // The first field is the time spent on the CPU in ns.
+    std::ifstream schedstat_file(path + "/schedstat");
+    info.has_exec_time = static_cast<bool>(schedstat_file >> info.exec_time);
+
+    std::ifstream status_file(path + "/status");
+    for (std::string line; std::getline(status_file, line); ) {
+      parse_status_line(line, info);
+    }
+    return true;
+  }
+
+  uint64_t m_ticks_to_ns = 0;
+  std::map<int64_t, ThreadUsageInfo> m_previous;
+#endif  // defined(PERFORMANCE_TEST_LINUX)
+};
+
+}  // namespace performance_test
+
+#endif  // UTILITIES__THREAD_USAGE_TRACKER_HPP_
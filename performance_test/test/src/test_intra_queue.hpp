@@ -0,0 +1,126 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_INTRA_QUEUE_HPP_
+#define TEST_INTRA_QUEUE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../src/communication_abstractions/intra_queue.hpp"
+
+TEST(performance_test, SpscQueue_empty) {
+  performance_test::SpscQueue<int> queue(2, 0);
+
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.front(), nullptr);
+}
+
+TEST(performance_test, SpscQueue_full) {
+  performance_test::SpscQueue<int> queue(2, 0);
+
+  for (int i = 1; i <= 2; ++i) {
+    int * element = queue.back();
+    ASSERT_NE(element, nullptr);
+    *element = i;
+    queue.push();
+  }
+  ASSERT_EQ(queue.back(), nullptr);
+
+  ASSERT_FALSE(queue.empty());
+  ASSERT_EQ(*queue.front(), 1);
+  queue.pop();
+  ASSERT_NE(queue.back(), nullptr);
+  ASSERT_EQ(*queue.front(), 2);
+  queue.pop();
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(performance_test, SpscQueue_wraps_around) {
+  performance_test::SpscQueue<int> queue(3, 0);
+
+  for (int i = 0; i < 10; ++i) {
+    *queue.back() = i;
+    queue.push();
+    ASSERT_EQ(*queue.front(), i);
+    queue.pop();
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(performance_test, SpscQueue_two_threads) {
+  performance_test::SpscQueue<std::uint64_t> queue(16, 0);
+  const std::uint64_t count = 100000;
+
+  std::thread producer([&queue, count]() {
+      for (std::uint64_t i = 0; i < count; ) {
+        std::uint64_t * element = queue.back();
+        if (element == nullptr) {
+          std::this_thread::yield();
+          continue;
+        }
+        *element = i++;
+        queue.push();
+      }
+    });
+
+  std::uint64_t expected = 0;
+  while (expected < count) {
+    const std::uint64_t * element = queue.front();
+    if (element == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(*element, expected);
+    queue.pop();
+    ++expected;
+  }
+  producer.join();
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(performance_test, IntraQueueSubscription_wait_for) {
+  performance_test::IntraQueueSubscription subscription(4, 4, 16);
+
+  ASSERT_FALSE(subscription.wait_for(std::chrono::milliseconds(1)));
+
+  ASSERT_EQ(subscription.copies.back()->size(), 16u);
+  subscription.copies.push();
+  subscription.notify();
+  ASSERT_TRUE(subscription.wait_for(std::chrono::milliseconds(1)));
+}
+
+TEST(performance_test, IntraQueueTopic_snapshot) {
+  performance_test::IntraQueueTopic topic;
+  std::vector<std::shared_ptr<performance_test::IntraQueueSubscription>> snapshot;
+  std::uint64_t version = 0;
+
+  topic.update_snapshot(snapshot, version);
+  ASSERT_TRUE(snapshot.empty());
+
+  const auto first = std::make_shared<performance_test::IntraQueueSubscription>(1, 1, 1);
+  topic.add(first);
+  topic.update_snapshot(snapshot, version);
+  ASSERT_EQ(snapshot.size(), 1u);
+  ASSERT_EQ(snapshot[0], first);
+
+  topic.add(std::make_shared<performance_test::IntraQueueSubscription>(1, 1, 1));
+  topic.update_snapshot(snapshot, version);
+  ASSERT_EQ(snapshot.size(), 2u);
+  ASSERT_EQ(snapshot[0], first);
+}
+
+#endif  // TEST_INTRA_QUEUE_HPP_
@@ -0,0 +1,89 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_NULL_MAILBOX_HPP_
+#define TEST_NULL_MAILBOX_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "../../src/communication_abstractions/null_mailbox.hpp"
+
+TEST(performance_test, NullMailbox_put_take) {
+  performance_test::NullMailbox mailbox;
+  std::int64_t time = 0;
+  std::uint64_t id = 0;
+
+  ASSERT_FALSE(mailbox.take(time, id));
+  ASSERT_TRUE(mailbox.put(42, 7));
+  ASSERT_TRUE(mailbox.take(time, id));
+  ASSERT_EQ(time, 42);
+  ASSERT_EQ(id, 7u);
+  ASSERT_FALSE(mailbox.take(time, id));
+}
+
+TEST(performance_test, NullMailbox_drops_when_full) {
+  performance_test::NullMailbox mailbox;
+  std::int64_t time = 0;
+  std::uint64_t id = 0;
+
+  ASSERT_TRUE(mailbox.put(1, 1));
+  ASSERT_FALSE(mailbox.put(2, 2));
+  ASSERT_TRUE(mailbox.take(time, id));
+  ASSERT_EQ(id, 1u);
+  ASSERT_TRUE(mailbox.put(3, 3));
+  ASSERT_TRUE(mailbox.take(time, id));
+  ASSERT_EQ(time, 3);
+  ASSERT_EQ(id, 3u);
+}
+
+TEST(performance_test, NullMailbox_wait_for) {
+  performance_test::NullMailbox mailbox;
+
+  ASSERT_FALSE(mailbox.wait_for(std::chrono::milliseconds(1)));
+  mailbox.put(1, 1);
+  ASSERT_TRUE(mailbox.wait_for(std::chrono::milliseconds(1)));
+}
+
+TEST(performance_test, NullMailbox_two_threads) {
+  performance_test::NullMailbox mailbox;
+  const std::uint64_t count = 10000;
+
+  std::thread publisher([&mailbox, count]() {
+      for (std::uint64_t id = 1; id <= count; ) {
+        if (mailbox.put(static_cast<std::int64_t>(id) * 10, id)) {
+          ++id;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  std::uint64_t expected = 1;
+  while (expected <= count) {
+    std::int64_t time = 0;
+    std::uint64_t id = 0;
+    if (!mailbox.wait_for(std::chrono::seconds(1))) {
+      break;
+    }
+    ASSERT_TRUE(mailbox.take(time, id));
+    ASSERT_EQ(id, expected);
+    ASSERT_EQ(time, static_cast<std::int64_t>(id) * 10);
+    ++expected;
+  }
+  publisher.join();
+  ASSERT_EQ(expected, count + 1);
+}
+
+#endif  // TEST_NULL_MAILBOX_HPP_
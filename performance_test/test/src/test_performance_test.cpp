@@ -14,7 +14,13 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include "test_intra_queue.hpp"
+#include "test_null_mailbox.hpp"
+#include "test_sched_stats.hpp"
+#include "test_shm_ring.hpp"
 #include "test_statistics_tracker.hpp"
+#include "test_thread_rules.hpp"
+#include "test_thread_usage_tracker.hpp"
 int32_t main(int32_t argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
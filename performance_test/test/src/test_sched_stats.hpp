@@ -0,0 +1,61 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_SCHED_STATS_HPP_
+#define TEST_SCHED_STATS_HPP_
+
+#include "../../src/utilities/sched_stats.hpp"
+
+TEST(performance_test, SchedStatReader_parse_schedstat) {
+  performance_test::SchedInfo info;
+  performance_test::SchedStatReader::parse_schedstat("123456 7890 12\n", info);
+
+  ASSERT_EQ(info.run_delay, 7890u);
+  ASSERT_EQ(info.timeslices, 12u);
+  ASSERT_DOUBLE_EQ(info.run_delay_per_timeslice(), 7890.0 / 12.0);
+}
+
+TEST(performance_test, SchedStatReader_parse_migrations) {
+  const char * sched =
+    "perf_test_sub (4242, #threads: 5)\n"
+    "-------------------------------------------------------------------\n"
+    "se.exec_start                                :      123456.789012\n"
+    "se.nr_migrations                             :                   42\n"
+    "nr_switches                                  :                  100\n";
+
+  ASSERT_EQ(performance_test::SchedStatReader::parse_migrations(sched), 42u);
+  ASSERT_EQ(performance_test::SchedStatReader::parse_migrations("nr_switches : 1\n"), 0u);
+  ASSERT_EQ(performance_test::SchedStatReader::parse_migrations(""), 0u);
+}
+
+TEST(performance_test, SchedInfo_sum) {
+  performance_test::SchedInfo a;
+  a.available = true;
+  a.run_delay = 100;
+  a.timeslices = 4;
+  a.migrations = 1;
+  performance_test::SchedInfo b;
+  b.run_delay = 50;
+  b.timeslices = 1;
+
+  const auto total = performance_test::SchedInfo::sum({a, b});
+  ASSERT_TRUE(total.available);
+  ASSERT_EQ(total.run_delay, 150u);
+  ASSERT_EQ(total.timeslices, 5u);
+  ASSERT_EQ(total.migrations, 1u);
+  ASSERT_DOUBLE_EQ(total.run_delay_per_timeslice(), 30.0);
+  ASSERT_DOUBLE_EQ(performance_test::SchedInfo().run_delay_per_timeslice(), 0.0);
+}
+
+#endif  // TEST_SCHED_STATS_HPP_
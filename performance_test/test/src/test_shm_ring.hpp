@@ -0,0 +1,72 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_SHM_RING_HPP_
+#define TEST_SHM_RING_HPP_
+
+#include <cstdint>
+#include "../../src/communication_abstractions/shm_ring.hpp"
+
+TEST(performance_test, ShmRingWakeupRecorder_init) {
+  performance_test::ShmRingWakeupRecorder recorder;
+  const auto info = recorder.sample();
+
+  ASSERT_EQ(info.wakeups, 0u);
+  ASSERT_DOUBLE_EQ(info.latency_p50, 0.0);
+  ASSERT_DOUBLE_EQ(info.latency_max, 0.0);
+}
+
+TEST(performance_test, ShmRingWakeupRecorder_small_values_exact) {
+  performance_test::ShmRingWakeupRecorder recorder;
+  recorder.add(5);
+  recorder.add(-3);  // Clamped to 0.
+  recorder.add(7);
+  const auto info = recorder.sample();
+
+  ASSERT_EQ(info.wakeups, 3u);
+  ASSERT_DOUBLE_EQ(info.latency_p50, 5e-6);
+  ASSERT_DOUBLE_EQ(info.latency_max, 7e-6);
+}
+
+TEST(performance_test, ShmRingWakeupRecorder_percentiles) {
+  performance_test::ShmRingWakeupRecorder recorder;
+  // 1 us to 1 ms.
+  for (int64_t i = 1; i <= 1000; ++i) {
+    recorder.add(i * 1000);
+  }
+  const auto info = recorder.sample();
+
+  // The buckets are accurate to 12.5 %, and a percentile reports the upper bound of its bucket.
+  ASSERT_EQ(info.wakeups, 1000u);
+  ASSERT_GE(info.latency_p50, 0.5);
+  ASSERT_LE(info.latency_p50, 0.5 * 1.125);
+  ASSERT_GE(info.latency_p90, 0.9);
+  ASSERT_LE(info.latency_p90, 0.9 * 1.125);
+  ASSERT_GE(info.latency_p99, 0.99);
+  ASSERT_LE(info.latency_p99, 0.99 * 1.125);
+  ASSERT_DOUBLE_EQ(info.latency_max, 1.0);
+}
+
+TEST(performance_test, ShmRingWakeupRecorder_sample_resets) {
+  performance_test::ShmRingWakeupRecorder recorder;
+  recorder.add(1000000);
+  recorder.sample();
+  recorder.add(1000);
+  const auto info = recorder.sample();
+
+  ASSERT_EQ(info.wakeups, 1u);
+  ASSERT_DOUBLE_EQ(info.latency_max, 0.001);
+}
+
+#endif  // TEST_SHM_RING_HPP_
@@ -0,0 +1,63 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_THREAD_RULES_HPP_
+#define TEST_THREAD_RULES_HPP_
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "../../src/utilities/thread_rules.hpp"
+
+TEST(performance_test, ThreadRule_parse_cpus_and_prio) {
+  const auto rule = performance_test::ThreadRule::parse("dq\\.recvUniq=3:80");
+
+  ASSERT_EQ(rule.pattern, "dq\\.recvUniq");
+  ASSERT_EQ(rule.cpus, std::vector<uint32_t>({3}));
+  ASSERT_EQ(rule.prio, 80);
+}
+
+TEST(performance_test, ThreadRule_parse_cpu_list) {
+  const auto rule = performance_test::ThreadRule::parse("perf_test_sub=5,1,2-3,3");
+
+  ASSERT_EQ(rule.cpus, std::vector<uint32_t>({1, 2, 3, 5}));
+  ASSERT_EQ(rule.prio, 0);
+}
+
+TEST(performance_test, ThreadRule_parse_prio_only) {
+  const auto rule = performance_test::ThreadRule::parse("a=b=:10");
+
+  // The pattern ends at the last '='.
+  ASSERT_EQ(rule.pattern, "a=b");
+  ASSERT_TRUE(rule.cpus.empty());
+  ASSERT_EQ(rule.prio, 10);
+}
+
+TEST(performance_test, ThreadRule_parse_invalid) {
+  for (const auto rule : {"x", "=3", "a=", "a=b", "a=3-1", "a=1:0", "a=1:100", "a=1:", "(=1",
+      "a=0-1024", "a=4096", "a=99999999999"})
+  {
+    ASSERT_THROW(performance_test::ThreadRule::parse(rule), std::invalid_argument) << rule;
+  }
+}
+
+TEST(performance_test, ThreadRule_output) {
+  std::ostringstream stream;
+  stream << performance_test::ThreadRule::parse("ev=6,0-3:10");
+
+  ASSERT_EQ(stream.str(), "ev=0-3,6:10");
+}
+
+#endif  // TEST_THREAD_RULES_HPP_
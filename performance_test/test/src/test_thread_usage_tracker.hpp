@@ -0,0 +1,77 @@
+// Copyright 2021 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_THREAD_USAGE_TRACKER_HPP_
+#define TEST_THREAD_USAGE_TRACKER_HPP_
+
+#include <string>
+#include "../../src/utilities/thread_usage_tracker.hpp"
+
+TEST(performance_test, ThreadUsageTracker_parse_stat) {
+  // Field 3 (state) is followed by fields whose value is their index after the state, so utime
+  // (field 14) is 11, stime (field 15) is 12, starttime (field 22) is 19, and processor
+  // (field 39) is 36.
+  std::string stat = "42 (dq.recv (1) x) S";
+  for (int i = 1; i < 50; ++i) {
+    stat += " " + std::to_string(i);
+  }
+  performance_test::ThreadUsageInfo info;
+
+  ASSERT_TRUE(performance_test::ThreadUsageTracker::parse_stat(stat, 10, info));
+  ASSERT_EQ(info.name, "dq.recv (1) x");
+  ASSERT_EQ(info.utime, 110u);
+  ASSERT_EQ(info.stime, 120u);
+  ASSERT_EQ(info.cpu_time(), 230u);
+  ASSERT_EQ(info.start_time, 19u);
+  ASSERT_EQ(info.last_cpu, 36);
+}
+
+TEST(performance_test, ThreadUsageTracker_parse_stat_invalid) {
+  performance_test::ThreadUsageInfo info;
+
+  ASSERT_FALSE(performance_test::ThreadUsageTracker::parse_stat("", 10, info));
+  ASSERT_FALSE(performance_test::ThreadUsageTracker::parse_stat("42 (name", 10, info));
+  ASSERT_FALSE(performance_test::ThreadUsageTracker::parse_stat("42 (name)", 10, info));
+  ASSERT_FALSE(performance_test::ThreadUsageTracker::parse_stat("42 (name) S 1 2 3", 10, info));
+}
+
+TEST(performance_test, ThreadUsageTracker_parse_status) {
+  performance_test::ThreadUsageInfo info;
+  for (const auto line : {"Name:\tperf_test_sub", "voluntary_ctxt_switches:\t17",
+      "nonvoluntary_ctxt_switches:\t3", "invalid"})
+  {
+    performance_test::ThreadUsageTracker::parse_status_line(line, info);
+  }
+
+  ASSERT_EQ(info.voluntary_switches, 17u);
+  ASSERT_EQ(info.involuntary_switches, 3u);
+}
+
+TEST(performance_test, ThreadUsageInfo_cpu_time) {
+  performance_test::ThreadUsageInfo info;
+  info.utime = 10000000;
+  info.stime = 10000000;
+  info.exec_time = 12345678;
+
+  ASSERT_EQ(info.cpu_time(), 20000000u);
+  info.has_exec_time = true;
+  ASSERT_EQ(info.cpu_time(), 12345678u);
+}
+
+TEST(performance_test, ThreadUsageInfo_per_unit) {
+  ASSERT_DOUBLE_EQ(performance_test::ThreadUsageInfo::per_unit(100, 4), 25.0);
+  ASSERT_DOUBLE_EQ(performance_test::ThreadUsageInfo::per_unit(100, 0), 0.0);
+}
+
+#endif  // TEST_THREAD_USAGE_TRACKER_HPP_